@@ -0,0 +1,316 @@
+//
+// Copyright (c) 2019 Loïc HAMOT
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Check that the views iterate without heap allocation, and that the materializing operations
+// allocate only once when the size is known.
+// The global operator new is replaced to count the allocations.
+//
+#include "rah.hpp"
+
+#ifdef MSVC
+#pragma warning(push, 0)
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef MSVC
+#pragma warning(pop)
+#endif
+
+namespace
+{
+/// Incremented by the replaced operator new
+size_t allocationCount = 0;
+bool success = true;
+
+/// Check the number of allocations done during its lifetime
+class alloc_scope
+{
+public:
+	alloc_scope(char const* expression, int line, size_t expected)
+		: expression_(expression)
+		, line_(line)
+		, expected_(expected)
+		, start_(allocationCount)
+	{
+	}
+	alloc_scope(alloc_scope const&) = delete;
+	alloc_scope& operator=(alloc_scope const&) = delete;
+
+	~alloc_scope()
+	{
+		size_t const count = allocationCount - start_;
+		if (count == expected_)
+			return;
+		std::printf("%d: %s: %zu allocations, expected %zu\n", line_, expression_, count, expected_);
+		success = false;
+	}
+
+private:
+	char const* expression_;
+	int line_;
+	size_t expected_;
+	size_t start_;
+};
+}
+
+#define RAH_ALLOC_CONCAT_IMPL(A, B) A##B
+#define RAH_ALLOC_CONCAT(A, B) RAH_ALLOC_CONCAT_IMPL(A, B)
+/// Check that exactly N allocations are done from here to the end of the scope
+#define RAH_ASSERT_ALLOC_COUNT(N) alloc_scope const RAH_ALLOC_CONCAT(allocScope, __LINE__)(#N " allocations", __LINE__, N)
+/// Check that no allocation is done from here to the end of the scope
+#define RAH_ASSERT_NO_ALLOC alloc_scope const RAH_ALLOC_CONCAT(allocScope, __LINE__)("no allocation", __LINE__, 0)
+
+void* operator new(std::size_t size)
+{
+	++allocationCount;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+namespace
+{
+/// Read all the elements of a range (recursively for the ranges of ranges)
+template<typename R>
+auto consume(R&& range, int) -> decltype(int64_t(*rah::rah_begin(range)))
+{
+	int64_t sum = 0;
+	for (auto&& elt : range)
+		sum += int64_t(elt);
+	return sum;
+}
+
+template<typename R>
+auto consume(R&& range, long) -> decltype(consume(*rah::rah_begin(range), 0))
+{
+	int64_t sum = 0;
+	for (auto&& subRange : range)
+		sum += consume(subRange, 0);
+	return sum;
+}
+
+template<typename R>
+int64_t consume(R&& range)
+{
+	return consume(RAH_STD::forward<R>(range), 0);
+}
+
+auto const twice = [](int i) { return i * 2; };
+auto const is_even = [](int i) { return i % 2 == 0; };
+
+void lazy_views()
+{
+	std::vector<int> const in{ 5, 1, 4, 1, 8, 2, 3, 3, 9, 0 };
+	std::vector<int> const sorted{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	std::list<int> const list{ 1, 2, 3 };
+	std::vector<std::vector<int>> const nested{ { 1, 2 }, {}, { 3 } };
+	std::map<int, int> const map{ { 1, 2 }, { 3, 4 } };
+	std::vector<int> mut(in);
+	rah::view_stats stats;
+	rah::stage_timing timing("alloc_test", 4);
+
+	RAH_ASSERT_NO_ALLOC;
+	consume(rah::view::all(in));
+	consume(rah::view::transform(in, twice));
+	consume(in | rah::view::transform(twice));
+	consume(in | rah::view::filter(is_even));
+	consume(in | rah::view::take(4));
+	consume(in | rah::view::take<4>());
+	consume(list | rah::view::take(2));
+	consume(in | rah::view::drop(4));
+	consume(in | rah::view::drop_exactly(4));
+	consume(in | rah::view::slice(2, 5));
+	consume(in | rah::view::stride(3));
+	consume(in | rah::view::reverse());
+	consume(mut | rah::view::move());
+	consume(in | rah::view::sliding(3));
+	consume(in | rah::view::chunk(3));
+	consume(in | rah::view::chunk_by([](int a, int b) { return a <= b; }));
+	consume(in | rah::view::group_by(is_even));
+	consume(sorted | rah::view::group_by_sorted([](int i) { return i / 3; }));
+	consume(in | rah::view::counted(3));
+	consume(rah::view::counted(in.begin(), 3));
+	consume(rah::view::unbounded(in.begin()) | rah::view::take(3));
+	consume(rah::view::zip(in, sorted) | rah::view::transform([](auto ab) { return std::get<0>(ab) * std::get<1>(ab); }));
+	consume(rah::view::zip(in, list) | rah::view::transform([](auto ab) { return std::get<0>(ab) + std::get<1>(ab); }));
+	consume(in | rah::view::enumerate() | rah::view::transform([](auto ia) { return std::get<1>(ia); }));
+	consume(nested | rah::view::join());
+	consume(rah::view::concat(in, sorted));
+	consume(rah::view::concat(in, sorted, in));
+	consume(rah::view::set_difference(sorted, list));
+	consume(map | rah::view::map_value());
+	consume(map | rah::view::map_key());
+	consume(rah::view::iota(0, 10, 2));
+	consume(rah::view::ints(0, 10));
+	consume(rah::view::closed_ints(0, 10));
+	consume(rah::view::repeat(42) | rah::view::take(5));
+	consume(in | rah::view::cycle() | rah::view::take(25));
+	consume(rah::view::generate([] { return 7; }) | rah::view::take(5));
+	consume(rah::view::generate_n(5, [] { return 7; }));
+	consume(rah::view::single(42));
+	consume(in | rah::view::for_each([](int i) { return rah::view::repeat(i) | rah::view::take(2); }));
+	consume(in | rah::view::tap([](int) {}));
+	consume(in | rah::view::counted_stats(stats));
+	consume(in | rah::view::timed(timing));
+	consume(in | rah::view::filter(rah::counted_calls(is_even, stats)));
+	consume(in | rah::view::transform(rah::timed_calls(twice, timing)));
+	consume(rah::view::iota(0, 100)
+		| rah::view::transform(twice)
+		| rah::view::filter(is_even)
+		| rah::view::stride(2)
+		| rah::view::take(10));
+}
+
+/// These views keep a buffer, allocated once when the view is made
+void buffered_views()
+{
+	std::vector<int> const in{ 5, 1, 4, 1, 8, 2, 3, 3, 9, 0 };
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		consume(in | rah::view::sliding_buffered(3));
+	}
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		consume(in | rah::view::sliding_reduce(3, rah::minimum()));
+	}
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		consume(in | rah::view::lazy_sort());
+	}
+	{
+		// With an arena, the buffers reuse the memory of the previous requests
+		rah::arena arena;
+		auto const request = [&]
+		{
+			arena.reset();
+			consume(in | rah::view::sliding_buffered(3, &arena));
+			consume(in | rah::view::sliding_reduce(3, rah::minimum(), &arena));
+			consume(in | rah::view::lazy_sort(rah::is_lesser(), &arena));
+			consume(in | rah::view::distinct(std::hash<int>(), std::equal_to<int>(), &arena));
+			consume(in | rah::top_k(3, rah::is_lesser(), &arena));
+		};
+		request();
+		RAH_ASSERT_NO_ALLOC;
+		request();
+	}
+	{
+		// The buffered views are moved into the next adaptor
+		RAH_ASSERT_ALLOC_COUNT(1);
+		consume(in | rah::view::lazy_sort() | rah::view::transform(twice));
+	}
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		consume(in | rah::view::sliding_buffered(2) | rah::view::transform([](auto window) { return *(window.begin() + 1); }));
+	}
+	{
+		// Only the copy of the container allocates
+		RAH_ASSERT_ALLOC_COUNT(1);
+		consume(std::vector<int>(in) | rah::view::filter(is_even) | rah::view::transform(twice) | rah::view::take(3));
+	}
+}
+
+/// Materializing a sized range allocates once
+void materialize()
+{
+	std::vector<int> const in{ 5, 1, 4, 1, 8, 2, 3, 3, 9, 0 };
+	std::list<int> const list{ 1, 2, 3 };
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		auto out = in | rah::view::transform(twice) | rah::to_container<std::vector<int>>();
+	}
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		auto out = rah::view::iota(0, 1000) | rah::to_container<std::vector<int>>();
+	}
+	{
+		// Not random access, but the size is computed before the allocation
+		RAH_ASSERT_ALLOC_COUNT(1);
+		auto out = rah::view::zip(in, list)
+			| rah::view::transform([](auto ab) { return std::get<0>(ab) + std::get<1>(ab); })
+			| rah::to_container<std::vector<int>>();
+	}
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		auto out = rah::view::repeat('a') | rah::view::take(100) | rah::to_container<std::string>();
+	}
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		std::vector<int> out;
+		rah::copy(in | rah::view::transform(twice), rah::back_inserter(out));
+	}
+	{
+		RAH_ASSERT_ALLOC_COUNT(1);
+		auto out = in | rah::view::sort();
+	}
+	{
+		// The container is moved into the view
+		std::vector<int> vec(in);
+		RAH_ASSERT_NO_ALLOC;
+		consume(rah::view::own(std::move(vec)) | rah::view::transform(twice));
+	}
+	{
+		RAH_ASSERT_NO_ALLOC;
+		auto out = in | rah::view::take<5>() | rah::to_container<rah::static_vector<int, 5>>();
+	}
+	{
+		RAH_ASSERT_NO_ALLOC;
+		auto const out = in | rah::view::take<5>() | rah::view::transform(twice) | rah::to_array();
+		consume(rah::view::all(out));
+	}
+	{
+		RAH_ASSERT_NO_ALLOC;
+		auto const out = std::array<int, 5>{ 1, 2, 3, 4, 5 } | rah::view::transform(twice) | rah::to_array();
+		consume(rah::view::all(out));
+	}
+	{
+		rah::arena arena(4096);
+		rah::arena_allocator<int> alloc(&arena);
+		auto warmUp = in | rah::view::transform(twice) | rah::to_container<std::vector<int, rah::arena_allocator<int>>>(alloc);
+		RAH_ASSERT_NO_ALLOC;
+		auto out = in | rah::view::transform(twice) | rah::to_container<std::vector<int, rah::arena_allocator<int>>>(alloc);
+	}
+}
+}
+
+int main()
+{
+	lazy_views();
+	buffered_views();
+	materialize();
+	std::printf(success ? "ALL TEST OK\n" : "NOT OK\n");
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
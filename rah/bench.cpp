@@ -0,0 +1,1577 @@
+//
+// Copyright (c) 2019 Loïc HAMOT
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Compare the views and algorithms of rah to a hand written loop and to the std algorithm.
+// Run "rah_bench --help" for the options.
+//
+#include "rah.hpp"
+#include "bench.hpp"
+
+#ifdef MSVC
+#pragma warning(push, 0)
+#endif
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#ifdef MSVC
+#pragma warning(pop)
+#endif
+
+namespace
+{
+constexpr double IntSize = sizeof(int);
+
+auto const twice = [](int i) { return i * 2; };
+auto const is_even = [](int i) { return i % 2 == 0; };
+}
+
+// ********************************** views *******************************************************
+
+RAH_BENCH(iota)
+{
+	int const size = int(state.size());
+	state.run("rah", 0, [&]
+		{
+			int64_t sum = 0;
+			for (int i : rah::view::iota(0, size))
+				sum += i;
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", 0, [&]
+		{
+			int64_t sum = 0;
+			for (int i = 0; i != size; ++i)
+				sum += i;
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(transform)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out(in.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			rah::copy(in | rah::view::transform(twice), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			for (size_t i = 0; i != in.size(); ++i)
+				out[i] = twice(in[i]);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			std::transform(in.begin(), in.end(), out.begin(), twice);
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(filter)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out;
+	out.reserve(in.size());
+	state.run("rah", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			rah::copy(in | rah::view::filter(is_even), rah::back_inserter(out));
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			for (int i : in)
+			{
+				if (is_even(i))
+					out.push_back(i);
+			}
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			std::copy_if(in.begin(), in.end(), std::back_inserter(out), is_even);
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(take)
+{
+	auto const in = bench::random_ints(state.size() * 2);
+	size_t const count = state.size();
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::take(count), int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i != count; ++i)
+				sum += in[i];
+			bench::do_not_optimize(sum);
+		});
+	state.run("std", IntSize, [&]
+		{
+			bench::do_not_optimize(std::accumulate(in.begin(), in.begin() + intptr_t(count), int64_t()));
+		});
+}
+
+RAH_BENCH(drop)
+{
+	auto const in = bench::random_ints(state.size() * 2);
+	size_t const count = state.size();
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::drop(count), int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = count; i != in.size(); ++i)
+				sum += in[i];
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(stride)
+{
+	auto const in = bench::random_ints(state.size() * 4);
+	state.run("rah", 4 * IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::stride(4), int64_t(), std::plus<>()));
+		});
+	state.run("loop", 4 * IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i < in.size(); i += 4)
+				sum += in[i];
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(reverse)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out(in.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			rah::copy(in | rah::view::reverse(), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			for (size_t i = 0; i != in.size(); ++i)
+				out[i] = in[in.size() - 1 - i];
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			std::reverse_copy(in.begin(), in.end(), out.begin());
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(zip)
+{
+	auto const a = bench::random_ints(state.size());
+	auto const b = bench::random_ints(state.size());
+	std::vector<int> out(a.size());
+	auto const add = [](auto ab) { return std::get<0>(ab) + std::get<1>(ab); };
+	state.run("rah", 3 * IntSize, [&]
+		{
+			rah::copy(rah::view::zip(a, b) | rah::view::transform(add), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 3 * IntSize, [&]
+		{
+			for (size_t i = 0; i != a.size(); ++i)
+				out[i] = a[i] + b[i];
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 3 * IntSize, [&]
+		{
+			std::transform(a.begin(), a.end(), b.begin(), out.begin(), std::plus<>());
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(enumerate)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto&& indexValue : in | rah::view::enumerate())
+				sum += int64_t(std::get<0>(indexValue)) * std::get<1>(indexValue);
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i != in.size(); ++i)
+				sum += int64_t(i) * in[i];
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(join)
+{
+	std::vector<std::vector<int>> in(state.size() / 10 + 1);
+	for (auto& sub : in)
+		sub = bench::random_ints(10);
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::join(), int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto const& sub : in)
+			{
+				for (int i : sub)
+					sum += i;
+			}
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(concat)
+{
+	auto const a = bench::random_ints(state.size() / 2);
+	auto const b = bench::random_ints(state.size() - a.size());
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(rah::view::concat(a, b), int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (int i : a)
+				sum += i;
+			for (int i : b)
+				sum += i;
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(chunk)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto&& chunk : in | rah::view::chunk(8))
+				sum += *rah::max_element(chunk);
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i < in.size(); i += 8)
+				sum += *std::max_element(in.begin() + intptr_t(i), in.begin() + intptr_t(std::min(i + 8, in.size())));
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(sliding)
+{
+	auto const in = bench::random_ints(state.size(), 1000);
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto&& window : in | rah::view::sliding(4))
+				sum += rah::reduce(window, 0, std::plus<>());
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i + 4 <= in.size(); ++i)
+				sum += in[i] + in[i + 1] + in[i + 2] + in[i + 3];
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(sliding_reduce)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out(in.size());
+	size_t const window = 16;
+	state.run("rah", 2 * IntSize, [&]
+		{
+			rah::copy(in | rah::view::sliding_reduce(window, rah::minimum()), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			for (size_t i = 0; i + window <= in.size(); ++i)
+				out[i] = *std::min_element(in.begin() + intptr_t(i), in.begin() + intptr_t(i + window));
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(distinct)
+{
+	auto const in = bench::random_ints(state.size(), int(state.size() / 4));
+	std::vector<int> out;
+	out.reserve(in.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			out.clear();
+			rah::copy(in | rah::view::distinct(), rah::back_inserter(out));
+			bench::do_not_optimize(out.data());
+		});
+	std::vector<int> sorted;
+	state.run("std", 2 * IntSize, [&]
+		{
+			sorted = in;
+			std::sort(sorted.begin(), sorted.end());
+			sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+			bench::do_not_optimize(sorted.data());
+		});
+}
+
+RAH_BENCH(view_sort)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			auto sorted = in | rah::view::sort();
+			bench::do_not_optimize(sorted.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			std::vector<int> sorted(in);
+			std::sort(sorted.begin(), sorted.end());
+			bench::do_not_optimize(sorted.data());
+		});
+}
+
+RAH_BENCH(counted)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(rah::view::counted(in.begin(), in.size()), int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			auto iter = in.begin();
+			for (size_t i = 0; i != in.size(); ++i, ++iter)
+				sum += *iter;
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(unbounded)
+{
+	auto const in = bench::random_ints(state.size());
+	intptr_t const size = intptr_t(in.size());
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(
+				rah::reduce(rah::view::unbounded(in.begin()) | rah::view::slice(0, size), int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			auto iter = in.begin();
+			for (intptr_t i = 0; i != size; ++i, ++iter)
+				sum += *iter;
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(repeat)
+{
+	std::vector<int> out(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			rah::copy(rah::view::repeat(42) | rah::view::take(out.size()), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", IntSize, [&]
+		{
+			for (int& i : out)
+				i = 42;
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", IntSize, [&]
+		{
+			std::fill_n(out.begin(), out.size(), 42);
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(cycle)
+{
+	auto const in = bench::random_ints(16);
+	std::vector<int> out(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			rah::copy(in | rah::view::cycle() | rah::view::take(out.size()), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", IntSize, [&]
+		{
+			for (size_t i = 0; i != out.size(); ++i)
+				out[i] = in[i % in.size()];
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(generate)
+{
+	std::vector<int> out(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			int value = 0;
+			rah::copy(rah::view::generate_n(out.size(), [&value] { return value++; }), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int value = 0;
+			for (int& i : out)
+				i = value++;
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", IntSize, [&]
+		{
+			int value = 0;
+			std::generate(out.begin(), out.end(), [&value] { return value++; });
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(view_set_difference)
+{
+	int const maxValue = int(state.size());
+	auto a = bench::random_ints(state.size() / 2, maxValue);
+	auto b = bench::random_ints(state.size() - a.size(), maxValue);
+	std::sort(a.begin(), a.end());
+	std::sort(b.begin(), b.end());
+	std::vector<int> out;
+	out.reserve(a.size());
+	state.run("rah", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			rah::copy(rah::view::set_difference(a, b), rah::back_inserter(out));
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			size_t j = 0;
+			for (int i : a)
+			{
+				while (j != b.size() and b[j] < i)
+					++j;
+				if (j != b.size() and b[j] == i)
+					++j;
+				else
+					out.push_back(i);
+			}
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(view_for_each)
+{
+	int const count = int(state.size() / 10 + 1);
+	state.run("rah", 0, [&]
+		{
+			int64_t sum = 0;
+			for (int i : rah::view::iota(0, count) | rah::view::for_each([](int i) { return rah::view::iota(i, i + 10); }))
+				sum += i;
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", 0, [&]
+		{
+			int64_t sum = 0;
+			for (int i = 0; i != count; ++i)
+			{
+				for (int j = i; j != i + 10; ++j)
+					sum += j;
+			}
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(slice)
+{
+	auto const in = bench::random_ints(state.size() * 2);
+	intptr_t const first = intptr_t(state.size() / 2);
+	intptr_t const last = first + intptr_t(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::slice(first, last), int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (intptr_t i = first; i != last; ++i)
+				sum += in[size_t(i)];
+			bench::do_not_optimize(sum);
+		});
+	state.run("std", IntSize, [&]
+		{
+			bench::do_not_optimize(std::accumulate(in.begin() + first, in.begin() + last, int64_t()));
+		});
+}
+
+RAH_BENCH(move)
+{
+	std::vector<std::string> in(state.size());
+	for (size_t i = 0; i != in.size(); ++i)
+		in[i] = "a string too long for the small string optimization " + std::to_string(i);
+	std::vector<std::string> values;
+	std::vector<std::string> out(in.size());
+	auto const reset = [&] { values = in; };
+	double const bytes = 2 * sizeof(std::string);
+	state.run("rah", bytes, reset, [&]
+		{
+			rah::copy(values | rah::view::move(), out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", bytes, reset, [&]
+		{
+			for (size_t i = 0; i != values.size(); ++i)
+				out[i] = std::move(values[i]);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", bytes, reset, [&]
+		{
+			std::move(values.begin(), values.end(), out.begin());
+			bench::do_not_optimize(out.data());
+		});
+}
+
+// Sum of the first element of each ascending run
+RAH_BENCH(chunk_by)
+{
+	auto const in = bench::random_ints(state.size(), 1000);
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto&& run : in | rah::view::chunk_by(std::less_equal<>()))
+				sum += *rah_begin(run);
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i != in.size(); ++i)
+			{
+				if (i == 0 or in[i - 1] > in[i])
+					sum += in[i];
+			}
+			bench::do_not_optimize(sum);
+		});
+}
+
+// Count the elements of each group of a sorted range
+RAH_BENCH(group_by)
+{
+	auto in = bench::random_ints(state.size(), int(state.size() / 16));
+	std::sort(in.begin(), in.end());
+	auto const key = [](int i) { return i; };
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto&& group : in | rah::view::group_by(key))
+				sum += int64_t(*rah_begin(group)) * (rah_end(group) - rah_begin(group));
+			bench::do_not_optimize(sum);
+		});
+	state.run("sorted", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto&& group : in | rah::view::group_by_sorted(key))
+				sum += int64_t(*rah_begin(group)) * (rah_end(group) - rah_begin(group));
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			size_t first = 0;
+			for (size_t i = 1; i <= in.size(); ++i)
+			{
+				if (i == in.size() or in[i] != in[first])
+				{
+					sum += int64_t(in[first]) * int64_t(i - first);
+					first = i;
+				}
+			}
+			bench::do_not_optimize(sum);
+		});
+	state.run("std", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto first = in.begin(); first != in.end();)
+			{
+				auto const last = std::upper_bound(first, in.end(), *first);
+				sum += int64_t(*first) * (last - first);
+				first = last;
+			}
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(map_value)
+{
+	std::vector<std::pair<int, int>> in(state.size());
+	auto const values = bench::random_ints(state.size());
+	for (size_t i = 0; i != in.size(); ++i)
+		in[i] = { int(i), values[i] };
+	state.run("rah", 2 * IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::map_value(), int64_t(), std::plus<>()));
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto const& keyValue : in)
+				sum += keyValue.second;
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(map_key)
+{
+	std::vector<std::pair<int, int>> in(state.size());
+	auto const keys = bench::random_ints(state.size());
+	for (size_t i = 0; i != in.size(); ++i)
+		in[i] = { keys[i], int(i) };
+	state.run("rah", 2 * IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::map_key(), int64_t(), std::plus<>()));
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto const& keyValue : in)
+				sum += keyValue.first;
+			bench::do_not_optimize(sum);
+		});
+}
+
+// Read the 10 smallest elements
+RAH_BENCH(lazy_sort)
+{
+	auto const in = bench::random_ints(state.size());
+	size_t const k = 10;
+	std::vector<int> values;
+	state.run("rah", 2 * IntSize, [&]
+		{
+			int64_t sum = 0;
+			auto sorted = in | rah::view::lazy_sort();
+			for (int i : sorted | rah::view::take(k))
+				sum += i;
+			bench::do_not_optimize(sum);
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			values = in;
+			auto const middle = values.begin() + intptr_t(std::min(k, values.size()));
+			std::partial_sort(values.begin(), middle, values.end());
+			bench::do_not_optimize(std::accumulate(values.begin(), middle, int64_t()));
+		});
+}
+
+// The key is costly to compute, so computing it once by element pays off
+RAH_BENCH(view_sort_by)
+{
+	auto const in = bench::random_ints(state.size());
+	auto const key = [](int i) { return std::to_string(i); };
+	state.run("rah", 2 * IntSize, [&]
+		{
+			auto sorted = in | rah::view::sort_by(key);
+			bench::do_not_optimize(sorted.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			std::vector<int> sorted(in);
+			std::sort(sorted.begin(), sorted.end(), [&](int a, int b) { return key(a) < key(b); });
+			bench::do_not_optimize(sorted.data());
+		});
+}
+
+RAH_BENCH(sliding_buffered)
+{
+	auto const in = bench::random_ints(state.size(), 1000);
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto&& window : in | rah::view::sliding_buffered(4))
+				sum += rah::reduce(window, 0, std::plus<>());
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i + 4 <= in.size(); ++i)
+				sum += in[i] + in[i + 1] + in[i + 2] + in[i + 3];
+			bench::do_not_optimize(sum);
+		});
+}
+
+// Overhead of the stage timing, measuring all the calls or one out of 64
+RAH_BENCH(timed)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out(in.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			rah::copy(in | rah::view::transform(twice), out);
+			bench::do_not_optimize(out.data());
+		});
+	rah::stage_timing everyCall("twice");
+	state.run("timed_1", 2 * IntSize, [&]
+		{
+			rah::copy(in | rah::view::transform(rah::timed_calls(twice, everyCall)), out);
+			bench::do_not_optimize(out.data());
+		});
+	rah::stage_timing sampled("twice", 64);
+	state.run("timed_64", 2 * IntSize, [&]
+		{
+			rah::copy(in | rah::view::transform(rah::timed_calls(twice, sampled)), out);
+			bench::do_not_optimize(out.data());
+		});
+}
+
+// Overhead of a tap counting the elements read
+RAH_BENCH(tap)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in, int64_t(), std::plus<>()));
+		});
+	state.run("tap", IntSize, [&]
+		{
+			size_t count = 0;
+			auto const counter = [&count](int) { ++count; };
+			bench::do_not_optimize(rah::reduce(in | rah::view::tap(counter), int64_t(), std::plus<>()));
+			bench::do_not_optimize(count);
+		});
+}
+
+// Overhead of the iterator statistics
+RAH_BENCH(counted_stats)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in, int64_t(), std::plus<>()));
+		});
+	rah::view_stats stats;
+	state.run("counted_stats", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in | rah::view::counted_stats(stats), int64_t(), std::plus<>()));
+		});
+}
+
+// ******************************** algorithms ****************************************************
+
+RAH_BENCH(reduce)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::reduce(in, int64_t(), std::plus<>()));
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (int i : in)
+				sum += i;
+			bench::do_not_optimize(sum);
+		});
+	state.run("std", IntSize, [&]
+		{
+			bench::do_not_optimize(std::accumulate(in.begin(), in.end(), int64_t()));
+		});
+}
+
+RAH_BENCH(count)
+{
+	auto const in = bench::random_ints(state.size(), 100);
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::count(in, 42)); });
+	state.run("loop", IntSize, [&]
+		{
+			size_t count = 0;
+			for (int i : in)
+				count += i == 42;
+			bench::do_not_optimize(count);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::count(in.begin(), in.end(), 42)); });
+}
+
+RAH_BENCH(find)
+{
+	std::vector<int> in(state.size(), 0);
+	in.back() = 1;
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::find(in, 1)); });
+	state.run("loop", IntSize, [&]
+		{
+			size_t i = 0;
+			while (i != in.size() and in[i] != 1)
+				++i;
+			bench::do_not_optimize(i);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::find(in.begin(), in.end(), 1)); });
+}
+
+RAH_BENCH(max_element)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::max_element(in)); });
+	state.run("loop", IntSize, [&]
+		{
+			size_t best = 0;
+			for (size_t i = 1; i < in.size(); ++i)
+			{
+				if (in[best] < in[i])
+					best = i;
+			}
+			bench::do_not_optimize(best);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::max_element(in.begin(), in.end())); });
+}
+
+RAH_BENCH(equal)
+{
+	auto const a = bench::random_ints(state.size());
+	auto const b = a;
+	state.run("rah", 2 * IntSize, [&] { bench::do_not_optimize(rah::equal(a, b)); });
+	state.run("loop", 2 * IntSize, [&]
+		{
+			bool equal = a.size() == b.size();
+			for (size_t i = 0; equal and i != a.size(); ++i)
+				equal = a[i] == b[i];
+			bench::do_not_optimize(equal);
+		});
+	state.run("std", 2 * IntSize, [&] { bench::do_not_optimize(std::equal(a.begin(), a.end(), b.begin(), b.end())); });
+}
+
+RAH_BENCH(copy)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out(in.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			rah::copy(in, out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			for (size_t i = 0; i != in.size(); ++i)
+				out[i] = in[i];
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			std::copy(in.begin(), in.end(), out.begin());
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(fill)
+{
+	std::vector<int> out(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			rah::fill(out, 42);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", IntSize, [&]
+		{
+			for (int& i : out)
+				i = 42;
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", IntSize, [&]
+		{
+			std::fill(out.begin(), out.end(), 42);
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(back_inserter)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out;
+	out.reserve(in.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			out.clear();
+			rah::copy(in, rah::back_inserter(out));
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			out.clear();
+			for (int i : in)
+				out.push_back(i);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			out.clear();
+			std::copy(in.begin(), in.end(), std::back_inserter(out));
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(to_container)
+{
+	int const size = int(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			auto vec = rah::view::iota(0, size) | rah::view::transform(twice) | rah::to_container<std::vector<int>>();
+			bench::do_not_optimize(vec.data());
+		});
+	state.run("loop", IntSize, [&]
+		{
+			std::vector<int> vec;
+			vec.reserve(size_t(size));
+			for (int i = 0; i != size; ++i)
+				vec.push_back(twice(i));
+			bench::do_not_optimize(vec.data());
+		});
+}
+
+RAH_BENCH(formatted_stream_inserter)
+{
+	auto const in = bench::random_ints(state.size());
+	std::stringstream stream;
+	state.run("rah", IntSize + 11, [&]
+		{
+			stream.str(std::string());
+			rah::copy(in, rah::formatted_stream_inserter(stream, " "));
+			bench::do_not_optimize(stream);
+		});
+	state.run("std", IntSize + 11, [&]
+		{
+			stream.str(std::string());
+			std::copy(in.begin(), in.end(), std::ostream_iterator<int>(stream, " "));
+			bench::do_not_optimize(stream);
+		});
+}
+
+RAH_BENCH(sort)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::sort(values);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			std::sort(values.begin(), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(radix_sort)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::action::radix_sort(values);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			std::sort(values.begin(), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(top_k)
+{
+	auto const in = bench::random_ints(state.size());
+	size_t const k = 10;
+	std::vector<int> values;
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::top_k(in, k).data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			values = in;
+			std::partial_sort(values.begin(), values.begin() + intptr_t(std::min(k, values.size())), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(unique)
+{
+	auto const in = bench::random_ints(state.size(), 3);
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::action::unique(values);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			values.erase(std::unique(values.begin(), values.end()), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(remove_if)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::action::remove_if(values, is_even);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			values.erase(std::remove_if(values.begin(), values.end(), is_even), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(binary_search)
+{
+	auto in = bench::random_ints(state.size());
+	std::sort(in.begin(), in.end());
+	auto const needles = bench::random_ints(state.size()); // One search by element
+	state.run("rah", IntSize, [&]
+		{
+			size_t found = 0;
+			for (int needle : needles)
+				found += rah::binary_search(in, needle);
+			bench::do_not_optimize(found);
+		});
+	state.run("std", IntSize, [&]
+		{
+			size_t found = 0;
+			for (int needle : needles)
+				found += std::binary_search(in.begin(), in.end(), needle);
+			bench::do_not_optimize(found);
+		});
+}
+
+RAH_BENCH(equal_range)
+{
+	auto in = bench::random_ints(state.size(), int(state.size()));
+	std::sort(in.begin(), in.end());
+	auto const needles = bench::random_ints(state.size(), int(state.size())); // One search by element
+	state.run("rah", IntSize, [&]
+		{
+			intptr_t found = 0;
+			for (int needle : needles)
+			{
+				auto const range = rah::equal_range(in, needle);
+				found += rah_end(range) - rah_begin(range);
+			}
+			bench::do_not_optimize(found);
+		});
+	state.run("std", IntSize, [&]
+		{
+			intptr_t found = 0;
+			for (int needle : needles)
+			{
+				auto const range = std::equal_range(in.begin(), in.end(), needle);
+				found += range.second - range.first;
+			}
+			bench::do_not_optimize(found);
+		});
+}
+
+RAH_BENCH(transform_algorithm)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out(in.size());
+	state.run("rah", 2 * IntSize, [&]
+		{
+			rah::transform(in, out, twice);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 2 * IntSize, [&]
+		{
+			for (size_t i = 0; i != in.size(); ++i)
+				out[i] = twice(in[i]);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			std::transform(in.begin(), in.end(), out.begin(), twice);
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(aggregate_by)
+{
+	auto const in = bench::random_ints(state.size());
+	auto const key = [](int i) { return i % 1024; };
+	auto const add = [](int64_t sum, int i) { return sum + i; };
+	state.run("rah", IntSize, [&]
+		{
+			bench::do_not_optimize(rah::aggregate_by(in, key, int64_t(), add).size());
+		});
+	state.run("std", IntSize, [&]
+		{
+			std::unordered_map<int, int64_t> sums;
+			for (int i : in)
+				sums[key(i)] += i;
+			bench::do_not_optimize(sums.size());
+		});
+}
+
+RAH_BENCH(any_of)
+{
+	std::vector<int> in(state.size(), 0);
+	in.back() = 1;
+	auto const is_one = [](int i) { return i == 1; };
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::any_of(in, is_one)); });
+	state.run("loop", IntSize, [&]
+		{
+			bool found = false;
+			for (size_t i = 0; not found and i != in.size(); ++i)
+				found = is_one(in[i]);
+			bench::do_not_optimize(found);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::any_of(in.begin(), in.end(), is_one)); });
+}
+
+RAH_BENCH(all_of)
+{
+	std::vector<int> in(state.size(), 0);
+	in.back() = 1;
+	auto const is_zero = [](int i) { return i == 0; };
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::all_of(in, is_zero)); });
+	state.run("loop", IntSize, [&]
+		{
+			bool all = true;
+			for (size_t i = 0; all and i != in.size(); ++i)
+				all = is_zero(in[i]);
+			bench::do_not_optimize(all);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::all_of(in.begin(), in.end(), is_zero)); });
+}
+
+RAH_BENCH(none_of)
+{
+	std::vector<int> in(state.size(), 0);
+	in.back() = 1;
+	auto const is_one = [](int i) { return i == 1; };
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::none_of(in, is_one)); });
+	state.run("loop", IntSize, [&]
+		{
+			bool none = true;
+			for (size_t i = 0; none and i != in.size(); ++i)
+				none = not is_one(in[i]);
+			bench::do_not_optimize(none);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::none_of(in.begin(), in.end(), is_one)); });
+}
+
+RAH_BENCH(count_if)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::count_if(in, is_even)); });
+	state.run("loop", IntSize, [&]
+		{
+			size_t count = 0;
+			for (int i : in)
+				count += is_even(i);
+			bench::do_not_optimize(count);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::count_if(in.begin(), in.end(), is_even)); });
+}
+
+RAH_BENCH(for_each)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			rah::for_each(in, [&sum](int i) { sum += i; });
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (int i : in)
+				sum += i;
+			bench::do_not_optimize(sum);
+		});
+	state.run("std", IntSize, [&]
+		{
+			int64_t sum = 0;
+			std::for_each(in.begin(), in.end(), [&sum](int i) { sum += i; });
+			bench::do_not_optimize(sum);
+		});
+}
+
+// Transform many small arrays, of static size
+RAH_BENCH(to_array)
+{
+	std::vector<std::array<int, 16>> in(state.size() / 16 + 1);
+	auto const values = bench::random_ints(in.size() * 16);
+	for (size_t i = 0; i != in.size(); ++i)
+		std::copy_n(values.begin() + intptr_t(i * 16), 16, in[i].begin());
+	state.run("rah", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto const& array : in)
+			{
+				auto const out = array | rah::view::transform(twice) | rah::to_array();
+				sum += out[0] + out[15];
+			}
+			bench::do_not_optimize(sum);
+		});
+	state.run("loop", IntSize, [&]
+		{
+			int64_t sum = 0;
+			for (auto const& array : in)
+			{
+				std::array<int, 16> out;
+				for (size_t i = 0; i != array.size(); ++i)
+					out[i] = twice(array[i]);
+				bench::do_not_optimize(out.data());
+				sum += out[0] + out[15];
+			}
+			bench::do_not_optimize(sum);
+		});
+}
+
+RAH_BENCH(mismatch)
+{
+	auto const a = bench::random_ints(state.size());
+	auto b = a;
+	b.back() += 1;
+	state.run("rah", 2 * IntSize, [&] { bench::do_not_optimize(rah::mismatch(a, b)); });
+	state.run("loop", 2 * IntSize, [&]
+		{
+			size_t i = 0;
+			while (i != a.size() and a[i] == b[i])
+				++i;
+			bench::do_not_optimize(i);
+		});
+	state.run("std", 2 * IntSize, [&] { bench::do_not_optimize(std::mismatch(a.begin(), a.end(), b.begin(), b.end())); });
+}
+
+RAH_BENCH(find_if)
+{
+	std::vector<int> in(state.size(), 0);
+	in.back() = 1;
+	auto const is_one = [](int i) { return i == 1; };
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::find_if(in, is_one)); });
+	state.run("loop", IntSize, [&]
+		{
+			size_t i = 0;
+			while (i != in.size() and not is_one(in[i]))
+				++i;
+			bench::do_not_optimize(i);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::find_if(in.begin(), in.end(), is_one)); });
+}
+
+RAH_BENCH(min_element)
+{
+	auto const in = bench::random_ints(state.size());
+	state.run("rah", IntSize, [&] { bench::do_not_optimize(rah::min_element(in)); });
+	state.run("loop", IntSize, [&]
+		{
+			size_t best = 0;
+			for (size_t i = 1; i < in.size(); ++i)
+			{
+				if (in[i] < in[best])
+					best = i;
+			}
+			bench::do_not_optimize(best);
+		});
+	state.run("std", IntSize, [&] { bench::do_not_optimize(std::min_element(in.begin(), in.end())); });
+}
+
+RAH_BENCH(copy_if)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out;
+	out.reserve(in.size());
+	state.run("rah", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			rah::copy_if(in, rah::back_inserter(out), is_even);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("loop", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			for (int i : in)
+			{
+				if (is_even(i))
+					out.push_back(i);
+			}
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 1.5 * IntSize, [&]
+		{
+			out.clear();
+			std::copy_if(in.begin(), in.end(), std::back_inserter(out), is_even);
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(remove)
+{
+	auto const in = bench::random_ints(state.size(), 3);
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::action::remove(values, 0);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			values.erase(std::remove(values.begin(), values.end(), 0), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(partition)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			bench::do_not_optimize(rah::partition(values, is_even));
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			bench::do_not_optimize(std::partition(values.begin(), values.end(), is_even));
+		});
+}
+
+RAH_BENCH(stable_partition)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			bench::do_not_optimize(rah::stable_partition(values, is_even));
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			bench::do_not_optimize(std::stable_partition(values.begin(), values.end(), is_even));
+		});
+}
+
+RAH_BENCH(stable_sort)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::stable_sort(values);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			std::stable_sort(values.begin(), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(nth_element)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::nth_element(values, values.begin() + intptr_t(values.size() / 2));
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			std::nth_element(values.begin(), values.begin() + intptr_t(values.size() / 2), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+// Sort the smallest tenth of the elements
+RAH_BENCH(partial_sort)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::partial_sort(values, values.begin() + intptr_t(values.size() / 10));
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			std::partial_sort(values.begin(), values.begin() + intptr_t(values.size() / 10), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(partial_sort_copy)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> out(std::min<size_t>(10, in.size()));
+	state.run("rah", IntSize, [&]
+		{
+			rah::partial_sort_copy(in, out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", IntSize, [&]
+		{
+			std::partial_sort_copy(in.begin(), in.end(), out.begin(), out.end());
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(shuffle)
+{
+	std::vector<int> values = bench::random_ints(state.size());
+	std::mt19937 engine;
+	state.run("rah", 2 * IntSize, [&]
+		{
+			rah::shuffle(values, engine);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, [&]
+		{
+			std::shuffle(values.begin(), values.end(), engine);
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(set_difference)
+{
+	int const maxValue = int(state.size());
+	auto a = bench::random_ints(state.size() / 2, maxValue);
+	auto b = bench::random_ints(state.size() - a.size(), maxValue);
+	std::sort(a.begin(), a.end());
+	std::sort(b.begin(), b.end());
+	std::vector<int> out(a.size());
+	state.run("rah", 1.5 * IntSize, [&]
+		{
+			rah::set_difference(a, b, out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 1.5 * IntSize, [&]
+		{
+			std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(set_intersection)
+{
+	int const maxValue = int(state.size());
+	auto a = bench::random_ints(state.size() / 2, maxValue);
+	auto b = bench::random_ints(state.size() - a.size(), maxValue);
+	std::sort(a.begin(), a.end());
+	std::sort(b.begin(), b.end());
+	std::vector<int> out(a.size());
+	state.run("rah", 1.5 * IntSize, [&]
+		{
+			rah::set_intersection(a, b, out);
+			bench::do_not_optimize(out.data());
+		});
+	state.run("std", 1.5 * IntSize, [&]
+		{
+			std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+			bench::do_not_optimize(out.data());
+		});
+}
+
+RAH_BENCH(action_distinct)
+{
+	auto const in = bench::random_ints(state.size(), int(state.size() / 4));
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::action::distinct(values);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			std::sort(values.begin(), values.end());
+			values.erase(std::unique(values.begin(), values.end()), values.end());
+			bench::do_not_optimize(values.data());
+		});
+}
+
+RAH_BENCH(sort_by_key)
+{
+	auto const keys = bench::random_ints(state.size());
+	std::vector<std::pair<int, int>> in(keys.size());
+	for (size_t i = 0; i != in.size(); ++i)
+		in[i] = { keys[i], int(i) };
+	std::vector<std::pair<int, int>> values;
+	auto const reset = [&] { values = in; };
+	auto const key = [](std::pair<int, int> const& keyValue) { return keyValue.first; };
+	state.run("rah", 4 * IntSize, reset, [&]
+		{
+			rah::action::sort_by_key(values, key);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 4 * IntSize, reset, [&]
+		{
+			std::stable_sort(values.begin(), values.end(), [&](auto const& a, auto const& b) { return key(a) < key(b); });
+			bench::do_not_optimize(values.data());
+		});
+}
+
+// The key is costly to compute, so computing it once by element pays off
+RAH_BENCH(sort_by_cached_key)
+{
+	auto const in = bench::random_ints(state.size());
+	std::vector<int> values;
+	auto const reset = [&] { values = in; };
+	auto const key = [](int i) { return std::to_string(i); };
+	state.run("rah", 2 * IntSize, reset, [&]
+		{
+			rah::action::sort_by_cached_key(values, key);
+			bench::do_not_optimize(values.data());
+		});
+	state.run("std", 2 * IntSize, reset, [&]
+		{
+			std::sort(values.begin(), values.end(), [&](int a, int b) { return key(a) < key(b); });
+			bench::do_not_optimize(values.data());
+		});
+}
+
+int main(int argc, char** argv)
+{
+	return bench::main(argc, argv);
+}
@@ -0,0 +1,567 @@
+//
+// Copyright (c) 2019 Loïc HAMOT
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Minimal micro-benchmark harness, used by bench.cpp. No dependency other than the standard library.
+//
+#pragma once
+
+#ifdef MSVC
+#pragma warning(push, 0)
+#endif
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define RAH_BENCH_HAS_PERF_EVENT
+#endif
+#ifdef MSVC
+#pragma warning(pop)
+#endif
+
+namespace bench
+{
+
+/// Prevent the compiler to optimize away the computation of @b value
+template<typename T>
+inline void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static_cast<void>(*reinterpret_cast<char const volatile*>(&value));
+	_ReadWriteBarrier();
+#endif
+}
+
+/// Prevent the compiler to optimize away the writes in memory
+inline void clobber_memory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : : "memory");
+#else
+	_ReadWriteBarrier();
+#endif
+}
+
+/// Duration of one iteration of a benchmark
+struct measure
+{
+	double seconds; ///< Duration of one iteration
+	size_t iterations; ///< Iteration count used in the sample
+};
+
+/// Time @b iterations calls to @b body, calling @b setup before each of them, out of the measure.
+/// @return The total duration in seconds
+template<typename S, typename F>
+double sample(size_t iterations, S&& setup, F&& body)
+{
+	using clock = std::chrono::steady_clock;
+	clock::duration total{};
+	for (size_t i = 0; i != iterations; ++i)
+	{
+		setup();
+		clobber_memory();
+		auto const start = clock::now();
+		body();
+		clobber_memory();
+		total += clock::now() - start;
+	}
+	return std::chrono::duration<double>(total).count();
+}
+
+/// Find the iteration count for a sample to last at least @b minTime, then take @b repetitions samples
+/// @return The fastest iteration
+template<typename S, typename F>
+measure measure_best(double minTime, size_t repetitions, S&& setup, F&& body)
+{
+	size_t iterations = 1;
+	double seconds = sample(iterations, setup, body);
+	while (seconds < minTime and iterations < (size_t(1) << 30))
+	{
+		double const factor = seconds <= 0. ? 10. : std::min(10., 1.2 * minTime / seconds);
+		iterations = std::max(iterations + 1, size_t(double(iterations) * factor));
+		seconds = sample(iterations, setup, body);
+	}
+	double best = seconds;
+	for (size_t rep = 1; rep < repetitions; ++rep)
+		best = std::min(best, sample(iterations, setup, body));
+	return { best / double(iterations), iterations };
+}
+
+/// @see measure_best(double, size_t, S&&, F&&)
+template<typename F>
+measure measure_best(double minTime, size_t repetitions, F&& body)
+{
+	return measure_best(minTime, repetitions, [] {}, body);
+}
+
+// ********************************** hardware counters *******************************************
+
+/// Hardware events counted by perf_counters
+enum event
+{
+	Cycles,
+	Instructions,
+	BranchMisses,
+	L1dMisses, ///< L1 data cache read misses
+	LlcMisses, ///< Last level cache misses
+	EventCount
+};
+
+inline char const* event_name(size_t ev)
+{
+	static char const* const names[EventCount] = {
+		"cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses" };
+	return names[ev];
+}
+
+/// Counts of the hardware events. NaN for the unavailable events.
+using event_counts = std::array<double, EventCount>;
+
+inline event_counts unavailable_events()
+{
+	event_counts counts;
+	counts.fill(std::numeric_limits<double>::quiet_NaN());
+	return counts;
+}
+
+/// Hardware counters of the current thread, in user space, read with perf_event_open.
+/// @remark Unavailable out of Linux, or when the kernel forbid it (perf_event_paranoid > 2, containers
+/// without CAP_PERFMON...). Then available() is false and the harness only measure the time.
+/// @remark Events not supported by the CPU (often the cache events in virtual machines) are NaN.
+class perf_counters
+{
+public:
+	perf_counters()
+	{
+		slots_.fill(-1);
+#ifdef RAH_BENCH_HAS_PERF_EVENT
+		struct event_config
+		{
+			uint32_t type;
+			uint64_t config;
+		};
+		event_config const configs[EventCount] = {
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+				| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+				| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		};
+		// All the events are in the group of the first one, to be enabled and read together
+		for (size_t ev = 0; ev != EventCount; ++ev)
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = configs[ev].type;
+			attr.config = configs[ev].config;
+			attr.disabled = leader_ == -1 ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			int const fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, leader_, 0));
+			if (fd == -1)
+				continue;
+			if (leader_ == -1)
+				leader_ = fd;
+			fds_.push_back(fd);
+			slots_[ev] = int(fds_.size() - 1);
+		}
+#endif
+	}
+	perf_counters(perf_counters const&) = delete;
+	perf_counters& operator=(perf_counters const&) = delete;
+	~perf_counters()
+	{
+#ifdef RAH_BENCH_HAS_PERF_EVENT
+		for (int fd : fds_)
+			close(fd);
+#endif
+	}
+
+	bool available() const { return leader_ != -1; }
+
+	/// Set all counters to zero
+	void reset() { control(PERF_EVENT_IOC_RESET); }
+	/// Start counting
+	void enable() { control(PERF_EVENT_IOC_ENABLE); }
+	/// Stop counting
+	void disable() { control(PERF_EVENT_IOC_DISABLE); }
+
+	/// @return The counts since the last reset, scaled if the counters were multiplexed
+	event_counts read() const
+	{
+		event_counts counts = unavailable_events();
+#ifdef RAH_BENCH_HAS_PERF_EVENT
+		// nr, time_enabled, time_running, values[nr]
+		uint64_t buffer[3 + EventCount] = {};
+		if (not available() or ::read(leader_, buffer, sizeof(buffer)) <= 0 or buffer[2] == 0)
+			return counts;
+		double const scale = double(buffer[1]) / double(buffer[2]);
+		for (size_t ev = 0; ev != EventCount; ++ev)
+		{
+			if (slots_[ev] != -1)
+				counts[ev] = double(buffer[3 + slots_[ev]]) * scale;
+		}
+#endif
+		return counts;
+	}
+
+private:
+	int leader_ = -1;
+	std::vector<int> fds_;
+	std::array<int, EventCount> slots_; ///< Position of the events in the group, or -1
+
+#ifdef RAH_BENCH_HAS_PERF_EVENT
+	void control(unsigned long request)
+	{
+		if (available())
+			ioctl(leader_, request, PERF_IOC_FLAG_GROUP);
+	}
+#else
+	void control(unsigned long) {}
+	enum { PERF_EVENT_IOC_RESET, PERF_EVENT_IOC_ENABLE, PERF_EVENT_IOC_DISABLE };
+#endif
+};
+
+/// Count the hardware events of @b iterations calls to @b body, calling @b setup before each of them.
+/// @b setup is not counted.
+/// @return The counts of one iteration
+template<typename S, typename F>
+event_counts count_events(perf_counters& perf, size_t iterations, S&& setup, F&& body)
+{
+	perf.reset();
+	for (size_t i = 0; i != iterations; ++i)
+	{
+		setup();
+		clobber_memory();
+		perf.enable();
+		body();
+		clobber_memory();
+		perf.disable();
+	}
+	event_counts counts = perf.read();
+	for (double& count : counts)
+		count /= double(iterations);
+	return counts;
+}
+
+/// @see count_events(perf_counters&, size_t, S&&, F&&)
+/// @remark The counters are enabled only once, to not count their own overhead
+template<typename F>
+event_counts count_events(perf_counters& perf, size_t iterations, F&& body)
+{
+	perf.reset();
+	clobber_memory();
+	perf.enable();
+	for (size_t i = 0; i != iterations; ++i)
+		body();
+	clobber_memory();
+	perf.disable();
+	event_counts counts = perf.read();
+	for (double& count : counts)
+		count /= double(iterations);
+	return counts;
+}
+
+// ********************************** harness *****************************************************
+
+/// Result of a benchmark, for one variant and one size
+struct result
+{
+	std::string name; ///< Name of the benchmark (the view or algorithm)
+	std::string variant; ///< "rah", "loop" (hand written) or "std"
+	size_t size; ///< Element count
+	size_t iterations; ///< Iteration count of the fastest sample
+	double nsPerElement; ///< Time by element of the fastest sample
+	double bytesPerElement; ///< Memory read and written by element
+	event_counts eventsPerElement; ///< Hardware events by element. NaN when unavailable.
+};
+
+/// Options of the run, given in command line
+struct options
+{
+	size_t minSize = 100;
+	size_t maxSize = 1000000;
+	double minTime = 0.02; ///< Minimal duration of a sample, in seconds
+	size_t repetitions = 3; ///< Sample count. The fastest is kept.
+	std::string filter; ///< Only run the benchmarks which name contains this string
+	std::string format = "csv"; ///< "csv" or "json"
+	std::string output; ///< Output file. stdout if empty.
+	bool counters = true; ///< Read the hardware counters, when available
+};
+
+/// Given to the benchmarks, to run their variants
+class state
+{
+public:
+	state(options const& opts, perf_counters* perf, std::string name, size_t size, std::vector<result>& results)
+		: options_(opts), perf_(perf), name_(std::move(name)), size_(size), results_(results)
+	{
+	}
+
+	/// Element count to process
+	size_t size() const { return size_; }
+
+	/// Measure @b body, which process size() elements.
+	/// @param bytesPerElement Memory read and written by element
+	template<typename F>
+	void run(char const* variant, double bytesPerElement, F&& body)
+	{
+		measure const best = measure_best(options_.minTime, options_.repetitions, body);
+		event_counts const events = perf_ == nullptr ?
+			unavailable_events() :
+			count_events(*perf_, best.iterations, body);
+		record(variant, bytesPerElement, best, events);
+	}
+
+	/// Measure @b body, calling @b setup before each iteration, out of the measure.
+	/// Used by the algorithms modifying their input, like sort.
+	template<typename S, typename F>
+	void run(char const* variant, double bytesPerElement, S&& setup, F&& body)
+	{
+		measure const best = measure_best(options_.minTime, options_.repetitions, setup, body);
+		event_counts const events = perf_ == nullptr ?
+			unavailable_events() :
+			count_events(*perf_, best.iterations, setup, body);
+		record(variant, bytesPerElement, best, events);
+	}
+
+private:
+	void record(char const* variant, double bytesPerElement, measure const& best, event_counts events)
+	{
+		double const elementCount = double(std::max<size_t>(size_, 1));
+		double const nsPerElement = best.seconds * 1e9 / elementCount;
+		for (double& count : events)
+			count /= elementCount;
+		results_.push_back({ name_, variant, size_, best.iterations, nsPerElement, bytesPerElement, events });
+		std::fprintf(stderr, "%-24s %-5s %10zu %10.3f ns/elt", name_.c_str(), variant, size_, nsPerElement);
+		if (not std::isnan(events[Cycles]))
+			std::fprintf(stderr, " %8.3f cycles/elt", events[Cycles]);
+		if (not std::isnan(events[Instructions] / events[Cycles]))
+			std::fprintf(stderr, " %6.2f IPC", events[Instructions] / events[Cycles]);
+		std::fprintf(stderr, "\n");
+	}
+
+	options const& options_;
+	perf_counters* perf_; ///< nullptr when the counters are disabled or unavailable
+	std::string name_;
+	size_t size_;
+	std::vector<result>& results_;
+};
+
+using benchmark_func = void(*)(state&);
+
+struct benchmark
+{
+	char const* name;
+	benchmark_func func;
+};
+
+inline std::vector<benchmark>& registry()
+{
+	static std::vector<benchmark> benchmarks;
+	return benchmarks;
+}
+
+struct registrar
+{
+	registrar(char const* name, benchmark_func func) { registry().push_back({ name, func }); }
+};
+
+/// Declare a benchmark, which will be run for all sizes
+#define RAH_BENCH(NAME) \
+	static void bench_##NAME(::bench::state& state); \
+	static ::bench::registrar const registrar_##NAME(#NAME, &bench_##NAME); \
+	static void bench_##NAME(::bench::state& state)
+
+/// @return @b size pseudo random ints in [0, maxValue], always the same
+inline std::vector<int> random_ints(size_t size, int maxValue = std::numeric_limits<int>::max())
+{
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> dist(0, maxValue);
+	std::vector<int> values(size);
+	for (int& value : values)
+		value = dist(gen);
+	return values;
+}
+
+/// Write @b value, or @b unavailable if it is NaN
+inline void write_number(std::FILE* file, double value, char const* unavailable)
+{
+	if (std::isnan(value))
+		std::fprintf(file, "%s", unavailable);
+	else
+		std::fprintf(file, "%.4f", value);
+}
+
+/// @remark The columns of the unavailable hardware events are empty
+inline void write_csv(std::FILE* file, std::vector<result> const& results)
+{
+	std::fprintf(file, "name,variant,size,iterations,ns_per_element,bytes_per_element");
+	for (size_t ev = 0; ev != EventCount; ++ev)
+		std::fprintf(file, ",%s_per_element", event_name(ev));
+	std::fprintf(file, ",ipc\n");
+	for (result const& res : results)
+	{
+		std::fprintf(file, "%s,%s,%zu,%zu,%.4f,%.2f",
+			res.name.c_str(), res.variant.c_str(), res.size, res.iterations, res.nsPerElement, res.bytesPerElement);
+		for (double count : res.eventsPerElement)
+		{
+			std::fprintf(file, ",");
+			write_number(file, count, "");
+		}
+		std::fprintf(file, ",");
+		write_number(file, res.eventsPerElement[Instructions] / res.eventsPerElement[Cycles], "");
+		std::fprintf(file, "\n");
+	}
+}
+
+inline void write_json(std::FILE* file, std::vector<result> const& results, bool countersAvailable)
+{
+	std::fprintf(file, "{\n  \"context\": {\n");
+#if defined(__clang__)
+	std::fprintf(file, "    \"compiler\": \"clang %s\",\n", __clang_version__);
+#elif defined(__GNUC__)
+	std::fprintf(file, "    \"compiler\": \"gcc %s\",\n", __VERSION__);
+#elif defined(_MSC_VER)
+	std::fprintf(file, "    \"compiler\": \"msvc %d\",\n", _MSC_VER);
+#endif
+	std::fprintf(file, "    \"cplusplus\": %ld,\n", long(__cplusplus));
+	std::fprintf(file, "    \"hardware_counters\": %s\n  },\n  \"results\": [", countersAvailable ? "true" : "false");
+	for (size_t i = 0; i != results.size(); ++i)
+	{
+		result const& res = results[i];
+		std::fprintf(file,
+			"%s\n    {\"name\": \"%s\", \"variant\": \"%s\", \"size\": %zu, \"iterations\": %zu, "
+			"\"ns_per_element\": %.4f, \"bytes_per_element\": %.2f",
+			i == 0 ? "" : ",",
+			res.name.c_str(), res.variant.c_str(), res.size, res.iterations, res.nsPerElement, res.bytesPerElement);
+		for (size_t ev = 0; ev != EventCount; ++ev)
+		{
+			std::fprintf(file, ", \"%s_per_element\": ", event_name(ev));
+			write_number(file, res.eventsPerElement[ev], "null");
+		}
+		std::fprintf(file, ", \"ipc\": ");
+		write_number(file, res.eventsPerElement[Instructions] / res.eventsPerElement[Cycles], "null");
+		std::fprintf(file, "}");
+	}
+	std::fprintf(file, "\n  ]\n}\n");
+}
+
+inline void print_usage(char const* exe)
+{
+	std::fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  --filter=<text>      Only run the benchmarks which name contains text\n"
+		"  --min-size=<n>       Smallest element count (default 1e2)\n"
+		"  --max-size=<n>       Biggest element count (default 1e6, up to 1e8 or more)\n"
+		"  --min-time=<sec>     Minimal duration of a sample (default 0.02)\n"
+		"  --repetitions=<n>    Sample count, the fastest is kept (default 3)\n"
+		"  --format=<csv|json>  Output format (default csv)\n"
+		"  --output=<file>      Output file (default stdout)\n"
+		"  --no-counters        Don't read the hardware counters\n"
+		"  --list               List the benchmarks\n",
+		exe);
+}
+
+/// Parse the command line, run the benchmarks for sizes minSize, 10*minSize, ... maxSize,
+/// and write the results
+inline int main(int argc, char** argv)
+{
+	options opts;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string const arg = argv[i];
+		size_t const equal = arg.find('=');
+		std::string const key = arg.substr(0, equal);
+		std::string const value = equal == std::string::npos ? std::string() : arg.substr(equal + 1);
+		if (key == "--filter")
+			opts.filter = value;
+		else if (key == "--min-size")
+			opts.minSize = size_t(std::atof(value.c_str()));
+		else if (key == "--max-size")
+			opts.maxSize = size_t(std::atof(value.c_str()));
+		else if (key == "--min-time")
+			opts.minTime = std::atof(value.c_str());
+		else if (key == "--repetitions")
+			opts.repetitions = std::max<size_t>(1, size_t(std::atoi(value.c_str())));
+		else if (key == "--format" and (value == "csv" or value == "json"))
+			opts.format = value;
+		else if (key == "--output")
+			opts.output = value;
+		else if (key == "--no-counters")
+			opts.counters = false;
+		else if (key == "--help")
+		{
+			print_usage(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else if (key == "--list")
+		{
+			for (benchmark const& bench : registry())
+				std::printf("%s\n", bench.name);
+			return EXIT_SUCCESS;
+		}
+		else
+		{
+			print_usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	perf_counters perf;
+	bool const useCounters = opts.counters and perf.available();
+	if (opts.counters and not useCounters)
+		std::fprintf(stderr, "Hardware counters unavailable. Only the time is measured.\n");
+
+	std::vector<result> results;
+	for (benchmark const& bench : registry())
+	{
+		if (std::strstr(bench.name, opts.filter.c_str()) == nullptr)
+			continue;
+		for (size_t size = std::max<size_t>(opts.minSize, 1); size <= opts.maxSize; size *= 10)
+		{
+			state st(opts, useCounters ? &perf : nullptr, bench.name, size, results);
+			bench.func(st);
+		}
+	}
+
+	std::FILE* file = opts.output.empty() ? stdout : std::fopen(opts.output.c_str(), "w");
+	if (file == nullptr)
+	{
+		std::fprintf(stderr, "Can't open %s\n", opts.output.c_str());
+		return EXIT_FAILURE;
+	}
+	if (opts.format == "json")
+		write_json(file, results, useCounters);
+	else
+		write_csv(file, results);
+	if (file != stdout)
+		std::fclose(file);
+	return EXIT_SUCCESS;
+}
+
+} // namespace bench
@@ -106,6 +106,7 @@
 
 /// @fn rah::view::all(R&& range)
 /// @brief Create a view on the whole range
+/// @remark A rvalue container is moved into the view, which keep it alive (see rah::view::own)
 
 /// @fn rah::view::all()
 /// @brief Create a view on the whole range
@@ -157,6 +158,9 @@
 
 /// @fn rah::view::sliding(R&& range, size_t n)
 /// @brief Given a range and a count n, place a window over the first n elements of the underlying range. Return the contents of that window as the first element of the adapted range, then slide the window forward one element at a time until hitting the end of the underlying range. 
+/// @remark On bidirectional ranges, the windows point into the underlying range.
+/// @remark On forward and single-pass ranges, this is rah::view::sliding_buffered: the windows point into a ring buffer stored in the view.
+/// The result is then a single-pass range (input iterators), the view must outlive its iterators, and a window is invalidated when the iterator is incremented.
 ///
 /// @snippet test.cpp sliding
 
@@ -295,6 +299,8 @@
 
 /// @fn rah::view::join(R&& range_of_ranges)
 /// @brief Given a range of ranges, join them into a flattened sequence of elements.
+/// @remark When the sub-ranges are containers returned by value, the current one is stored in the view,
+/// which is single-pass (input iterators) and must outlive its iterators.
 ///
 /// @snippet test.cpp join
 
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2019 Loïc HAMOT
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Check that some pipelines are as fast as the equivalent hand written loops.
+// Must be compiled with optimizations (-O2). Fails if a pipeline is slower than its loop by more than
+// the tolerance (--tolerance=0.25 by default).
+//
+#include "rah.hpp"
+#include "bench.hpp"
+
+#ifdef MSVC
+#pragma warning(push, 0)
+#endif
+#include <cstdio>
+#include <string>
+#ifdef MSVC
+#pragma warning(pop)
+#endif
+
+namespace
+{
+size_t const Size = 10000;
+double const MinTime = 0.01;
+size_t const Repetitions = 5;
+/// Measures are retried before failing, to be robust to a noisy machine
+size_t const Attempts = 5;
+
+auto const times3 = [](int i) { return i * 3; };
+auto const is_even = [](int i) { return i % 2 == 0; };
+
+struct overhead_test
+{
+	char const* name;
+	bool (*run)(double tolerance);
+};
+
+/// Compare the fastest run of @b pipeline to the fastest run of @b loop.
+/// They are measured alternately, so that both see the same machine load.
+template<typename P, typename L>
+bool compare(char const* name, double tolerance, P&& pipeline, L&& loop)
+{
+	double bestRatio = 0.;
+	for (size_t attempt = 0; attempt != Attempts; ++attempt)
+	{
+		double const loopTime = bench::measure_best(MinTime, Repetitions, loop).seconds;
+		double const rahTime = bench::measure_best(MinTime, Repetitions, pipeline).seconds;
+		double const ratio = rahTime / loopTime;
+		bestRatio = attempt == 0 ? ratio : std::min(bestRatio, ratio);
+		std::printf("%-30s rah: %8.3f ns loop: %8.3f ns ratio: %.3f\n",
+			name, rahTime * 1e9 / Size, loopTime * 1e9 / Size, ratio);
+		if (ratio <= 1. + tolerance)
+			return true;
+	}
+	std::printf("%-30s NOT OK: overhead of %.0f%%\n", name, (bestRatio - 1.) * 100.);
+	return false;
+}
+
+bool iota_transform_filter_reduce(double tolerance)
+{
+	int const size = int(Size);
+	return compare("iota|transform|filter|reduce", tolerance,
+		[&]
+		{
+			auto sum = rah::view::iota(0, size)
+				| rah::view::transform(times3)
+				| rah::view::filter(is_even)
+				| rah::reduce(int64_t(), std::plus<>());
+			bench::do_not_optimize(sum);
+		},
+		[&]
+		{
+			int64_t sum = 0;
+			for (int i = 0; i != size; ++i)
+			{
+				int const value = times3(i);
+				if (is_even(value))
+					sum += value;
+			}
+			bench::do_not_optimize(sum);
+		});
+}
+
+bool zip_transform(double tolerance)
+{
+	auto const a = bench::random_ints(Size, 1000);
+	auto const b = bench::random_ints(Size, 1000);
+	return compare("zip|transform", tolerance,
+		[&]
+		{
+			auto sum = rah::view::zip(a, b)
+				| rah::view::transform([](auto&& ab) { return std::get<0>(ab) * std::get<1>(ab); })
+				| rah::reduce(int64_t(), std::plus<>());
+			bench::do_not_optimize(sum);
+		},
+		[&]
+		{
+			int64_t sum = 0;
+			for (size_t i = 0; i != a.size(); ++i)
+				sum += a[i] * b[i];
+			bench::do_not_optimize(sum);
+		});
+}
+
+bool take_drop(double tolerance)
+{
+	auto const in = bench::random_ints(Size * 2, 1000);
+	size_t const first = in.size() / 4;
+	size_t const last = first + Size;
+	return compare("take|drop", tolerance,
+		[&]
+		{
+			auto sum = in
+				| rah::view::take(last)
+				| rah::view::drop(first)
+				| rah::reduce(int64_t(), std::plus<>());
+			bench::do_not_optimize(sum);
+		},
+		[&]
+		{
+			int64_t sum = 0;
+			for (size_t i = first; i != last; ++i)
+				sum += in[i];
+			bench::do_not_optimize(sum);
+		});
+}
+
+overhead_test const tests[] = {
+	{ "iota_transform_filter_reduce", &iota_transform_filter_reduce },
+	{ "zip_transform", &zip_transform },
+	{ "take_drop", &take_drop },
+};
+}
+
+/// Usage: rah_overhead_test [--tolerance=<ratio>] [--filter=<text>]
+int main(int argc, char** argv)
+{
+	double tolerance = 0.25;
+	std::string filter;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string const arg = argv[i];
+		if (arg.compare(0, 12, "--tolerance=") == 0)
+			tolerance = std::atof(arg.c_str() + 12);
+		else if (arg.compare(0, 9, "--filter=") == 0)
+			filter = arg.substr(9);
+	}
+
+	bool success = true;
+	for (overhead_test const& test : tests)
+	{
+		if (std::string(test.name).find(filter) != std::string::npos)
+			success = test.run(tolerance) and success;
+	}
+	std::printf(success ? "ALL TEST OK\n" : "NOT OK\n");
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -8,6 +8,9 @@
 
 #include <cassert>
 #include <ciso646>
+#include <cstring>
+#include <cstddef>
+#include <new>
 
 #ifndef RAH_DONT_USE_STD
 
@@ -19,8 +22,33 @@
 #include <tuple>
 #include <algorithm>
 #include <numeric>
+#include <limits>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <vector>
 #include <array>
+#include <string>
+#include <cstdio>
+#if defined(__has_include)
+#if __has_include(<charconv>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#include <charconv>
+#endif
+#if __has_include(<memory_resource>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#include <memory_resource>
+#define RAH_HAS_MEMORY_RESOURCE
+#endif
+#endif
+#if defined(RAH_TIMING_RDTSC) and (defined(__x86_64__) or defined(__i386__) or defined(_M_X64) or defined(_M_IX86))
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define RAH_TIMING_HAS_RDTSC
+#endif
 #ifdef MSVC
 #pragma warning(pop)
 #endif
@@ -39,6 +67,42 @@
 #define RAH_NAMESPACE rah
 #endif
 
+// Views and algorithms usable in constant expressions, since C++17 (C++20 for those using std algorithms)
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define RAH_CPP17
+#define RAH_CONSTEXPR17 constexpr
+#else
+#define RAH_CONSTEXPR17
+#endif
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#define RAH_CONSTEXPR20 constexpr
+#else
+#define RAH_CONSTEXPR20
+#endif
+
+// The algorithms call the std ones at runtime, and their own loops in constant expressions.
+// Without the builtin, the loops are also used at runtime.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define RAH_HAS_IS_CONSTANT_EVALUATED
+#endif
+#endif
+#if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define RAH_HAS_IS_CONSTANT_EVALUATED
+#endif
+#if !defined(RAH_CPP17)
+#define RAH_IS_CONSTANT_EVALUATED() false
+#elif defined(RAH_HAS_IS_CONSTANT_EVALUATED)
+#define RAH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define RAH_IS_CONSTANT_EVALUATED() true
+#endif
+
+// Loops on ranges with at most this count of elements, known at compile time, are fully unrolled
+#ifndef RAH_UNROLL_MAX_EXTENT
+#define RAH_UNROLL_MAX_EXTENT 16
+#endif
+
 namespace RAH_STD
 {
 	template<class T, std::size_t Extent> class span;
@@ -48,6 +112,7 @@ namespace RAH_NAMESPACE
 {
 
 constexpr intptr_t End = -1; ///< Used with rah::view::slice to point to the end
+constexpr size_t DynamicExtent = size_t(-1); ///< Size of a range, unknown at compile time
 
 // **************************** range traits ******************************************************
 
@@ -95,21 +160,21 @@ struct has_free_begin_end<
 template< class T >
 constexpr bool has_free_begin_end_v = has_free_begin_end<T>::value;
 
-template<class T, size_t N> T* rah_begin(T(&array)[N]) { return (T*)array; }
+template<class T, size_t N> RAH_CONSTEXPR17 T* rah_begin(T(&array)[N]) { return (T*)array; }
 
-template<class T, size_t N> T* rah_end(T(&array)[N]) noexcept { return array + N; }
+template<class T, size_t N> RAH_CONSTEXPR17 T* rah_end(T(&array)[N]) noexcept { return array + N; }
 
 /// Call the member begin if it exists
 /// This avoid some ADL fail when using conteners with mixed namespaces
 template<class Container, std::enable_if_t<has_member_begin_end_v<Container>, int> = 0>
-auto rah_begin(Container&& container)
+RAH_CONSTEXPR17 auto rah_begin(Container&& container)
 {
     return container.begin();
 }
 
 /// Call the member end if it exists
 template<class Container, std::enable_if_t<has_member_begin_end_v<Container>, int> = 0>
-auto rah_end(Container&& container)
+RAH_CONSTEXPR17 auto rah_end(Container&& container)
 {
     return container.end();
 }
@@ -118,7 +183,7 @@ auto rah_end(Container&& container)
 template<
 	class Container,
 	std::enable_if_t<has_free_begin_end_v<Container> and not has_member_begin_end_v<Container>, int> = 0>
-auto rah_begin(Container&& container)
+RAH_CONSTEXPR17 auto rah_begin(Container&& container)
 {
 	return begin(container);
 }
@@ -127,7 +192,7 @@ auto rah_begin(Container&& container)
 template<
 	class Container,
 	std::enable_if_t<has_free_begin_end_v<Container> and not has_member_begin_end_v<Container>, int> = 0>
-auto rah_end(Container&& container)
+RAH_CONSTEXPR17 auto rah_end(Container&& container)
 {
 	return end(container);
 }
@@ -164,34 +229,68 @@ RAH_STD::random_access_iterator_tag get_common_iterator_tag(RAH_STD::random_acce
 template<typename A, typename B>
 using common_iterator_tag = decltype(get_common_iterator_tag(A{}, B{}));
 
+/// \cond PRIVATE
+namespace details
+{
+template<typename R>
+size_t size_hint(R&& range, RAH_STD::random_access_iterator_tag)
+{
+	return size_t(rah_end(range) - rah_begin(range));
+}
+
+template<typename R>
+size_t size_hint(R&&, RAH_STD::input_iterator_tag)
+{
+	return 0;
+}
+} // namespace details
+/// \endcond
+
+/// @brief Get the count of elements in the range when it is known without iterating it, else 0.
+/// Used to preallocate memory.
+template<typename R> size_t size_hint(R&& range)
+{
+	return details::size_hint(range, range_iter_categ_t<R>{});
+}
+
 // ******************************** iterator_range ************************************************
 
-template<typename I>
+/// @tparam Extent Upper bound of the count of elements, when it is known at compile time.
+/// Kept by the views, from arrays and spans (see rah::static_max_size)
+/// @tparam Exact The count of elements is exactly @b Extent (see rah::static_size)
+template<typename I, size_t Extent = DynamicExtent, bool Exact = false>
 struct iterator_range
 {
 	I begin_iter;
 	I end_iter;
 
-	I begin() const { return begin_iter; }
-	I begin() { return begin_iter; }
-	I end() const { return end_iter; }
-	I end() { return end_iter; }
+	RAH_CONSTEXPR17 I begin() const { return begin_iter; }
+	RAH_CONSTEXPR17 I begin() { return begin_iter; }
+	RAH_CONSTEXPR17 I end() const { return end_iter; }
+	RAH_CONSTEXPR17 I end() { return end_iter; }
 };
 
 template<typename I>
-auto make_iterator_range(I b, I e)
+RAH_CONSTEXPR17 auto make_iterator_range(I b, I e)
 {
 	return iterator_range<I>{b, e};
 }
 
+/// Make a range of at most @b Extent elements (exactly @b Extent when @b Exact)
+template<size_t Extent, bool Exact = false, typename I>
+RAH_CONSTEXPR17 auto make_iterator_range(I b, I e)
+{
+	return iterator_range<I, Extent, Exact>{b, e};
+}
+
 /// Get the begin iterator of the range
-template<typename I> I begin(iterator_range<I>& r) { return r.begin_iter; }
+template<typename I, size_t E, bool X> RAH_CONSTEXPR17 I begin(iterator_range<I, E, X>& r) { return r.begin_iter; }
 /// Get the "past the" end iterator of the range
-template<typename I> I end(iterator_range<I>& r) { return r.end_iter; }
+template<typename I, size_t E, bool X> RAH_CONSTEXPR17 I end(iterator_range<I, E, X>& r) { return r.end_iter; }
 /// Get the begin iterator of the range
-template<typename I> I begin(iterator_range<I> const& r) { return r.begin_iter; }
+template<typename I, size_t E, bool X> RAH_CONSTEXPR17 I begin(iterator_range<I, E, X> const& r) { return r.begin_iter; }
 /// Get the "past the" end iterator of the range
-template<typename I> I end(iterator_range<I> const& r) { return r.end_iter; }
+template<typename I, size_t E, bool X> RAH_CONSTEXPR17 I end(iterator_range<I, E, X> const& r) { return r.end_iter; }
 
 // **************************************** pipeable **********************************************
 
@@ -202,13 +301,13 @@ struct pipeable
 };
 
 template<typename MakeRange>
-auto make_pipeable(MakeRange&& make_range)
+RAH_CONSTEXPR17 auto make_pipeable(MakeRange&& make_range)
 {
 	return pipeable<MakeRange>{ make_range };
 }
 
 template<typename R, typename MakeRange>
-auto operator | (R&& range, pipeable<MakeRange> const& adapter) ->decltype(adapter.func(RAH_STD::forward<R>(range)))
+RAH_CONSTEXPR17 auto operator | (R&& range, pipeable<MakeRange> const& adapter) ->decltype(adapter.func(RAH_STD::forward<R>(range)))
 {
 	return adapter.func(RAH_STD::forward<R>(range));
 }
@@ -218,19 +317,121 @@ auto operator | (R&& range, pipeable<MakeRange> const& adapter) ->decltype(adapt
 namespace details
 {
 
+/// Storage of optional. Trivially destructible when T is, so that optional<T> can be a literal type.
+template<typename T, bool = RAH_STD::is_trivially_destructible<T>::value>
+struct optional_storage
+{
+	union
+	{
+		char empty_;
+		T value_;
+	};
+	bool is_allocated_ = false;
+
+	constexpr optional_storage() : empty_() {}
+	constexpr optional_storage(T const& value) : value_(value), is_allocated_(true) {}
+};
+
+template<typename T>
+struct optional_storage<T, false>
+{
+	union
+	{
+		char empty_;
+		T value_;
+	};
+	bool is_allocated_ = false;
+
+	constexpr optional_storage() : empty_() {}
+	constexpr optional_storage(T const& value) : value_(value), is_allocated_(true) {}
+	~optional_storage()
+	{
+		if (is_allocated_)
+			value_.~T();
+	}
+};
+
 // Small optional impl for C++14 compilers
 template<typename T> struct optional
 {
+	using trivially_assignable = RAH_STD::integral_constant<bool,
+		RAH_STD::is_trivially_copy_assignable<T>::value and RAH_STD::is_trivially_destructible<T>::value>;
+
 	optional() = default;
+#ifdef RAH_CPP17
+	// The storage is initialized by copy elision. No placement new, so this is constexpr.
+	constexpr optional(optional const& other)
+		: storage_(other.has_value() ? optional_storage<T>(other.get()) : optional_storage<T>())
+	{
+	}
+#else
 	optional(optional const& other)
 	{
 		if (other.has_value())
 		{
 			new(getPtr()) T(other.get());
-			is_allocated_ = true;
+			storage_.is_allocated_ = true;
+		}
+	}
+#endif
+	RAH_CONSTEXPR17 optional& operator = (optional const& other)
+	{
+		assign(other, trivially_assignable());
+		return *this;
+	}
+	RAH_CONSTEXPR17 optional& operator = (optional&& other) noexcept
+	{
+		assign(RAH_STD::move(other), trivially_assignable());
+		return *this;
+	}
+	RAH_CONSTEXPR17 optional(T const& other) : storage_(other) {}
+	optional& operator=(T const& other)
+	{
+		reset();
+		new(getPtr()) T(other);
+		storage_.is_allocated_ = true;
+		return *this;
+	}
+	optional& operator=(T&& other)
+	{
+		reset();
+		new(getPtr()) T(RAH_STD::move(other));
+		storage_.is_allocated_ = true;
+		return *this;
+	}
+
+	RAH_CONSTEXPR17 bool has_value() const { return storage_.is_allocated_; }
+
+	void reset()
+	{
+		if (storage_.is_allocated_)
+		{
+			destruct_value();
+			storage_.is_allocated_ = false;
 		}
 	}
-	optional& operator = (optional const& other)
+
+	RAH_CONSTEXPR17 T& get() { assert(storage_.is_allocated_); return storage_.value_; }
+
+	RAH_CONSTEXPR17 T const& get() const { assert(storage_.is_allocated_); return storage_.value_; }
+
+	RAH_CONSTEXPR17 T& operator*() { return get(); }
+	RAH_CONSTEXPR17 T const& operator*() const { return get(); }
+	T* operator->() { assert(storage_.is_allocated_);  return getPtr(); }
+	T const* operator->() const { assert(storage_.is_allocated_);  return getPtr(); }
+
+private:
+	T* getPtr() { return &storage_.value_; }
+	T const* getPtr() const { return &storage_.value_; }
+	void destruct_value() { get().~T(); }
+
+	/// A trivially assignable value is copied with its storage, which is constexpr
+	RAH_CONSTEXPR17 void assign(optional const& other, RAH_STD::true_type)
+	{
+		storage_ = other.storage_;
+	}
+
+	void assign(optional const& other, RAH_STD::false_type)
 	{
 		if (has_value())
 		{
@@ -239,7 +440,7 @@ template<typename T> struct optional
 				// Handle the case where T is not copy assignable
 				reset();
 				new(getPtr()) T(other.get());
-				is_allocated_ = true;
+				storage_.is_allocated_ = true;
 			}
 			else
 				reset();
@@ -249,12 +450,17 @@ template<typename T> struct optional
 			if (other.has_value())
 			{
 				new(getPtr()) T(other.get());
-				is_allocated_ = true;
+				storage_.is_allocated_ = true;
 			}
 		}
-		return *this;
 	}
-	optional& operator = (optional&& other) noexcept
+
+	RAH_CONSTEXPR17 void assign(optional&& other, RAH_STD::true_type)
+	{
+		storage_ = other.storage_;
+	}
+
+	void assign(optional&& other, RAH_STD::false_type)
 	{
 		if (has_value())
 		{
@@ -263,7 +469,7 @@ template<typename T> struct optional
 				// A lambda with const capture is not move assignable
 				reset();
 				new(getPtr()) T(RAH_STD::move(other.get()));
-				is_allocated_ = true;
+				storage_.is_allocated_ = true;
 			}
 			else
 				reset();
@@ -273,59 +479,12 @@ template<typename T> struct optional
 			if (other.has_value())
 			{
 				new(getPtr()) T(RAH_STD::move(other.get()));
-				is_allocated_ = true;
+				storage_.is_allocated_ = true;
 			}
 		}
-		return *this;
-	}
-	optional(T const& other)
-	{
-		new(getPtr()) T(other);
-		is_allocated_ = true;
-	}
-	optional& operator=(T const& other)
-	{
-		reset();
-		new(getPtr()) T(other);
-		is_allocated_ = true;
-		return *this;
-	}
-	optional& operator=(T&& other)
-	{
-		reset();
-		new(getPtr()) T(RAH_STD::move(other));
-		is_allocated_ = true;
-		return *this;
-	}
-	~optional() { reset(); }
-
-	bool has_value() const { return is_allocated_; }
-
-	void reset()
-	{
-		if (is_allocated_)
-		{
-			destruct_value();
-			is_allocated_ = false;
-		}
 	}
 
-	T& get() { assert(is_allocated_); return *getPtr(); }
-
-	T const& get() const { assert(is_allocated_); return *getPtr(); }
-
-	T& operator*() { return get(); }
-	T const& operator*() const { return get(); }
-	T* operator->() { assert(is_allocated_);  return getPtr(); }
-	T const* operator->() const { assert(is_allocated_);  return getPtr(); }
-
-private:
-	T* getPtr() { return (T*)&value_; }
-	T const* getPtr() const { return (T const*)&value_; }
-	void destruct_value() { get().~T(); }
-
-	RAH_STD::aligned_storage_t<sizeof(T), RAH_STD::alignment_of<T>::value> value_{};
-	bool is_allocated_ = false;
+	optional_storage<T> storage_;
 };
 }
 
@@ -342,7 +501,7 @@ struct iterator_facade<I, R, RAH_STD::forward_iterator_tag>
 	{
 		using type = RAH_NAMESPACE::details::optional<Reference>;
 		template<typename Ref>
-		static type to_pointer(Ref&& ref)
+		static RAH_CONSTEXPR17 type to_pointer(Ref&& ref)
 		{
 			return RAH_STD::forward<Ref>(ref);
 		}
@@ -353,7 +512,7 @@ struct iterator_facade<I, R, RAH_STD::forward_iterator_tag>
 	{
 		using type = T*;
 		template<typename Ref>
-		static type to_pointer(Ref&& ref)
+		static RAH_CONSTEXPR17 type to_pointer(Ref&& ref)
 		{
 			return &ref;
 		}
@@ -367,20 +526,27 @@ struct iterator_facade<I, R, RAH_STD::forward_iterator_tag>
 
 	static_assert(not RAH_STD::is_reference<value_type>::value, "value_type can't be a reference");
 
-	auto& operator++()
+	RAH_CONSTEXPR17 auto& operator++()
 	{
 		RAH_SELF.increment();
 		return *this;
 	}
 
-	reference operator*() const 
+	RAH_CONSTEXPR17 reference operator*() const 
 	{ 
 		static_assert(RAH_STD::is_same<decltype(RAH_SELF_CONST.dereference()), reference>::value, "");
 		return RAH_SELF_CONST.dereference(); 
 	}
-	auto operator->() const { return pointer_type<R>::to_pointer(RAH_SELF_CONST.dereference()); }
-	bool operator!=(I const& other) const { return not RAH_SELF_CONST.equal(other); }
-	bool operator==(I const& other) const { return RAH_SELF_CONST.equal(other); }
+	RAH_CONSTEXPR17 auto operator->() const { return pointer_type<R>::to_pointer(RAH_SELF_CONST.dereference()); }
+	RAH_CONSTEXPR17 bool operator!=(I const& other) const { return not RAH_SELF_CONST.equal(other); }
+	RAH_CONSTEXPR17 bool operator==(I const& other) const { return RAH_SELF_CONST.equal(other); }
+};
+
+/// Single-pass iterators: a copy is invalidated when the other is incremented
+template<typename I, typename R>
+struct iterator_facade<I, R, RAH_STD::input_iterator_tag> : iterator_facade<I, R, RAH_STD::forward_iterator_tag>
+{
+	using iterator_category = RAH_STD::input_iterator_tag;
 };
 
 template<typename I, typename R>
@@ -413,7 +579,7 @@ struct iterator_facade<I, R, RAH_STD::bidirectional_iterator_tag> : iterator_fac
 {
 	using iterator_category = RAH_STD::bidirectional_iterator_tag;
 
-	auto& operator--()
+	RAH_CONSTEXPR17 auto& operator--()
 	{
 		RAH_SELF.decrement();
 		return *this;
@@ -425,38 +591,38 @@ struct iterator_facade<I, R, RAH_STD::random_access_iterator_tag> : iterator_fac
 {
 	using iterator_category = RAH_STD::random_access_iterator_tag;
 
-	auto& operator+=(intptr_t increment)
+	RAH_CONSTEXPR17 auto& operator+=(intptr_t increment)
 	{
 		RAH_SELF.advance(increment);
 		return *this;
 	}
 
-	auto operator+(intptr_t increment)
+	RAH_CONSTEXPR17 auto operator+(intptr_t increment) const
 	{
-		auto iter = RAH_SELF;
+		auto iter = RAH_SELF_CONST;
 		iter.advance(increment);
 		return iter;
 	}
 
-	auto& operator-=(intptr_t increment)
+	RAH_CONSTEXPR17 auto& operator-=(intptr_t increment)
 	{
 		RAH_SELF.advance(-increment);
 		return *this;
 	}
 
-	auto operator-(intptr_t increment)
+	RAH_CONSTEXPR17 auto operator-(intptr_t increment) const
 	{
-		auto iter = RAH_SELF;
+		auto iter = RAH_SELF_CONST;
 		iter.advance(-increment);
 		return iter;
 	}
 
-	auto operator-(I const& other) const { return RAH_SELF_CONST.distance_to(other); }
-	bool operator<(I const& other) const { return RAH_SELF_CONST.distance_to(other) < 0; }
-	bool operator<=(I const& other) const { return RAH_SELF_CONST.distance_to(other) <= 0; }
-	bool operator>(I const& other) const { return RAH_SELF_CONST.distance_to(other) > 0; }
-	bool operator>=(I const& other) const { return RAH_SELF_CONST.distance_to(other) >= 0; }
-	auto operator[](intptr_t increment) const { return *(RAH_SELF_CONST + increment); }
+	RAH_CONSTEXPR17 auto operator-(I const& other) const { return RAH_SELF_CONST.distance_to(other); }
+	RAH_CONSTEXPR17 bool operator<(I const& other) const { return RAH_SELF_CONST.distance_to(other) < 0; }
+	RAH_CONSTEXPR17 bool operator<=(I const& other) const { return RAH_SELF_CONST.distance_to(other) <= 0; }
+	RAH_CONSTEXPR17 bool operator>(I const& other) const { return RAH_SELF_CONST.distance_to(other) > 0; }
+	RAH_CONSTEXPR17 bool operator>=(I const& other) const { return RAH_SELF_CONST.distance_to(other) >= 0; }
+	RAH_CONSTEXPR17 auto operator[](intptr_t increment) const { return *(RAH_SELF_CONST + increment); }
 };
 
 #undef RAH_SELF 
@@ -466,6 +632,10 @@ struct iterator_facade<I, R, RAH_STD::random_access_iterator_tag> : iterator_fac
 
 // If rah is binded to an other standard library, learn to use std iterators anyway.
 
+template<typename I, typename R>
+struct iterator_facade<I, R, std::input_iterator_tag> :
+	iterator_facade<I, R, RAH_STD::input_iterator_tag> {};
+
 template<typename I, typename R>
 struct iterator_facade<I, R, std::forward_iterator_tag> :
 	iterator_facade<I, R, RAH_STD::forward_iterator_tag> {};
@@ -492,7 +662,7 @@ struct back_insert_iterator : iterator_facade<back_insert_iterator<C>, range_ref
 {
 	C* container_;
 	back_insert_iterator(C& container) : container_(&container) { }
-	template<typename V> void put(V&& value) const { container_->emplace_back(value); }
+	template<typename V> void put(V&& value) const { container_->emplace_back(RAH_STD::forward<V>(value)); }
 };
 
 /// @brief Make a range which insert into the back of the a container
@@ -514,10 +684,15 @@ struct insert_iterator : iterator_facade<insert_iterator<C>, range_ref_type_t<C>
 {
 	C* container_;
 	using Iterator = RAH_NAMESPACE::range_begin_type_t<C>;
-	Iterator iter_;
+	mutable Iterator iter_;
 	template<typename I>
 	insert_iterator(C& container, I&& iter) : container_(&container), iter_(RAH_STD::forward<I>(iter)){ }
-	template<typename V> void put(V&& value) const { container_->insert(iter_, value); }
+	/// Like RAH_STD::insert_iterator, the next value is inserted after the previous one
+	template<typename V> void put(V&& value) const
+	{
+		iter_ = container_->insert(iter_, RAH_STD::forward<V>(value));
+		++iter_;
+	}
 };
 
 /// @brief Make a range which insert into the back of the a container
@@ -531,99 +706,2085 @@ template<typename C, typename I> auto inserter(C&& container, I&& iter)
 	return RAH_NAMESPACE::make_iterator_range(begin, end);
 }
 
+// *********************************** stream_inserter ********************************************
 
-/// Apply the '<' operator on two values of any type
-struct is_lesser
+/// @see rah::stream_inserter
+template<typename S>
+struct stream_inserter_iterator : iterator_facade<stream_inserter_iterator<S>, typename S::char_type, RAH_STD::output_iterator_tag>
 {
-	template<typename A, typename B> bool operator()(A&& a, B&& b) { return a < b; }
+	S* stream_ = nullptr;
+	stream_inserter_iterator() = default;
+	stream_inserter_iterator(S& stream) : stream_(&stream) { }
+	template<typename V> void put(V&& value) const { (*stream_) << value; }
 };
 
-namespace view
+/// @brief Make a range which output to a stream
+/// @remark When a range of characters is copied into it (using rah::copy), the characters are written
+/// by blocks, using the write method of the stream. Contiguous characters are written in one call.
+///
+/// @snippet test.cpp rah::stream_inserter
+template<typename S> auto stream_inserter(S&& stream)
+{
+	using Stream = RAH_STD::remove_reference_t<S>;
+	auto begin = stream_inserter_iterator<Stream>(stream);
+	auto end = stream_inserter_iterator<Stream>(stream);
+	return RAH_NAMESPACE::make_iterator_range(begin, end);
+}
+
+/// \cond PRIVATE
+namespace details
 {
+/// Buffer the characters written into a stream, and write them by blocks
+template<typename S>
+struct stream_block_writer
+{
+	using char_type = typename S::char_type;
+	static constexpr size_t BlockSize = 4096;
+	S* stream_;
+	char_type block_[BlockSize];
+	size_t size_ = 0;
 
+	explicit stream_block_writer(S& stream) : stream_(&stream) {}
 
-// ********************************** all *********************************************************
+	void flush()
+	{
+		if (size_ != 0)
+			stream_->write(block_, size_);
+		size_ = 0;
+	}
+	void put(char_type c)
+	{
+		if (size_ == BlockSize)
+			flush();
+		block_[size_++] = c;
+	}
+	void append(char_type const* str, size_t length)
+	{
+		if (length > BlockSize - size_)
+		{
+			flush();
+			if (length > BlockSize)
+			{
+				stream_->write(str, length);
+				return;
+			}
+		}
+		RAH_STD::copy(str, str + length, block_ + size_);
+		size_ += length;
+	}
+	/// Get a space of at least @b length characters in the block
+	char_type* reserve(size_t length)
+	{
+		assert(length <= BlockSize);
+		if (length > BlockSize - size_)
+			flush();
+		return block_ + size_;
+	}
+	void commit(char_type* end) { size_ = end - block_; }
+};
+
+/// Maximum size of a number formatted by rah::formatted_stream_inserter
+static constexpr size_t MaxFormattedNumberSize = 64;
+
+template<typename T>
+char* format_integer(char* out, T value)
+{
+#if defined(__cpp_lib_to_chars)
+	return RAH_STD::to_chars(out, out + MaxFormattedNumberSize, value).ptr;
+#else
+	using Unsigned = RAH_STD::make_unsigned_t<T>;
+	Unsigned absValue = Unsigned(value);
+	if (value < T(0))
+	{
+		*out++ = '-';
+		absValue = Unsigned(Unsigned(0) - absValue);
+	}
+	char digits[RAH_STD::numeric_limits<Unsigned>::digits10 + 1];
+	char* first = digits + sizeof(digits);
+	do
+	{
+		*--first = char('0' + absValue % 10);
+		absValue /= 10;
+	} while (absValue != 0);
+	return RAH_STD::copy(first, digits + sizeof(digits), out);
+#endif
+}
 
-template<typename R> auto all(R&& range)
+/// Format the shortest representation which round-trip (or max_digits10 digits without <charconv>)
+template<typename T>
+char* format_floating_point(char* out, T value)
 {
-	static_assert(not RAH_STD::is_rvalue_reference_v<R&&>, "Can't call 'all' on a rvalue container");
-	return iterator_range<range_begin_type_t<R>>{rah_begin(range), rah_end(range)};
+#if defined(__cpp_lib_to_chars)
+	return RAH_STD::to_chars(out, out + MaxFormattedNumberSize, value).ptr;
+#else
+	int const length = snprintf(
+		out, MaxFormattedNumberSize, "%.*Lg", RAH_STD::numeric_limits<T>::max_digits10, (long double)value);
+	return out + length;
+#endif
 }
 
-template<typename I> auto all(std::initializer_list<I> range)
+struct format_char_tag {};
+struct format_bool_tag {};
+struct format_integer_tag {};
+struct format_floating_point_tag {};
+struct format_stream_tag {};
+
+/// How a value of type V is written by rah::formatted_stream_inserter
+template<typename V, typename C>
+using format_tag_t = RAH_STD::conditional_t<RAH_STD::is_same<V, C>::value, format_char_tag,
+	RAH_STD::conditional_t<RAH_STD::is_same<V, bool>::value, format_bool_tag,
+	RAH_STD::conditional_t<RAH_STD::is_integral<V>::value, format_integer_tag,
+	RAH_STD::conditional_t<RAH_STD::is_floating_point<V>::value, format_floating_point_tag,
+	format_stream_tag>>>>;
+
+template<typename S, typename V>
+void write_formatted(stream_block_writer<S>& writer, V const& value, format_char_tag) { writer.put(value); }
+
+template<typename S, typename V>
+void write_formatted(stream_block_writer<S>& writer, V const& value, format_bool_tag) { writer.put(value ? '1' : '0'); }
+
+template<typename S, typename V>
+void write_formatted(stream_block_writer<S>& writer, V const& value, format_integer_tag)
 {
-	return iterator_range<decltype(rah_begin(range))>{rah_begin(range), rah_end(range)};
+	writer.commit(format_integer(writer.reserve(MaxFormattedNumberSize), value));
 }
 
-template<typename I, std::size_t E> auto all(RAH_STD::span<I, E>&& range)
+template<typename S, typename V>
+void write_formatted(stream_block_writer<S>& writer, V const& value, format_floating_point_tag)
 {
-	return iterator_range<decltype(rah_begin(range))>{rah_begin(range), rah_end(range)};
+	writer.commit(format_floating_point(writer.reserve(MaxFormattedNumberSize), value));
 }
 
-template<typename I> auto all(iterator_range<I>&& range) -> decltype(std::move(range))
+/// Values which are not numbers are written using the operator <<
+template<typename S, typename V>
+void write_formatted(stream_block_writer<S>& writer, V const& value, format_stream_tag)
 {
-	return std::move(range);
+	writer.flush();
+	(*writer.stream_) << value;
 }
 
-template<typename I> iterator_range<I> const& all(iterator_range<I> const& range)
+/// Write a value then a separator
+template<typename S, typename V>
+void write_formatted(stream_block_writer<S>& writer, V const& value, char const* separator, size_t separatorSize)
 {
-	return range;
+	write_formatted(writer, value, format_tag_t<RAH_STD::decay_t<V>, typename S::char_type>());
+	writer.append(separator, separatorSize);
 }
+} // namespace details
+/// \endcond
+
+/// @see rah::formatted_stream_inserter
+template<typename S>
+struct formatted_stream_inserter_iterator : iterator_facade<formatted_stream_inserter_iterator<S>, char, RAH_STD::output_iterator_tag>
+{
+	static_assert(RAH_STD::is_same<typename S::char_type, char>::value, "formatted_stream_inserter need a char stream");
+	S* stream_ = nullptr;
+	char const* separator_ = "";
+	size_t separatorSize_ = 0;
+	formatted_stream_inserter_iterator() = default;
+	formatted_stream_inserter_iterator(S& stream, char const* separator)
+		: stream_(&stream)
+		, separator_(separator)
+		, separatorSize_(strlen(separator))
+	{
+	}
+	template<typename V> void put(V&& value) const
+	{
+		RAH_NAMESPACE::details::stream_block_writer<S> writer(*stream_);
+		RAH_NAMESPACE::details::write_formatted(writer, value, separator_, separatorSize_);
+		writer.flush();
+	}
+};
 
-inline auto all()
+/// @brief Make a range which output to a stream, formatting the numbers without the stream (and its locale)
+/// @remark Numbers are formatted with RAH_STD::to_chars when available (C++17), so floating point numbers use
+/// their shortest representation. Without <charconv>, they are formatted with max_digits10 digits.
+/// Characters are written as is, booleans as 0 or 1, and other values with the operator <<.
+/// @remark @b separator is written after each value
+/// @remark When a range is copied into it (using rah::copy), the values are formatted in a buffer, and
+/// written by blocks using the write method of the stream.
+///
+/// @snippet test.cpp rah::formatted_stream_inserter
+template<typename S> auto formatted_stream_inserter(S&& stream, char const* separator = "")
 {
-	return make_pipeable([=](auto&& range)
-		{
-			return all(RAH_STD::forward<decltype(range)>(range));
-		});
+	using Stream = RAH_STD::remove_reference_t<S>;
+	auto begin = formatted_stream_inserter_iterator<Stream>(stream, separator);
+	auto end = formatted_stream_inserter_iterator<Stream>(stream, separator);
+	return RAH_NAMESPACE::make_iterator_range(begin, end);
 }
 
-// ******************************************* take ***********************************************
+/// \cond PRIVATE
+namespace details
+{
+/// Ranges which doesn't own their elements, or not all of them.
+/// The views of rah which are not an iterator_range have a static is_view member.
+template<typename R, typename = int> struct is_view : RAH_STD::false_type {};
+template<typename R> struct is_view<R, decltype(R::is_view, 0)> : RAH_STD::true_type {};
+template<typename I, size_t E, bool X> struct is_view<iterator_range<I, E, X>> : RAH_STD::true_type {};
+template<typename T, std::size_t E> struct is_view<RAH_STD::span<T, E>> : RAH_STD::true_type {};
 
-template<typename I>
-struct take_iterator : iterator_facade<
-	take_iterator<I>,
-	decltype(*fake<I>()),
-	typename RAH_STD::iterator_traits<I>::iterator_category
->
+/// A rvalue container, which elements can be moved from.
+/// Views are never moved from, even when they own some of their ranges (like view::concat of a rvalue
+/// and a lvalue), except view::own, whose elements all belong to its container.
+template<typename R>
+struct is_movable_container : RAH_STD::integral_constant<bool,
+	not RAH_STD::is_reference<R>::value and not is_view<RAH_STD::remove_cv_t<R>>::value>
 {
-	I iter_;
-	size_t count_ = size_t();
+};
 
-	take_iterator() = default;
-	take_iterator(I iter, size_t count) : iter_(iter), count_(count) {}
+/// I is an iterator of the container C
+template<typename C, typename I>
+struct is_iterator_of : RAH_STD::integral_constant<bool,
+	RAH_STD::is_same<I, typename C::iterator>::value or RAH_STD::is_same<I, typename C::const_iterator>::value>
+{
+};
+
+/// The character types of basic_string
+template<typename T>
+struct is_char_type : RAH_STD::integral_constant<bool,
+	RAH_STD::is_same<T, char>::value
+#ifdef __cpp_char8_t
+	or RAH_STD::is_same<T, char8_t>::value
+#endif
+	or RAH_STD::is_same<T, wchar_t>::value
+	or RAH_STD::is_same<T, char16_t>::value
+	or RAH_STD::is_same<T, char32_t>::value>
+{
+};
 
-	void increment() { ++iter_; ++count_; }
-	void advance(intptr_t off) { iter_ += off; count_ += off; }
-	void decrement() { --iter_; --count_; }
-	auto distance_to(take_iterator const& r) const { return RAH_STD::min<intptr_t>(iter_ - r.iter_, count_ - r.count_); }
-	auto dereference() const -> decltype(*iter_) { return *iter_; }
-	bool equal(take_iterator const& r) const { return count_ == r.count_ || iter_ == r.iter_; }
+/// Iterators on elements stored contiguously in memory.
+/// The containers are only named for the T they accept, since some standard libraries reject the others.
+template<typename I, typename T = typename RAH_STD::iterator_traits<I>::value_type>
+struct is_contiguous_iterator : RAH_STD::integral_constant<bool,
+	RAH_STD::is_pointer<I>::value
+	or RAH_STD::conditional_t<RAH_STD::is_object<T>::value and not RAH_STD::is_same<T, bool>::value,
+		is_iterator_of<RAH_STD::vector<T>, I>, RAH_STD::false_type>::value
+	or RAH_STD::conditional_t<is_char_type<T>::value,
+		is_iterator_of<RAH_STD::basic_string<T>, I>, RAH_STD::false_type>::value>
+{
 };
 
-template<typename R> auto take(R&& range, size_t count)
+template<typename I> auto move_if(I iter, RAH_STD::true_type) { return RAH_STD::make_move_iterator(iter); }
+template<typename I> I move_if(I iter, RAH_STD::false_type) { return iter; }
+
+/// A rvalue C is moved
+template<typename C, typename R, typename... A>
+C take_container_impl(RAH_STD::true_type, R&& range, A const&... alloc)
 {
-	using iterator = take_iterator<range_begin_type_t<R>>;
-	auto view = all(RAH_STD::forward<R>(range));
-	iterator iter1(rah_begin(view), 0);
-	iterator iter2(rah_end(view), count);
-	return make_iterator_range(iter1, iter2);
+	return C(RAH_STD::move(range), typename C::allocator_type(alloc)...);
 }
 
-inline auto take(size_t count)
+/// The elements of a rvalue container are moved. Others are copied.
+template<typename C, typename R, typename... A>
+C take_container_impl(RAH_STD::false_type, R&& range, A const&... alloc)
 {
-	return make_pipeable([=](auto&& range)
-		{
-			return take(RAH_STD::forward<decltype(range)>(range), count);
-		});
+	auto const movable = is_movable_container<R>();
+	return C(move_if(rah_begin(range), movable), move_if(rah_end(range), movable), typename C::allocator_type(alloc)...);
 }
 
-// ******************************************* sliding ********************************************
+template<typename C> struct is_std_array : RAH_STD::false_type {};
+template<typename T, size_t N> struct is_std_array<RAH_STD::array<T, N>> : RAH_STD::true_type {};
 
-template<typename I>
-struct sliding_iterator : iterator_facade<
-	sliding_iterator<I>,
-	iterator_range<I>,
+/// The elements missing in a too small range are value initialized, and the extra ones are ignored
+template<typename C, typename I>
+C take_array(I iter, I last, RAH_STD::false_type, RAH_STD::index_sequence<>)
+{
+	C result{};
+	for (auto& elt : result)
+	{
+		assert(iter != last && "The range is smaller than the std::array");
+		if (iter == last)
+			return result;
+		elt = *iter;
+		++iter;
+	}
+	assert(iter == last && "The range is bigger than the std::array");
+	return result;
+}
+
+/// Small arrays are built in one expression, without loop and without default constructing the elements.
+/// The size test is removed by the compiler when it knows the size of the range.
+template<typename C, typename I, size_t... Is>
+C take_array(I iter, I last, RAH_STD::true_type, RAH_STD::index_sequence<Is...>)
+{
+	if (last - iter != intptr_t(sizeof...(Is)))
+		return take_array<C>(iter, last, RAH_STD::false_type(), RAH_STD::index_sequence<>());
+	return C{ { typename C::value_type(*(iter + intptr_t(Is)))... } };
+}
+
+/// Make a C with the elements of @b range, moving them when possible
+/// @param alloc Optional allocator of C (or anything convertible to it, like a memory resource)
+template<typename C, typename R, typename... A>
+auto take_container(R&& range, A const&... alloc) -> RAH_STD::enable_if_t<not is_std_array<C>::value, C>
+{
+	return take_container_impl<C>(RAH_STD::is_same<R, C>(), RAH_STD::forward<R>(range), alloc...);
+}
+
+/// std::array is not constructible from iterators. Its elements are copied (or moved) one by one.
+/// @pre @b range has exactly the size of the array (asserted in debug, see take_array)
+template<typename C, typename R>
+auto take_container(R&& range) -> RAH_STD::enable_if_t<is_std_array<C>::value, C>
+{
+	constexpr size_t N = RAH_STD::tuple_size<C>::value;
+	using Unrolled = RAH_STD::integral_constant<bool, N <= RAH_UNROLL_MAX_EXTENT
+		and RAH_STD::is_base_of<RAH_STD::random_access_iterator_tag, range_iter_categ_t<R>>::value>;
+	auto const movable = is_movable_container<R>();
+	return take_array<C>(move_if(rah_begin(range), movable), move_if(rah_end(range), movable),
+		Unrolled(), RAH_STD::make_index_sequence<Unrolled::value ? N : 0>());
+}
+
+/// Insert [first, last) before @b pos using the range insert of the container, when it exists.
+/// Standard containers allocate only once (and memmove trivially copyable values) when the
+/// size of the input is known.
+/// @return The position after the last inserted element
+template<typename C, typename P, typename I>
+auto bulk_insert(C& container, P pos, I first, I last, int)
+	-> RAH_STD::decay_t<decltype(container.insert(pos, first, last), pos)>
+{
+	auto const count = RAH_STD::distance(first, last);
+	auto inserted = container.insert(pos, first, last);
+	RAH_STD::advance(inserted, count);
+	return inserted;
+}
+
+/// Fallback for containers without range insert
+template<typename C, typename P, typename I>
+P bulk_insert(C& container, P pos, I first, I last, long)
+{
+	for (; first != last; ++first)
+	{
+		pos = container.insert(pos, *first);
+		++pos;
+	}
+	return pos;
+}
+
+/// Copy into any output iterator
+template<typename I, typename O>
+O copy_into(I first, I last, O out)
+{
+	return RAH_STD::copy(first, last, out);
+}
+
+template<typename I, typename O>
+O copy_sized_into(I first, I last, O out, RAH_STD::input_iterator_tag)
+{
+	return RAH_STD::copy(first, last, out);
+}
+
+/// Append a sized range in one call to insert
+template<typename I, typename C>
+back_insert_iterator<C> copy_sized_into(I first, I last, back_insert_iterator<C> out, RAH_STD::random_access_iterator_tag)
+{
+	C& container = *out.container_;
+	bulk_insert(container, container.end(), first, last, 0);
+	return out;
+}
+
+/// Insert a sized range in one call to insert
+template<typename I, typename C>
+insert_iterator<C> copy_sized_into(I first, I last, insert_iterator<C> out, RAH_STD::random_access_iterator_tag)
+{
+	out.iter_ = bulk_insert(*out.container_, out.iter_, first, last, 0);
+	return out;
+}
+
+template<typename I, typename C>
+back_insert_iterator<C> copy_into(I first, I last, back_insert_iterator<C> out)
+{
+	return copy_sized_into(first, last, out, typename RAH_STD::iterator_traits<I>::iterator_category());
+}
+
+template<typename I, typename C>
+insert_iterator<C> copy_into(I first, I last, insert_iterator<C> out)
+{
+	return copy_sized_into(first, last, out, typename RAH_STD::iterator_traits<I>::iterator_category());
+}
+
+/// Not characters are written using the operator <<
+template<typename I, typename S, typename IsContiguous>
+stream_inserter_iterator<S> copy_chars_into(I first, I last, stream_inserter_iterator<S> out, RAH_STD::false_type, IsContiguous)
+{
+	return RAH_STD::copy(first, last, out);
+}
+
+/// Contiguous characters are written in one call
+template<typename I, typename S>
+stream_inserter_iterator<S> copy_chars_into(I first, I last, stream_inserter_iterator<S> out, RAH_STD::true_type, RAH_STD::true_type)
+{
+	if (first != last)
+		out.stream_->write(&(*first), last - first);
+	return out;
+}
+
+/// Characters are written by blocks
+template<typename I, typename S>
+stream_inserter_iterator<S> copy_chars_into(I first, I last, stream_inserter_iterator<S> out, RAH_STD::true_type, RAH_STD::false_type)
+{
+	stream_block_writer<S> writer(*out.stream_);
+	for (; first != last; ++first)
+		writer.put(*first);
+	writer.flush();
+	return out;
+}
+
+template<typename I, typename S>
+stream_inserter_iterator<S> copy_into(I first, I last, stream_inserter_iterator<S> out)
+{
+	using value_type = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<decltype(*first)>>;
+	using IsChar = RAH_STD::is_same<value_type, typename S::char_type>;
+	return copy_chars_into(first, last, out, IsChar(), is_contiguous_iterator<I>());
+}
+
+/// Format all values in the same buffer
+template<typename I, typename S>
+formatted_stream_inserter_iterator<S> copy_into(I first, I last, formatted_stream_inserter_iterator<S> out)
+{
+	stream_block_writer<S> writer(*out.stream_);
+	for (; first != last; ++first)
+		write_formatted(writer, *first, out.separator_, out.separatorSize_);
+	writer.flush();
+	return out;
+}
+} // namespace details
+/// \endcond
+
+/// Apply the '<' operator on two values of any type
+struct is_lesser
+{
+	template<typename A, typename B> bool operator()(A&& a, B&& b) const { return a < b; }
+};
+
+/// Return its argument unchanged
+struct identity
+{
+	template<typename T> T&& operator()(T&& value) const { return RAH_STD::forward<T>(value); }
+};
+
+/// Return the smallest of two values (the first one if equivalent)
+struct minimum
+{
+	template<typename T> T const& operator()(T const& a, T const& b) const { return b < a ? b : a; }
+};
+
+/// Return the greatest of two values (the first one if equivalent)
+struct maximum
+{
+	template<typename T> T const& operator()(T const& a, T const& b) const { return a < b ? b : a; }
+};
+
+/// \cond PRIVATE
+namespace details
+{
+/// Apply a binary predicate on the projections of its arguments
+template<typename P, typename Proj>
+struct projected_pred
+{
+	P pred_;
+	Proj proj_;
+
+	template<typename A, typename B> bool operator()(A&& a, B&& b)
+	{
+		return pred_(proj_(RAH_STD::forward<A>(a)), proj_(RAH_STD::forward<B>(b)));
+	}
+};
+
+template<typename P, typename Proj> auto make_projected_pred(P&& pred, Proj&& proj)
+{
+	using Pred = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<P>>;
+	using Projection = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<Proj>>;
+	return projected_pred<Pred, Projection>{ pred, proj };
+}
+
+/// Sort [first, last) by the keys returned by @b key, computing each key only once.
+/// Equivalent keys keep their relative order.
+template<typename I, typename K, typename P>
+void sort_by_cached_key(I first, I last, K&& key, P&& pred)
+{
+	using Key = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<decltype(key(*first))>>;
+	using KeyIndex = RAH_STD::pair<Key, size_t>;
+	size_t const count = RAH_STD::distance(first, last);
+	RAH_STD::vector<KeyIndex> keys;
+	keys.reserve(count);
+	size_t index = 0;
+	for (I iter = first; iter != last; ++iter, ++index)
+		keys.emplace_back(key(*iter), index);
+	RAH_STD::sort(rah_begin(keys), rah_end(keys), [&pred](KeyIndex const& a, KeyIndex const& b)
+	{
+		if (pred(a.first, b.first))
+			return true;
+		if (pred(b.first, a.first))
+			return false;
+		return a.second < b.second;
+	});
+	// Apply the permutation in place, following each cycle. A done element has keys[i].second == i.
+	for (size_t i = 0; i != count; ++i)
+	{
+		if (keys[i].second == i)
+			continue;
+		auto tmp = RAH_STD::move(first[i]);
+		size_t dest = i;
+		while (true)
+		{
+			size_t const src = keys[dest].second;
+			keys[dest].second = dest;
+			if (src == i)
+			{
+				first[dest] = RAH_STD::move(tmp);
+				break;
+			}
+			first[dest] = RAH_STD::move(first[src]);
+			dest = src;
+		}
+	}
+}
+} // namespace details
+/// \endcond
+
+// ******************************** flat_hash_map *************************************************
+
+/// \cond PRIVATE
+namespace details
+{
+/// Get the key of a map element
+struct get_pair_first
+{
+	template<typename P> auto const& operator()(P const& pair) const { return pair.first; }
+};
+
+struct dereference_iterator
+{
+	template<typename I> auto operator()(I const& iter) const -> decltype(*iter) { return *iter; }
+};
+
+/// Open addressing hash table, with linear probing.
+/// Values are stored contiguously, in insertion order. The probed slots only store an index
+/// in the value array, and a part of the hash to avoid reading values on collisions.
+/// The values and the slots are allocated with @b Alloc rebound to their type.
+/// @remark The key part of @b Value has to be const (like in pair<K const, V>), so that it can't be changed
+/// through the iterators. Such a Value is not assignable, so the table is copied value by value.
+template<typename Value, typename KeyOf, typename Hash, typename Equal, typename Alloc = RAH_STD::allocator<Value>>
+class flat_hash_table
+{
+	using ValueAlloc = typename RAH_STD::allocator_traits<Alloc>::template rebind_alloc<Value>;
+
+public:
+	using value_type = Value;
+	using allocator_type = Alloc;
+	using iterator = typename RAH_STD::vector<Value, ValueAlloc>::iterator;
+	using const_iterator = typename RAH_STD::vector<Value, ValueAlloc>::const_iterator;
+
+	flat_hash_table() = default;
+	explicit flat_hash_table(
+		size_t count, KeyOf keyOf = {}, Hash hash = {}, Equal equal = {}, Alloc const& alloc = Alloc())
+		: values_(ValueAlloc(alloc))
+		, slots_(SlotAlloc(alloc))
+		, keyOf_(RAH_STD::move(keyOf))
+		, hash_(RAH_STD::move(hash))
+		, equal_(RAH_STD::move(equal))
+	{
+		reserve(count);
+	}
+
+	flat_hash_table(flat_hash_table const&) = default;
+	flat_hash_table(flat_hash_table&&) = default;
+	flat_hash_table& operator=(flat_hash_table&&) = default;
+
+	flat_hash_table& operator=(flat_hash_table const& other)
+	{
+		if (this != &other)
+		{
+			values_.clear();
+			values_.reserve(other.values_.size());
+			for (Value const& value : other.values_)
+				values_.emplace_back(value);
+			slots_ = other.slots_;
+			slotShift_ = other.slotShift_;
+			keyOf_ = other.keyOf_;
+			hash_ = other.hash_;
+			equal_ = other.equal_;
+		}
+		return *this;
+	}
+
+	Alloc get_allocator() const { return Alloc(values_.get_allocator()); }
+
+	iterator begin() { return values_.begin(); }
+	iterator end() { return values_.end(); }
+	const_iterator begin() const { return values_.begin(); }
+	const_iterator end() const { return values_.end(); }
+	size_t size() const { return values_.size(); }
+	bool empty() const { return values_.empty(); }
+
+	/// Allocate enough memory to insert @b count values without reallocation
+	void reserve(size_t count)
+	{
+		values_.reserve(count);
+		size_t slotCount = 8;
+		while (slotCount * MaxLoadNum < count * MaxLoadDen)
+			slotCount *= 2;
+		if (slotCount > slots_.size())
+			rehash(slotCount);
+	}
+
+	void clear()
+	{
+		values_.clear();
+		RAH_STD::fill(rah_begin(slots_), rah_end(slots_), Slot{ EmptySlot, 0 });
+	}
+
+	template<typename K> iterator find(K const& key)
+	{
+		if (slots_.empty())
+			return end();
+		size_t const hash = hash_(key);
+		for (size_t slotIdx = first_slot(hash);; slotIdx = (slotIdx + 1) & (slots_.size() - 1))
+		{
+			Slot const slot = slots_[slotIdx];
+			if (slot.index == EmptySlot)
+				return end();
+			if (slot.hash == uint32_t(hash) and equal_(keyOf_(values_[slot.index]), key))
+				return values_.begin() + slot.index;
+		}
+	}
+
+	template<typename K> const_iterator find(K const& key) const
+	{
+		return const_cast<flat_hash_table*>(this)->find(key);
+	}
+
+	/// Insert a value built with @b args, if there is no value with the given @b key
+	/// @return The iterator to the value with this key, and true if it was inserted
+	template<typename K, typename... Args>
+	RAH_STD::pair<iterator, bool> emplace_key(K const& key, Args&&... args)
+	{
+		if ((values_.size() + 1) * MaxLoadDen > slots_.size() * MaxLoadNum)
+			rehash(slots_.empty() ? 8 : slots_.size() * 2);
+		size_t const hash = hash_(key);
+		size_t slotIdx = first_slot(hash);
+		for (;; slotIdx = (slotIdx + 1) & (slots_.size() - 1))
+		{
+			Slot const slot = slots_[slotIdx];
+			if (slot.index == EmptySlot)
+				break;
+			if (slot.hash == uint32_t(hash) and equal_(keyOf_(values_[slot.index]), key))
+				return { values_.begin() + slot.index, false };
+		}
+		assert(values_.size() < EmptySlot);
+		slots_[slotIdx] = Slot{ uint32_t(values_.size()), uint32_t(hash) };
+		values_.emplace_back(RAH_STD::forward<Args>(args)...);
+		return { values_.end() - 1, true };
+	}
+
+private:
+	static constexpr uint32_t EmptySlot = uint32_t(-1);
+	// Max load factor is MaxLoadNum / MaxLoadDen
+	static constexpr size_t MaxLoadNum = 3;
+	static constexpr size_t MaxLoadDen = 4;
+
+	struct Slot
+	{
+		uint32_t index; ///< Index in values_, or EmptySlot
+		uint32_t hash;  ///< Low bits of the hash
+	};
+	using SlotAlloc = typename RAH_STD::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+
+	size_t first_slot(size_t hash) const
+	{
+		// Fibonacci hashing, so that poor hash functions (like identity) still spread well
+		return size_t((uint64_t(hash) * 0x9E3779B97F4A7C15ull) >> slotShift_);
+	}
+
+	void rehash(size_t slotCount)
+	{
+		slots_.assign(slotCount, Slot{ EmptySlot, 0 });
+		slotShift_ = 64;
+		for (size_t count = slotCount; count > 1; count /= 2)
+			--slotShift_;
+		for (uint32_t index = 0; index != values_.size(); ++index)
+		{
+			size_t const hash = hash_(keyOf_(values_[index]));
+			size_t slotIdx = first_slot(hash);
+			while (slots_[slotIdx].index != EmptySlot)
+				slotIdx = (slotIdx + 1) & (slots_.size() - 1);
+			slots_[slotIdx] = Slot{ index, uint32_t(hash) };
+		}
+	}
+
+	RAH_STD::vector<Value, ValueAlloc> values_;
+	RAH_STD::vector<Slot, SlotAlloc> slots_;
+	unsigned slotShift_ = 64;
+	KeyOf keyOf_;
+	Hash hash_;
+	Equal equal_;
+};
+} // namespace details
+/// \endcond
+
+/// @brief Hash map with open addressing, storing its elements contiguously, in insertion order.
+/// Elements can't be erased.
+/// @remark Iterating yields RAH_STD::pair<K const, V>, so that the keys can't be changed
+template<
+	typename K,
+	typename V,
+	typename Hash = RAH_STD::hash<K>,
+	typename Equal = RAH_STD::equal_to<K>,
+	typename Alloc = RAH_STD::allocator<RAH_STD::pair<K const, V>>>
+class flat_hash_map
+	: public details::flat_hash_table<RAH_STD::pair<K const, V>, details::get_pair_first, Hash, Equal, Alloc>
+{
+	using Base = details::flat_hash_table<RAH_STD::pair<K const, V>, details::get_pair_first, Hash, Equal, Alloc>;
+public:
+	using key_type = K;
+	using mapped_type = V;
+
+	flat_hash_map() = default;
+	explicit flat_hash_map(size_t count, Hash hash = {}, Equal equal = {}, Alloc const& alloc = Alloc())
+		: Base(count, {}, RAH_STD::move(hash), RAH_STD::move(equal), alloc)
+	{
+	}
+
+	/// Insert a value built with @b args, if the @b key is not already in the map
+	template<typename... Args>
+	auto try_emplace(K const& key, Args&&... args)
+	{
+		return this->emplace_key(
+			key,
+			RAH_STD::piecewise_construct,
+			RAH_STD::forward_as_tuple(key),
+			RAH_STD::forward_as_tuple(RAH_STD::forward<Args>(args)...));
+	}
+
+	V& operator[](K const& key) { return try_emplace(key).first->second; }
+};
+
+/// @brief Hash set with open addressing, storing its elements contiguously, in insertion order.
+/// Elements can't be erased.
+/// @remark Like in RAH_STD::unordered_set, the iterators are all const
+template<
+	typename K,
+	typename Hash = RAH_STD::hash<K>,
+	typename Equal = RAH_STD::equal_to<K>,
+	typename Alloc = RAH_STD::allocator<K>>
+class flat_hash_set : public details::flat_hash_table<K, identity, Hash, Equal, Alloc>
+{
+	using Base = details::flat_hash_table<K, identity, Hash, Equal, Alloc>;
+public:
+	using key_type = K;
+	using iterator = typename Base::const_iterator;
+
+	flat_hash_set() = default;
+	explicit flat_hash_set(size_t count, Hash hash = {}, Equal equal = {}, Alloc const& alloc = Alloc())
+		: Base(count, {}, RAH_STD::move(hash), RAH_STD::move(equal), alloc)
+	{
+	}
+
+	iterator begin() const { return Base::begin(); }
+	iterator end() const { return Base::end(); }
+
+	template<typename V> iterator find(V const& key) const { return Base::find(key); }
+
+	/// Insert @b value if it is not already in the set
+	/// @return The iterator to the value in the set, and true if it was inserted
+	template<typename V>
+	RAH_STD::pair<iterator, bool> insert(V&& value)
+	{
+		auto const iterInserted = this->emplace_key(value, RAH_STD::forward<V>(value));
+		return { iterInserted.first, iterInserted.second };
+	}
+private:
+	// It gives a mutable iterator
+	using Base::emplace_key;
+};
+
+// ********************************** arena *******************************************************
+
+/// @brief Monotonic (bump) allocator. Allocations are done in big blocks, and are never freed
+/// individually. All the memory is made available again by a call to reset.
+/// @remark After a reset, only the largest block is kept. So a loop doing the same allocations at each
+/// iteration (a request handler for example) stops allocating from the heap after a few iterations.
+/// @remark When <memory_resource> is available, arena is a RAH_STD::pmr::memory_resource
+/// @remark Not thread safe
+///
+/// @snippet test.cpp rah::arena
+class arena final
+#ifdef RAH_HAS_MEMORY_RESOURCE
+	: public RAH_STD::pmr::memory_resource
+#endif
+{
+public:
+	static constexpr size_t DefaultAlignment = alignof(RAH_STD::max_align_t);
+
+	/// @param blockSize Size of the first block
+	explicit arena(size_t blockSize = 4096) : nextBlockSize_(blockSize) {}
+	arena(arena const&) = delete;
+	arena& operator=(arena const&) = delete;
+	~arena() { release(); }
+
+#ifndef RAH_HAS_MEMORY_RESOURCE
+	void* allocate(size_t bytes, size_t alignment = DefaultAlignment) { return bump(bytes, alignment); }
+	void deallocate(void*, size_t, size_t = DefaultAlignment) {}
+#endif
+
+	/// Make all the allocated memory available again, keeping only the largest block
+	void reset()
+	{
+		if (blocks_ == nullptr)
+			return;
+		// The last allocated block is the largest
+		free_blocks(blocks_->next);
+		blocks_->next = nullptr;
+		cursor_ = reinterpret_cast<char*>(blocks_ + 1);
+	}
+
+	/// Free all the blocks
+	void release()
+	{
+		free_blocks(blocks_);
+		blocks_ = nullptr;
+		cursor_ = nullptr;
+		end_ = nullptr;
+	}
+
+	/// Total size of the blocks
+	size_t capacity() const
+	{
+		size_t total = 0;
+		for (Block* block = blocks_; block != nullptr; block = block->next)
+			total += block->size;
+		return total;
+	}
+
+	/// Allocate @b bytes aligned on @b alignment. Unlike allocate, it is never a virtual call.
+	void* bump(size_t bytes, size_t alignment)
+	{
+		if (bytes == 0)
+			bytes = 1;
+		if (bytes > RAH_STD::numeric_limits<size_t>::max() - alignment - sizeof(Block))
+			throw std::bad_alloc();
+		uintptr_t address = align_up(uintptr_t(cursor_), alignment);
+		if (cursor_ == nullptr or address + bytes > uintptr_t(end_))
+		{
+			add_block(bytes + alignment);
+			address = align_up(uintptr_t(cursor_), alignment);
+		}
+		cursor_ = reinterpret_cast<char*>(address + bytes);
+		return reinterpret_cast<void*>(address);
+	}
+
+private:
+	struct alignas(RAH_STD::max_align_t) Block
+	{
+		Block* next;
+		size_t size; ///< Size of the block, including this header
+	};
+
+	Block* blocks_ = nullptr; ///< The last allocated block first
+	char* cursor_ = nullptr;
+	char* end_ = nullptr;
+	size_t nextBlockSize_;
+
+	static uintptr_t align_up(uintptr_t address, size_t alignment)
+	{
+		return (address + (alignment - 1)) & ~uintptr_t(alignment - 1);
+	}
+
+	/// Add a block, with a geometric growth
+	void add_block(size_t minSize)
+	{
+		size_t const size = RAH_STD::max(nextBlockSize_, minSize + sizeof(Block));
+		nextBlockSize_ = size * 2;
+		Block* block = static_cast<Block*>(::operator new(size));
+		block->next = blocks_;
+		block->size = size;
+		blocks_ = block;
+		cursor_ = reinterpret_cast<char*>(block + 1);
+		end_ = reinterpret_cast<char*>(block) + size;
+	}
+
+	static void free_blocks(Block* block)
+	{
+		while (block != nullptr)
+		{
+			Block* next = block->next;
+			::operator delete(block);
+			block = next;
+		}
+	}
+
+#ifdef RAH_HAS_MEMORY_RESOURCE
+	void* do_allocate(size_t bytes, size_t alignment) override { return bump(bytes, alignment); }
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(RAH_STD::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+#endif
+};
+
+/// @brief Standard allocator allocating in a rah::arena
+/// @remark Unlike RAH_STD::pmr::polymorphic_allocator, the calls to the arena are not virtual (see arena::bump)
+///
+/// @snippet test.cpp rah::arena_allocator
+template<typename T>
+struct arena_allocator
+{
+	using value_type = T;
+	arena* arena_;
+
+	/// Implicit, so that a pointer to an arena can be given where an allocator is expected
+	arena_allocator(arena* arena) : arena_(arena) {}
+	template<typename U> arena_allocator(arena_allocator<U> const& other) : arena_(other.arena_) {}
+
+	T* allocate(size_t count)
+	{
+		if (count > RAH_STD::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_array_new_length();
+		return static_cast<T*>(arena_->bump(count * sizeof(T), alignof(T)));
+	}
+	void deallocate(T*, size_t) {}
+
+	template<typename U> bool operator==(arena_allocator<U> const& other) const { return arena_ == other.arena_; }
+	template<typename U> bool operator!=(arena_allocator<U> const& other) const { return arena_ != other.arena_; }
+};
+
+/// \cond PRIVATE
+namespace details
+{
+/// The allocator of T to use when @b A is given as allocator to a materializing view
+template<typename A, typename T, typename = void>
+struct allocator_for
+{
+	using type = typename RAH_STD::allocator_traits<A>::template rebind_alloc<T>;
+};
+
+template<typename T>
+struct allocator_for<void, T>
+{
+	using type = RAH_STD::allocator<T>;
+};
+
+/// A pointer to an arena give an arena_allocator
+template<typename A, typename T>
+struct allocator_for<A, T, RAH_STD::enable_if_t<RAH_STD::is_convertible<A, arena*>::value>>
+{
+	using type = arena_allocator<T>;
+};
+
+#ifdef RAH_HAS_MEMORY_RESOURCE
+/// A pointer to an other memory_resource give a polymorphic_allocator
+template<typename A, typename T>
+struct allocator_for<A, T, RAH_STD::enable_if_t<
+	RAH_STD::is_convertible<A, RAH_STD::pmr::memory_resource*>::value
+	and not RAH_STD::is_convertible<A, arena*>::value>>
+{
+	using type = RAH_STD::pmr::polymorphic_allocator<T>;
+};
+#endif
+
+template<typename A, typename T>
+using allocator_for_t = typename allocator_for<A, T>::type;
+
+/// @b A can be given as allocator: a pointer to an arena or to a memory_resource, or an allocator
+template<typename A, typename = int>
+struct is_allocator_arg : RAH_STD::integral_constant<bool,
+	RAH_STD::is_convertible<A, arena*>::value
+#ifdef RAH_HAS_MEMORY_RESOURCE
+	or RAH_STD::is_convertible<A, RAH_STD::pmr::memory_resource*>::value
+#endif
+	>
+{
+};
+
+template<typename A>
+struct is_allocator_arg<A, decltype(fake<A&>().allocate(size_t(1)), 0)> : RAH_STD::true_type {};
+} // namespace details
+/// \endcond
+
+// ********************************** static_vector ***********************************************
+
+/// @brief Vector with a fixed capacity @b N, storing its elements inline. Never allocate.
+/// @remark Inserting in a full static_vector is undefined behavior (asserted in debug)
+/// @remark Can be used as target of rah::to_container and rah::back_inserter. to_container check at
+/// compile time that the capacity is enough, when the size of the range is statically known.
+///
+/// @snippet test.cpp rah::static_vector
+template<typename T, size_t N>
+class static_vector
+{
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = intptr_t;
+	using reference = T&;
+	using const_reference = T const&;
+	using pointer = T*;
+	using const_pointer = T const*;
+	using iterator = T*;
+	using const_iterator = T const*;
+
+	static constexpr size_t static_capacity = N;
+
+	static_vector() = default;
+	static_vector(size_t count, T const& value)
+	{
+		while (count-- != 0)
+			emplace_back(value);
+	}
+	template<typename I, typename = RAH_STD::enable_if_t<not RAH_STD::is_integral<I>::value>>
+	static_vector(I first, I last)
+	{
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+	static_vector(std::initializer_list<T> list) : static_vector(list.begin(), list.end()) {}
+	static_vector(static_vector const& other) : static_vector(other.begin(), other.end()) {}
+	static_vector(static_vector&& other)
+	{
+		for (T& value : other)
+			emplace_back(RAH_STD::move(value));
+		other.clear();
+	}
+	~static_vector() { clear(); }
+
+	static_vector& operator=(static_vector const& other)
+	{
+		if (this != &other)
+			assign(other.begin(), other.end());
+		return *this;
+	}
+	static_vector& operator=(static_vector&& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			for (T& value : other)
+				emplace_back(RAH_STD::move(value));
+			other.clear();
+		}
+		return *this;
+	}
+
+	template<typename I>
+	void assign(I first, I last)
+	{
+		clear();
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+
+	iterator begin() { return data(); }
+	iterator end() { return data() + size_; }
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + size_; }
+	T* data() { return reinterpret_cast<T*>(storage_); }
+	T const* data() const { return reinterpret_cast<T const*>(storage_); }
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	bool full() const { return size_ == N; }
+	static constexpr size_t capacity() { return N; }
+	static constexpr size_t max_size() { return N; }
+
+	T& operator[](size_t index) { assert(index < size_); return data()[index]; }
+	T const& operator[](size_t index) const { assert(index < size_); return data()[index]; }
+	T& front() { assert(size_ != 0); return data()[0]; }
+	T const& front() const { assert(size_ != 0); return data()[0]; }
+	T& back() { assert(size_ != 0); return data()[size_ - 1]; }
+	T const& back() const { assert(size_ != 0); return data()[size_ - 1]; }
+
+	template<typename... A>
+	T& emplace_back(A&&... args)
+	{
+		assert(size_ < N && "static_vector overflow");
+		T* value = new(data() + size_) T(RAH_STD::forward<A>(args)...);
+		++size_;
+		return *value;
+	}
+	void push_back(T const& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(RAH_STD::move(value)); }
+	void pop_back() { assert(size_ != 0); --size_; data()[size_].~T(); }
+
+	template<typename... A>
+	iterator emplace(const_iterator pos, A&&... args)
+	{
+		size_t const index = size_t(pos - data());
+		emplace_back(RAH_STD::forward<A>(args)...);
+		RAH_STD::rotate(begin() + index, end() - 1, end());
+		return begin() + index;
+	}
+	iterator insert(const_iterator pos, T const& value) { return emplace(pos, value); }
+	iterator insert(const_iterator pos, T&& value) { return emplace(pos, RAH_STD::move(value)); }
+	/// Insert [first, last) before @b pos
+	/// @return An iterator to the first inserted element
+	template<typename I, typename = RAH_STD::enable_if_t<not RAH_STD::is_integral<I>::value>>
+	iterator insert(const_iterator pos, I first, I last)
+	{
+		size_t const index = size_t(pos - data());
+		size_t const oldSize = size_;
+		for (; first != last; ++first)
+			emplace_back(*first);
+		RAH_STD::rotate(begin() + index, begin() + oldSize, end());
+		return begin() + index;
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		iterator const out = begin() + (first - data());
+		iterator const newEnd = RAH_STD::move(out + (last - first), end(), out);
+		while (end() != newEnd)
+			pop_back();
+		return out;
+	}
+	iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+	void clear()
+	{
+		while (size_ != 0)
+			pop_back();
+	}
+
+	bool operator==(static_vector const& other) const
+	{
+		return size_ == other.size_ and RAH_STD::equal(begin(), end(), other.begin());
+	}
+	bool operator!=(static_vector const& other) const { return not (*this == other); }
+
+private:
+	alignas(T) unsigned char storage_[sizeof(T) * (N == 0 ? 1 : N)];
+	size_t size_ = 0;
+};
+
+/// @brief Upper bound of the size of a range type, when it is known at compile time, else DynamicExtent.
+/// Known for arrays, spans, static_vector and view::take<N>, and kept by view::transform, zip, take, stride,
+/// chunk, reverse and enumerate.
+/// @see rah::static_size for the exact size
+template<typename R>
+struct static_max_size : RAH_STD::integral_constant<size_t, DynamicExtent> {};
+
+template<typename T, size_t N> struct static_max_size<T[N]> : RAH_STD::integral_constant<size_t, N> {};
+template<typename T, size_t N> struct static_max_size<RAH_STD::array<T, N>> : RAH_STD::integral_constant<size_t, N> {};
+template<typename T, size_t E> struct static_max_size<RAH_STD::span<T, E>> : RAH_STD::integral_constant<size_t, E> {};
+template<typename T, size_t N> struct static_max_size<static_vector<T, N>> : RAH_STD::integral_constant<size_t, N> {};
+
+/// @brief Size of a range type, when it is known at compile time, else DynamicExtent.
+/// Known for arrays and spans, and kept by the views which don't remove elements: view::transform, zip, reverse,
+/// enumerate and take<N>. Unlike rah::static_max_size, it is not known after view::take, stride or chunk.
+///
+/// @snippet test.cpp rah::static_size
+template<typename R>
+struct static_size : RAH_STD::integral_constant<size_t, DynamicExtent> {};
+
+template<typename T, size_t N> struct static_size<T[N]> : RAH_STD::integral_constant<size_t, N> {};
+template<typename T, size_t N> struct static_size<RAH_STD::array<T, N>> : RAH_STD::integral_constant<size_t, N> {};
+template<typename T, size_t E> struct static_size<RAH_STD::span<T, E>> : RAH_STD::integral_constant<size_t, E> {};
+
+/// \cond PRIVATE
+namespace details
+{
+/// Iterators can give a bound to the size of their range with a static max_count member
+template<typename I, typename = int>
+struct iterator_max_count : RAH_STD::integral_constant<size_t, DynamicExtent> {};
+
+template<typename I>
+struct iterator_max_count<I, decltype(I::max_count, 0)> : RAH_STD::integral_constant<size_t, I::max_count> {};
+
+/// Capacity of a container type, when it is fixed, else DynamicExtent
+template<typename C>
+struct static_capacity : RAH_STD::integral_constant<size_t, DynamicExtent> {};
+
+template<typename T, size_t N>
+struct static_capacity<static_vector<T, N>> : RAH_STD::integral_constant<size_t, N> {};
+
+template<typename T, size_t N>
+struct static_capacity<RAH_STD::array<T, N>> : RAH_STD::integral_constant<size_t, N> {};
+
+template<typename C, typename R>
+void check_static_capacity()
+{
+	using Range = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<R>>;
+	static_assert(static_max_size<Range>::value == DynamicExtent
+		or static_max_size<Range>::value <= static_capacity<C>::value,
+		"The range is too big for the capacity of the container");
+}
+} // namespace details
+/// \endcond
+
+template<typename I, size_t E, bool X> struct static_max_size<iterator_range<I, E, X>> : RAH_STD::integral_constant<size_t,
+	(E < details::iterator_max_count<I>::value ? E : details::iterator_max_count<I>::value)> {};
+
+template<typename I, size_t E> struct static_size<iterator_range<I, E, true>> : static_max_size<iterator_range<I, E, true>> {};
+
+/// \cond PRIVATE
+namespace details
+{
+/// The smallest of the extents. A DynamicExtent doesn't bound the others.
+constexpr size_t min_extent(size_t extent) { return extent; }
+
+template<typename... E>
+constexpr size_t min_extent(size_t extent1, size_t extent2, E... extents)
+{
+	return min_extent(extent1 < extent2 ? extent1 : extent2, extents...);
+}
+
+/// All the extents are known
+constexpr bool all_static(size_t extent) { return extent != DynamicExtent; }
+
+template<typename... E>
+constexpr bool all_static(size_t extent1, size_t extent2, E... extents)
+{
+	return extent1 != DynamicExtent and all_static(extent2, extents...);
+}
+
+/// Range of the iterators @b I, having the extent of the range type @b R.
+/// Used by the views which keep the count of elements.
+template<typename I, typename R>
+using extent_range = iterator_range<I, static_max_size<R>::value, static_size<R>::value != DynamicExtent>;
+} // namespace details
+/// \endcond
+
+// ********************************** view_stats **************************************************
+
+/// @brief Count of a view_stats. Can be incremented by several threads, since the stats
+/// of the built-in views are shared by all the threads.
+/// @remark The increments are relaxed: the count is exact, but not ordered with other memory accesses.
+struct stat_counter
+{
+	RAH_STD::atomic<size_t> value_{ 0 };
+
+	stat_counter() = default;
+	stat_counter(size_t value) : value_(value) {}
+	stat_counter(stat_counter const& other) : value_(size_t(other)) {}
+	stat_counter& operator=(stat_counter const& other)
+	{
+		value_.store(size_t(other), RAH_STD::memory_order_relaxed);
+		return *this;
+	}
+
+	stat_counter& operator++()
+	{
+		value_.fetch_add(1, RAH_STD::memory_order_relaxed);
+		return *this;
+	}
+	operator size_t() const { return value_.load(RAH_STD::memory_order_relaxed); }
+};
+
+/// @brief Counts of the operations done on the iterators of a view. Filled by rah::view::counted_stats.
+/// @remark The counts can be incremented by several threads (see rah::stat_counter). reset is not thread safe.
+///
+/// @snippet test.cpp rah::view::counted_stats
+struct view_stats
+{
+	char const* name = ""; ///< Name of the instrumented view
+	stat_counter increments;
+	stat_counter decrements;
+	stat_counter advances; ///< Random access jumps (operator+=)
+	stat_counter dereferences; ///< Elements read
+	stat_counter comparisons; ///< Comparisons of iterators, mainly to the end
+	stat_counter calls; ///< Calls to the functions wrapped by rah::counted_calls
+
+	view_stats() = default;
+	explicit view_stats(char const* viewName) : name(viewName) {}
+
+	/// Set all counts to zero
+	void reset()
+	{
+		view_stats const empty(name);
+		*this = empty;
+	}
+};
+
+/// @see rah::counted_calls
+template<typename F>
+struct counted_calls_function
+{
+	mutable F func_;
+	view_stats* stats_;
+
+	template<typename... A>
+	decltype(auto) operator()(A&&... args) const
+	{
+		++stats_->calls;
+		return func_(RAH_STD::forward<A>(args)...);
+	}
+};
+
+/// @brief Wrap @b func to count its calls in @b stats.calls. Used to count the calls to the predicates
+/// of the views and algorithms.
+///
+/// @snippet test.cpp rah::counted_calls
+template<typename F>
+auto counted_calls(F&& func, view_stats& stats)
+{
+	using Functor = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	return counted_calls_function<Functor>{ RAH_STD::forward<F>(func), &stats };
+}
+
+#ifdef RAH_INSTRUMENT
+/// \cond PRIVATE
+namespace details
+{
+/// view_stats of a built-in view, linked in the list of the instrumented views
+struct registered_view_stats : view_stats
+{
+	registered_view_stats* next;
+
+	explicit registered_view_stats(char const* viewName) : view_stats(viewName), next(head().load())
+	{
+		while (not head().compare_exchange_weak(next, this))
+		{
+		}
+	}
+
+	static RAH_STD::atomic<registered_view_stats*>& head()
+	{
+		static RAH_STD::atomic<registered_view_stats*> first{ nullptr };
+		return first;
+	}
+};
+} // namespace details
+/// \endcond
+
+/// @see rah::instrumented_views
+struct instrumented_view_iterator
+	: iterator_facade<instrumented_view_iterator, view_stats&, RAH_STD::forward_iterator_tag>
+{
+	details::registered_view_stats* stats_ = nullptr;
+
+	instrumented_view_iterator() = default;
+	instrumented_view_iterator(details::registered_view_stats* stats) : stats_(stats) {}
+
+	void increment() { stats_ = stats_->next; }
+	view_stats& dereference() const { return *stats_; }
+	bool equal(instrumented_view_iterator const& other) const { return stats_ == other.stats_; }
+};
+
+/// @brief The stats of the built-in views used so far. Only when RAH_INSTRUMENT is defined.
+/// @remark There is one view_stats by view and template instantiation
+///
+/// @snippet test.cpp rah::instrumented_views
+inline auto instrumented_views()
+{
+	using iterator = instrumented_view_iterator;
+	return iterator_range<iterator>{ iterator(details::registered_view_stats::head().load()), iterator() };
+}
+
+/// When RAH_INSTRUMENT is defined, the built-in views are wrapped in a view::counted_stats
+#define RAH_INSTRUMENT_VIEW(NAME, ...) \
+	::RAH_NAMESPACE::view::counted_stats(__VA_ARGS__, []() -> ::RAH_NAMESPACE::view_stats& \
+	{ \
+		static ::RAH_NAMESPACE::details::registered_view_stats stats(NAME); \
+		return stats; \
+	}())
+#else
+#define RAH_INSTRUMENT_VIEW(NAME, ...) __VA_ARGS__
+#endif
+
+// ********************************** stage_timing ************************************************
+
+/// @brief Clock of the stage timings.
+/// The time stamp counter (cycles) when RAH_TIMING_RDTSC is defined on x86, else steady_clock (nanoseconds).
+struct timing_clock
+{
+	static uint64_t now()
+	{
+#ifdef RAH_TIMING_HAS_RDTSC
+		return __rdtsc();
+#else
+		auto const sinceEpoch = RAH_STD::chrono::steady_clock::now().time_since_epoch();
+		return uint64_t(RAH_STD::chrono::duration_cast<RAH_STD::chrono::nanoseconds>(sinceEpoch).count());
+#endif
+	}
+
+	/// Unit of the durations
+	static char const* unit()
+	{
+#ifdef RAH_TIMING_HAS_RDTSC
+		return "cycles";
+#else
+		return "ns";
+#endif
+	}
+};
+
+/// @brief Histogram of durations, in buckets of powers of two.
+/// @remark Lock-free: can be filled by many threads at once
+///
+/// @snippet test.cpp rah::latency_histogram
+class latency_histogram
+{
+public:
+	/// The bucket i hold the durations in [2^(i-1), 2^i)
+	static constexpr size_t BucketCount = 65;
+
+	latency_histogram() { reset(); }
+	latency_histogram(latency_histogram const&) = delete;
+	latency_histogram& operator=(latency_histogram const&) = delete;
+
+	/// Add a duration, in ticks of rah::timing_clock
+	void add(uint64_t duration)
+	{
+		buckets_[bucket_index(duration)].fetch_add(1, RAH_STD::memory_order_relaxed);
+		total_.fetch_add(duration, RAH_STD::memory_order_relaxed);
+	}
+
+	/// Number of durations added
+	uint64_t count() const
+	{
+		uint64_t result = 0;
+		for (auto const& bucket : buckets_)
+			result += bucket.load(RAH_STD::memory_order_relaxed);
+		return result;
+	}
+
+	/// Sum of the durations added
+	uint64_t total() const { return total_.load(RAH_STD::memory_order_relaxed); }
+
+	/// @brief Duration under which are the @b ratio of the durations. (0.5 for the median, 0.99 for the p99)
+	/// @remark Precise to a factor of two: this is the upper bound of a bucket
+	uint64_t percentile(double ratio) const
+	{
+		uint64_t const target = uint64_t(RAH_STD::ceil(ratio * double(count())));
+		uint64_t cumulated = 0;
+		for (size_t index = 0; index != BucketCount; ++index)
+		{
+			cumulated += buckets_[index].load(RAH_STD::memory_order_relaxed);
+			if (cumulated != 0 and cumulated >= target)
+				return index == BucketCount - 1 ? RAH_STD::numeric_limits<uint64_t>::max() : (uint64_t(1) << index) - 1;
+		}
+		return 0;
+	}
+
+	void reset()
+	{
+		for (auto& bucket : buckets_)
+			bucket.store(0, RAH_STD::memory_order_relaxed);
+		total_.store(0, RAH_STD::memory_order_relaxed);
+	}
+
+private:
+	static size_t bucket_index(uint64_t duration)
+	{
+		size_t index = 0;
+		for (; duration != 0; duration >>= 1)
+			++index;
+		return index;
+	}
+
+	RAH_STD::atomic<uint64_t> buckets_[BucketCount];
+	RAH_STD::atomic<uint64_t> total_;
+};
+
+/// @brief Measure the duration of a scope, and add it in a latency_histogram at destruction
+class timing_scope
+{
+public:
+	timing_scope() = default;
+	explicit timing_scope(latency_histogram* histogram) : histogram_(histogram), start_(timing_clock::now()) {}
+	timing_scope(timing_scope&& other) : histogram_(other.histogram_), start_(other.start_)
+	{
+		other.histogram_ = nullptr;
+	}
+	timing_scope& operator=(timing_scope&&) = delete;
+	~timing_scope()
+	{
+		if (histogram_ != nullptr)
+			histogram_->add(timing_clock::now() - start_);
+	}
+
+private:
+	latency_histogram* histogram_ = nullptr;
+	uint64_t start_ = 0;
+};
+
+/// @brief Summary of a stage_timing. Durations are in ticks of rah::timing_clock.
+struct timing_report
+{
+	char const* name;
+	uint64_t calls; ///< Number of calls, measured or not
+	uint64_t samples; ///< Number of measured calls
+	uint64_t p50; ///< Median duration (upper bound, precise to a factor of two)
+	uint64_t p99; ///< 99th percentile duration (upper bound, precise to a factor of two)
+	uint64_t total; ///< Estimated duration of all the calls: measured duration x sampling period
+};
+
+/// @brief Durations of a stage of a pipeline. Filled by rah::view::timed and rah::timed_calls.
+/// @remark Only one call out of @b samplingPeriod is measured, to keep the overhead low.
+/// @remark Lock-free: a stage can be timed by many threads at once
+///
+/// @snippet test.cpp rah::timed_calls
+class stage_timing
+{
+public:
+	explicit stage_timing(char const* name, uint32_t samplingPeriod = 1)
+		: name_(name)
+		, period_(samplingPeriod == 0 ? 1 : samplingPeriod)
+		, calls_(0)
+		, nextSample_(0)
+	{
+	}
+
+	char const* name() const { return name_; }
+	uint32_t sampling_period() const { return period_; }
+	uint64_t calls() const { return calls_.load(RAH_STD::memory_order_relaxed); }
+	latency_histogram const& histogram() const { return histogram_; }
+
+	/// Start a measure if this call is sampled. The duration is recorded when the timing_scope is destroyed.
+	/// @remark The calls are counted without a locked instruction, to be cheap. So some calls can be missed
+	/// when many threads use the same stage_timing.
+	timing_scope measure()
+	{
+		uint64_t const call = calls_.load(RAH_STD::memory_order_relaxed);
+		calls_.store(call + 1, RAH_STD::memory_order_relaxed);
+		if (call < nextSample_.load(RAH_STD::memory_order_relaxed))
+			return timing_scope();
+		nextSample_.store(call + period_, RAH_STD::memory_order_relaxed);
+		return timing_scope(&histogram_);
+	}
+
+	timing_report report() const
+	{
+		return { name_, calls(), histogram_.count(), histogram_.percentile(0.5), histogram_.percentile(0.99),
+			histogram_.total() * period_ };
+	}
+
+	void reset()
+	{
+		calls_.store(0, RAH_STD::memory_order_relaxed);
+		nextSample_.store(0, RAH_STD::memory_order_relaxed);
+		histogram_.reset();
+	}
+
+private:
+	char const* name_;
+	uint32_t period_;
+	RAH_STD::atomic<uint64_t> calls_;
+	RAH_STD::atomic<uint64_t> nextSample_; ///< Index of the next measured call
+	latency_histogram histogram_;
+};
+
+/// @see rah::timed_calls
+template<typename F>
+struct timed_calls_function
+{
+	mutable F func_;
+	stage_timing* timing_;
+
+	template<typename... A>
+	decltype(auto) operator()(A&&... args) const
+	{
+		timing_scope const scope = timing_->measure();
+		return func_(RAH_STD::forward<A>(args)...);
+	}
+};
+
+/// @brief Wrap @b func to measure its calls in @b timing. Used to time the functions given to
+/// view::transform, or the predicates given to view::filter.
+///
+/// @snippet test.cpp rah::timed_calls
+template<typename F>
+auto timed_calls(F&& func, stage_timing& timing)
+{
+	using Functor = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	return timed_calls_function<Functor>{ RAH_STD::forward<F>(func), &timing };
+}
+
+namespace view
+{
+
+
+// ********************************** own *********************************************************
+
+/// @see rah::view::own
+template<typename C>
+struct own_view
+{
+	mutable C container_;
+
+	RAH_CONSTEXPR17 auto begin() const { return rah_begin(container_); }
+	RAH_CONSTEXPR17 auto end() const { return rah_end(container_); }
+};
+
+} // namespace view
+
+template<typename C> struct static_max_size<view::own_view<C>> : static_max_size<C> {};
+template<typename C> struct static_size<view::own_view<C>> : static_size<C> {};
+
+namespace view
+{
+
+/// @brief Move a rvalue container into a view, which keep it alive.
+/// @return A view on the container, which can be returned from a function or used in a pipeline.
+/// @remark The container is moved (never copied) into the view, and destroyed with it.
+/// The iterators are the ones of the container, and are invalidated when the view is moved or destroyed.
+/// @remark view::all, and so every view adaptor, call own on rvalue containers
+///
+/// @snippet test.cpp rah::view::own
+template<typename C, typename = RAH_STD::enable_if_t<not RAH_STD::is_reference<C>::value>>
+RAH_CONSTEXPR17 auto own(C&& container)
+{
+	return own_view<C>{ RAH_STD::move(container) };
+}
+
+/// @see rah::view::own(C&& container)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::own_pipeable
+inline auto own()
+{
+	return make_pipeable([=](auto&& container)
+		{
+			return own(RAH_STD::forward<decltype(container)>(container));
+		});
+}
+
+// ********************************** all *********************************************************
+
+template<typename R, RAH_STD::enable_if_t<RAH_STD::is_lvalue_reference<R>::value, int> = 0>
+RAH_CONSTEXPR17 auto all(R&& range)
+{
+	using Range = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<R>>;
+	return details::extent_range<range_begin_type_t<R>, Range>{rah_begin(range), rah_end(range)};
+}
+
+/// A rvalue container is moved into the view, using view::own
+template<typename R, RAH_STD::enable_if_t<not RAH_STD::is_reference<R>::value, int> = 0>
+RAH_CONSTEXPR17 auto all(R&& range)
+{
+	return own(RAH_STD::move(range));
+}
+
+template<typename I> RAH_CONSTEXPR17 auto all(std::initializer_list<I> range)
+{
+	return iterator_range<decltype(rah_begin(range))>{rah_begin(range), rah_end(range)};
+}
+
+template<typename I, std::size_t E> RAH_CONSTEXPR17 auto all(RAH_STD::span<I, E>&& range)
+{
+	return iterator_range<decltype(rah_begin(range)), E, E != DynamicExtent>{rah_begin(range), rah_end(range)};
+}
+
+template<typename I, size_t E, bool X> RAH_CONSTEXPR17 auto all(iterator_range<I, E, X>&& range) -> decltype(RAH_STD::move(range))
+{
+	return RAH_STD::move(range);
+}
+
+template<typename I, size_t E, bool X> RAH_CONSTEXPR17 iterator_range<I, E, X> const& all(iterator_range<I, E, X> const& range)
+{
+	return range;
+}
+
+inline RAH_CONSTEXPR17 auto all()
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return all(RAH_STD::forward<decltype(range)>(range));
+		});
+}
+
+// ********************************** owning_view *************************************************
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename V> struct is_owning_view : RAH_STD::false_type {};
+template<typename C> struct is_owning_view<own_view<C>> : RAH_STD::true_type {};
+
+template<typename... V> struct any_owning_view : RAH_STD::false_type {};
+
+template<typename V, typename... Vs>
+struct any_owning_view<V, Vs...> : RAH_STD::integral_constant<bool,
+	is_owning_view<RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<V>>>::value or any_owning_view<Vs...>::value>
+{
+};
+
+template<typename F, typename Bases, size_t... I>
+RAH_CONSTEXPR17 auto make_owned_view(F& makeView, Bases& bases, RAH_STD::index_sequence<I...>)
+{
+	return makeView(all(RAH_STD::get<I>(bases))...);
+}
+} // namespace details
+/// \endcond
+
+/// @brief A view made by an adaptor on rvalue containers. The containers are stored by value
+/// in the view, and the adaptor view is made on them, so its iterators stay plain iterators.
+/// @remark Copying or moving the view make the adaptor view again, on the new containers.
+template<typename F, typename... V>
+struct owning_view
+{
+	static constexpr bool is_view = true; ///< See details::is_movable_container
+	using index_sequence = RAH_STD::index_sequence_for<V...>;
+	using view_type = decltype(details::make_owned_view(
+		fake<F&>(), fake<RAH_STD::tuple<V...>&>(), index_sequence()));
+
+	RAH_STD::tuple<V...> bases_;
+	F makeView_;
+	view_type view_;
+
+	RAH_CONSTEXPR17 owning_view(F makeView, V... bases)
+		: bases_(RAH_STD::move(bases)...)
+		, makeView_(RAH_STD::move(makeView))
+		, view_(details::make_owned_view(makeView_, bases_, index_sequence()))
+	{
+	}
+	RAH_CONSTEXPR17 owning_view(owning_view const& other)
+		: bases_(other.bases_)
+		, makeView_(other.makeView_)
+		, view_(details::make_owned_view(makeView_, bases_, index_sequence()))
+	{
+	}
+	RAH_CONSTEXPR17 owning_view(owning_view&& other)
+		: bases_(RAH_STD::move(other.bases_))
+		, makeView_(RAH_STD::move(other.makeView_))
+		, view_(details::make_owned_view(makeView_, bases_, index_sequence()))
+	{
+	}
+	owning_view& operator=(owning_view const&) = delete;
+	owning_view& operator=(owning_view&&) = delete;
+
+	RAH_CONSTEXPR17 auto begin() const { return rah_begin(view_); }
+	RAH_CONSTEXPR17 auto end() const { return rah_end(view_); }
+};
+
+} // namespace view
+
+template<typename F, typename... V> struct static_max_size<view::owning_view<F, V...>>
+	: static_max_size<typename view::owning_view<F, V...>::view_type> {};
+template<typename F, typename... V> struct static_size<view::owning_view<F, V...>>
+	: static_size<typename view::owning_view<F, V...>::view_type> {};
+
+namespace view
+{
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename F, typename... V>
+RAH_CONSTEXPR17 auto adapt_views(RAH_STD::false_type, F&& makeView, V&&... views)
+{
+	return makeView(RAH_STD::forward<V>(views)...);
+}
+
+template<typename F, typename... V>
+RAH_CONSTEXPR17 auto adapt_views(RAH_STD::true_type, F&& makeView, V&&... views)
+{
+	using Maker = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	return owning_view<Maker, RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<V>>...>(
+		RAH_STD::forward<F>(makeView), RAH_STD::forward<V>(views)...);
+}
+
+/// Call @b makeView on a view of each range. When a range is a rvalue container, it is stored
+/// in an owning_view with @b makeView, else the view is returned as is.
+template<typename F, typename... R>
+RAH_CONSTEXPR17 auto adapt_all(F&& makeView, R&&... ranges)
+{
+	using owning = any_owning_view<decltype(all(RAH_STD::forward<R>(ranges)))...>;
+	return adapt_views(owning(), RAH_STD::forward<F>(makeView), all(RAH_STD::forward<R>(ranges))...);
+}
+
+template<typename V> struct is_iterator_range : RAH_STD::false_type {};
+template<typename I, size_t E, bool X> struct is_iterator_range<iterator_range<I, E, X>> : RAH_STD::true_type {};
+
+/// A rvalue owning_view making an iterator_range can give its containers to the next adaptor
+template<typename V> struct is_composable_view : RAH_STD::false_type {};
+template<typename G, typename... V> struct is_composable_view<owning_view<G, V...>>
+	: is_iterator_range<typename owning_view<G, V...>::view_type> {};
+
+template<typename F, typename... V, size_t... I>
+RAH_CONSTEXPR17 auto make_owning_view(F makeView, RAH_STD::tuple<V...>&& bases, RAH_STD::index_sequence<I...>)
+{
+	return owning_view<F, V...>(RAH_STD::move(makeView), RAH_STD::get<I>(RAH_STD::move(bases))...);
+}
+
+template<typename R, typename F>
+RAH_CONSTEXPR17 auto adapt(R&& range, F&& makeView, RAH_STD::false_type)
+{
+	return adapt_all(RAH_STD::forward<F>(makeView), RAH_STD::forward<R>(range));
+}
+
+/// The containers are moved in a single owning_view, which make the views of both adaptors
+template<typename G, typename... V, typename F>
+RAH_CONSTEXPR17 auto adapt(owning_view<G, V...>&& range, F&& makeView, RAH_STD::true_type)
+{
+	using Maker = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	auto compose = [inner = RAH_STD::move(range.makeView_), outer = Maker(RAH_STD::forward<F>(makeView))](auto... views)
+	{
+		return outer(inner(views...));
+	};
+	return make_owning_view(RAH_STD::move(compose), RAH_STD::move(range.bases_), RAH_STD::index_sequence_for<V...>());
+}
+
+/// @see adapt_all
+/// @remark Chaining adaptors on a rvalue container doesn't nest the owning views
+template<typename R, typename F>
+RAH_CONSTEXPR17 auto adapt(R&& range, F&& makeView)
+{
+	return adapt(RAH_STD::forward<R>(range), RAH_STD::forward<F>(makeView), is_composable_view<R>());
+}
+} // namespace details
+/// \endcond
+
+// ********************************** counted_stats ***********************************************
+
+/// @see rah::view::counted_stats
+template<typename I>
+struct stats_iterator : iterator_facade<
+	stats_iterator<I>,
+	decltype(*fake<I>()),
+	typename RAH_STD::iterator_traits<I>::iterator_category
+>
+{
+	static constexpr size_t max_count = RAH_NAMESPACE::details::iterator_max_count<I>::value;
+	I iter_;
+	view_stats* stats_ = nullptr;
+
+	stats_iterator() = default;
+	stats_iterator(I iter, view_stats* stats) : iter_(iter), stats_(stats) {}
+
+	void increment() { ++stats_->increments; ++iter_; }
+	void advance(intptr_t off) { ++stats_->advances; iter_ += off; }
+	void decrement() { ++stats_->decrements; --iter_; }
+	auto distance_to(stats_iterator const& r) const { return iter_ - r.iter_; }
+	auto dereference() const -> decltype(*iter_) { ++stats_->dereferences; return *iter_; }
+	bool equal(stats_iterator const& r) const { ++stats_->comparisons; return iter_ == r.iter_; }
+};
+
+/// @brief Count the increments, dereferences and comparisons done on the iterators of @b range, in @b stats.
+/// Can be inserted anywhere in a pipeline, to see what each stage does.
+/// @remark When RAH_INSTRUMENT is defined, the built-in views are wrapped in a counted_stats
+/// (see rah::instrumented_views). Not the views restarting in begin(), like sliding_reduce or distinct.
+///
+/// @snippet test.cpp rah::view::counted_stats
+template<typename R> auto counted_stats(R&& range, view_stats& stats)
+{
+	return details::adapt(RAH_STD::forward<R>(range), [statsPtr = &stats](auto view)
+		{
+			using iterator = stats_iterator<range_begin_type_t<decltype(view)>>;
+			using range = RAH_NAMESPACE::details::extent_range<iterator, decltype(view)>;
+			return range{ iterator(rah_begin(view), statsPtr), iterator(rah_end(view), statsPtr) };
+		});
+}
+
+/// @brief Count the increments, dereferences and comparisons done on the iterators of @b range, in @b stats.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::counted_stats_pipeable
+inline auto counted_stats(view_stats& stats)
+{
+	return make_pipeable([statsPtr = &stats](auto&& range)
+		{
+			return counted_stats(RAH_STD::forward<decltype(range)>(range), *statsPtr);
+		});
+}
+
+// ********************************** timed *******************************************************
+
+/// @see rah::view::timed
+template<typename I>
+struct timed_iterator : iterator_facade<
+	timed_iterator<I>,
+	decltype(*fake<I>()),
+	typename RAH_STD::iterator_traits<I>::iterator_category
+>
+{
+	static constexpr size_t max_count = RAH_NAMESPACE::details::iterator_max_count<I>::value;
+	I iter_;
+	stage_timing* timing_ = nullptr;
+
+	timed_iterator() = default;
+	timed_iterator(I iter, stage_timing* timing) : iter_(iter), timing_(timing) {}
+
+	void increment() { timing_scope const scope = timing_->measure(); ++iter_; }
+	void advance(intptr_t off) { timing_scope const scope = timing_->measure(); iter_ += off; }
+	void decrement() { timing_scope const scope = timing_->measure(); --iter_; }
+	auto distance_to(timed_iterator const& r) const { return iter_ - r.iter_; }
+	auto dereference() const -> decltype(*iter_) { timing_scope const scope = timing_->measure(); return *iter_; }
+	bool equal(timed_iterator const& r) const { return iter_ == r.iter_; }
+};
+
+/// @brief Measure the increments and dereferences of the iterators of @b range, in @b timing.
+/// In a pipeline, this is the time spent in the upstream views (like the functions of transform and the
+/// predicates of filter).
+/// @remark Only one operation out of stage_timing::sampling_period() is measured
+///
+/// @snippet test.cpp rah::view::timed
+template<typename R> auto timed(R&& range, stage_timing& timing)
+{
+	return details::adapt(RAH_STD::forward<R>(range), [timingPtr = &timing](auto view)
+		{
+			using iterator = timed_iterator<range_begin_type_t<decltype(view)>>;
+			using range = RAH_NAMESPACE::details::extent_range<iterator, decltype(view)>;
+			return range{ iterator(rah_begin(view), timingPtr), iterator(rah_end(view), timingPtr) };
+		});
+}
+
+/// @brief Measure the increments and dereferences of the iterators of the range, in @b timing.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::timed_pipeable
+inline auto timed(stage_timing& timing)
+{
+	return make_pipeable([timingPtr = &timing](auto&& range)
+		{
+			return timed(RAH_STD::forward<decltype(range)>(range), *timingPtr);
+		});
+}
+
+// ********************************** tap *********************************************************
+
+/// @see rah::view::tap
+template<typename R, typename F>
+struct tap_iterator : iterator_facade<tap_iterator<R, F>, range_ref_type_t<R>, range_iter_categ_t<R>>
+{
+	range_begin_type_t<R> iter_;
+	RAH_NAMESPACE::details::optional<F> func_;
+
+	tap_iterator() = default;
+	RAH_CONSTEXPR17 tap_iterator(range_begin_type_t<R> const& iter, F const& func) : iter_(iter), func_(func) {}
+
+	RAH_CONSTEXPR17 void increment() { ++iter_; }
+	RAH_CONSTEXPR17 void advance(intptr_t off) { iter_ += off; }
+	RAH_CONSTEXPR17 void decrement() { --iter_; }
+	RAH_CONSTEXPR17 auto distance_to(tap_iterator const& r) const { return iter_ - r.iter_; }
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*iter_)
+	{
+		auto&& value = *iter_;
+		(*func_)(value);
+		return RAH_STD::forward<decltype(value)>(value);
+	}
+	RAH_CONSTEXPR17 bool equal(tap_iterator const& r) const { return iter_ == r.iter_; }
+};
+
+/// @brief Call @b func on each element of @b range read through the view, and yield the element unchanged.
+/// Used to log or inspect the elements at any stage of a pipeline.
+/// @remark @b func is called at each dereference. Some views (like filter) read the elements twice.
+///
+/// @snippet test.cpp rah::view::tap
+template<typename R, typename F> RAH_CONSTEXPR17 auto tap(R&& range, F&& func)
+{
+	using Functor = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	return details::adapt(RAH_STD::forward<R>(range), [func = Functor(RAH_STD::forward<F>(func))](auto view)
+		{
+			using iterator = tap_iterator<decltype(view), Functor>;
+			using range = RAH_NAMESPACE::details::extent_range<iterator, decltype(view)>;
+			return range{ { rah_begin(view), func }, { rah_end(view), func } };
+		});
+}
+
+/// @brief Call @b func on each element read through the view, and yield the element unchanged.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::tap_pipeable
+template<typename F> RAH_CONSTEXPR17 auto tap(F&& func)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return tap(RAH_STD::forward<decltype(range)>(range), func);
+		});
+}
+
+// ******************************************* take ***********************************************
+
+/// @tparam MaxCount Count of elements to take, when it is known at compile time
+template<typename I, size_t MaxCount = DynamicExtent>
+struct take_iterator : iterator_facade<
+	take_iterator<I, MaxCount>,
+	decltype(*fake<I>()),
+	typename RAH_STD::iterator_traits<I>::iterator_category
+>
+{
+	static constexpr size_t max_count = MaxCount;
+	I iter_;
+	size_t count_ = size_t();
+
+	take_iterator() = default;
+	RAH_CONSTEXPR17 take_iterator(I iter, size_t count) : iter_(iter), count_(count) {}
+
+	RAH_CONSTEXPR17 void increment() { ++iter_; ++count_; }
+	RAH_CONSTEXPR17 void advance(intptr_t off) { iter_ += off; count_ += off; }
+	RAH_CONSTEXPR17 void decrement() { --iter_; --count_; }
+	RAH_CONSTEXPR17 auto distance_to(take_iterator const& r) const { return RAH_STD::min<intptr_t>(iter_ - r.iter_, count_ - r.count_); }
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*iter_) { return *iter_; }
+	RAH_CONSTEXPR17 bool equal(take_iterator const& r) const { return count_ == r.count_ || iter_ == r.iter_; }
+};
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename R> RAH_CONSTEXPR17 auto take(R&& range, size_t count, RAH_STD::input_iterator_tag)
+{
+	return adapt(RAH_STD::forward<R>(range), [count](auto view)
+		{
+			using iterator = take_iterator<range_begin_type_t<decltype(view)>, static_max_size<decltype(view)>::value>;
+			iterator iter1(rah_begin(view), 0);
+			iterator iter2(rah_end(view), count);
+			return make_iterator_range(iter1, iter2);
+		});
+}
+
+/// The end is known in constant time, so the sub-range is a range of the same iterators.
+/// The loops on it have only one end test.
+template<typename R> RAH_CONSTEXPR17 auto take(R&& range, size_t count, RAH_STD::random_access_iterator_tag)
+{
+	return adapt(RAH_STD::forward<R>(range), [count](auto view)
+		{
+			auto iter1 = rah_begin(view);
+			auto const size = size_t(rah_end(view) - iter1);
+			auto iter2 = iter1 + intptr_t(RAH_STD::min(count, size));
+			return make_iterator_range<static_max_size<decltype(view)>::value>(iter1, iter2);
+		});
+}
+} // namespace details
+/// \endcond
+
+template<typename R> RAH_CONSTEXPR17 auto take(R&& range, size_t count)
+{
+	return RAH_INSTRUMENT_VIEW("take", details::take(RAH_STD::forward<R>(range), count, range_iter_categ_t<R>()));
+}
+
+inline RAH_CONSTEXPR17 auto take(size_t count)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return take(RAH_STD::forward<decltype(range)>(range), count);
+		});
+}
+
+/// @brief Take the @b N first elements of @b range. The count being known at compile time,
+/// a static_vector target of to_container can be checked to be big enough.
+///
+/// @snippet test.cpp rah::view::take_static
+template<size_t N, typename R> RAH_CONSTEXPR17 auto take(R&& range)
+{
+	using Range = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<R>>;
+	constexpr size_t InputMax = static_max_size<Range>::value;
+	constexpr size_t MaxCount = N < InputMax ? N : InputMax;
+	// When the size of range is known, the size of the view is exactly MaxCount
+	constexpr bool Exact = static_size<Range>::value != DynamicExtent;
+	return RAH_INSTRUMENT_VIEW("take", details::adapt(RAH_STD::forward<R>(range), [](auto view)
+		{
+			using iterator = take_iterator<range_begin_type_t<decltype(view)>, MaxCount>;
+			iterator iter1(rah_begin(view), 0);
+			iterator iter2(rah_end(view), N);
+			return make_iterator_range<MaxCount, Exact>(iter1, iter2);
+		}));
+}
+
+/// @brief Take the @b N first elements of @b range. The count being known at compile time,
+/// a static_vector target of to_container can be checked to be big enough.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::take_static_pipeable
+template<size_t N> RAH_CONSTEXPR17 auto take()
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return take<N>(RAH_STD::forward<decltype(range)>(range));
+		});
+}
+
+// ******************************************* sliding ********************************************
+
+template<typename I>
+struct sliding_iterator : iterator_facade<
+	sliding_iterator<I>,
+	iterator_range<I>,
 	typename RAH_STD::iterator_traits<I>::iterator_category
 >
 {
@@ -633,49 +2794,207 @@ struct sliding_iterator : iterator_facade<
 	I subRangeLast_;
 
 	sliding_iterator() = default;
-	sliding_iterator(I subRangeBegin, I subRangeLast)
+	RAH_CONSTEXPR17 sliding_iterator(I subRangeBegin, I subRangeLast)
 		: subRangeBegin_(subRangeBegin)
 		, subRangeLast_(subRangeLast)
 	{
 	}
 
-	void increment() { ++subRangeBegin_; ++subRangeLast_; }
-	void advance(intptr_t off) { subRangeBegin_ += off; subRangeLast_ += off; }
-	void decrement() { --subRangeBegin_; --subRangeLast_; }
-	auto distance_to(sliding_iterator const& r) const { return subRangeBegin_ - r.subRangeBegin_; }
-	auto dereference() const
+	RAH_CONSTEXPR17 void increment() { ++subRangeBegin_; ++subRangeLast_; }
+	RAH_CONSTEXPR17 void advance(intptr_t off) { subRangeBegin_ += off; subRangeLast_ += off; }
+	RAH_CONSTEXPR17 void decrement() { --subRangeBegin_; --subRangeLast_; }
+	RAH_CONSTEXPR17 auto distance_to(sliding_iterator const& r) const { return subRangeBegin_ - r.subRangeBegin_; }
+	RAH_CONSTEXPR17 auto dereference() const
 	{
 		I endIter = subRangeLast_;
 		++endIter;
 		return make_iterator_range(subRangeBegin_, endIter);
 	}
-	bool equal(sliding_iterator const& r) const { return subRangeBegin_ == r.subRangeBegin_; }
+	RAH_CONSTEXPR17 bool equal(sliding_iterator const& r) const { return subRangeBegin_ == r.subRangeBegin_; }
 };
 
-template<typename R> auto sliding(R&& range, size_t n)
+/// @see rah::view::sliding_buffered
+template<typename V>
+struct sliding_buffered_iterator : iterator_facade<
+	sliding_buffered_iterator<V>,
+	iterator_range<typename V::value_type const*>,
+	RAH_STD::input_iterator_tag
+>
 {
-	size_t const closedSubRangeSize = n - 1;
-	auto view = all(RAH_STD::forward<R>(range));
-	auto const rangeEnd = rah_end(view);
-	using iterator = sliding_iterator<range_begin_type_t<R>>;
-	auto subRangeBegin = rah_begin(view);
-	auto subRangeLast = subRangeBegin;
-	for (size_t i = 0; i != closedSubRangeSize; ++i)
+	using base_iterator = range_begin_type_t<typename V::base_view>;
+	V const* view_ = nullptr;
+	base_iterator iter_; ///< Next value to enter the window
+	size_t readCount_ = 0;
+	bool atEnd_ = true;
+
+	sliding_buffered_iterator() = default;
+	sliding_buffered_iterator(V const* view, base_iterator iter) : view_(view), iter_(iter), atEnd_(false)
 	{
-		if (subRangeLast == rangeEnd)
-			return make_iterator_range(iterator(rangeEnd, rangeEnd), iterator(rangeEnd, rangeEnd));
-		++subRangeLast;
+		size_t const n = view_->windowSize_;
+		auto const endIter = rah_end(view_->base_);
+		auto& buffer = view_->buffer_;
+		buffer.clear();
+		for (; readCount_ != n; ++readCount_, ++iter_)
+		{
+			if (iter_ == endIter)
+			{
+				atEnd_ = true;
+				return;
+			}
+			buffer.push_back(*iter_);
+		}
+		// Each value is stored twice, so that every window is contiguous
+		for (size_t i = 0; i != n; ++i)
+			buffer.push_back(buffer[i]);
+		atEnd_ = (n == 0);
+	}
+
+	void increment()
+	{
+		if (iter_ == rah_end(view_->base_))
+			atEnd_ = true;
+		else
+		{
+			size_t const n = view_->windowSize_;
+			size_t const slot = readCount_ % n;
+			view_->buffer_[slot] = *iter_;
+			view_->buffer_[slot + n] = view_->buffer_[slot];
+			++readCount_;
+			++iter_;
+		}
+	}
+	auto dereference() const
+	{
+		size_t const n = view_->windowSize_;
+		typename V::value_type const* windowBegin = view_->buffer_.data() + (readCount_ % n);
+		return make_iterator_range(windowBegin, windowBegin + n);
 	}
+	bool equal(sliding_buffered_iterator const& other) const
+	{
+		return atEnd_ == other.atEnd_ and (atEnd_ or iter_ == other.iter_);
+	}
+};
+
+/// @see rah::view::sliding_buffered
+template<typename R, typename A = RAH_STD::allocator<RAH_STD::remove_cv_t<range_value_type_t<R>>>>
+struct sliding_buffered_view
+{
+	static constexpr bool is_view = true; ///< See details::is_movable_container
+	using base_view = R;
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using iterator = sliding_buffered_iterator<sliding_buffered_view>;
+
+	R base_;
+	size_t windowSize_;
+	/// Ring buffer of the window. The ith value is stored at (i % n) and (i % n) + n
+	mutable RAH_STD::vector<value_type, A> buffer_;
+
+	sliding_buffered_view(R base, size_t n, A const& alloc = A())
+		: base_(RAH_STD::move(base))
+		, windowSize_(n)
+		, buffer_(alloc)
+	{
+		buffer_.reserve(n * 2);
+	}
+
+	/// Start a new iteration, clearing the window
+	iterator begin() const { return { this, rah_begin(base_) }; }
+	iterator end() const { return {}; }
+};
+
+/// @brief Create a view of all contiguous sub-ranges of size @b n, copying the last @b n
+/// elements into a ring buffer.
+/// @return A range of contiguous sub-ranges (iterator_range<value_type const*>) of size @b n
+/// @remark Each element of the input range is read only once, so it can be a single-pass range,
+/// and the upstream work is not done again for each window.
+/// @remark The buffer is stored in the view, which is single-pass (input iterators) and must outlive its iterators.
+/// A window is invalidated when the iterator is incremented, and by any call to begin().
+///
+/// @snippet test.cpp rah::view::sliding_buffered
+template<typename R> auto sliding_buffered(R&& range, size_t n)
+{
+	auto view = all(RAH_STD::forward<R>(range));
+	return sliding_buffered_view<decltype(view)>(RAH_STD::move(view), n);
+}
+
+/// @brief Create a view of all contiguous sub-ranges of size @b n, with a ring buffer allocated using @b alloc
+/// @param alloc An allocator, a pointer to a rah::arena, or a pointer to a RAH_STD::pmr::memory_resource.
+///
+/// @snippet test.cpp rah::view::sliding_buffered_alloc
+template<typename R, typename A, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto sliding_buffered(R&& range, size_t n, A const& alloc)
+{
+	auto view = all(RAH_STD::forward<R>(range));
+	using Alloc = RAH_NAMESPACE::details::allocator_for_t<A, RAH_STD::remove_cv_t<range_value_type_t<R>>>;
+	return sliding_buffered_view<decltype(view), Alloc>(RAH_STD::move(view), n, Alloc(alloc));
+}
+
+/// @see rah::view::sliding_buffered(R&& range, size_t n)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::sliding_buffered_pipeable
+inline auto sliding_buffered(size_t n)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return sliding_buffered(RAH_STD::forward<decltype(range)>(range), n);
+		});
+}
+
+/// @see rah::view::sliding_buffered(R&& range, size_t n, A const& alloc)
+/// @remark pipeable syntax
+template<typename A, typename = RAH_STD::enable_if_t<RAH_NAMESPACE::details::is_allocator_arg<A>::value>>
+auto sliding_buffered(size_t n, A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return sliding_buffered(RAH_STD::forward<decltype(range)>(range), n, alloc);
+		});
+}
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename R> RAH_CONSTEXPR17 auto sliding(R&& range, size_t n, RAH_STD::bidirectional_iterator_tag)
+{
+	return adapt(RAH_STD::forward<R>(range), [n](auto view)
+		{
+			size_t const closedSubRangeSize = n - 1;
+			auto const rangeEnd = rah_end(view);
+			using iterator = sliding_iterator<range_begin_type_t<decltype(view)>>;
+			auto subRangeBegin = rah_begin(view);
+			auto subRangeLast = subRangeBegin;
+			for (size_t i = 0; i != closedSubRangeSize; ++i)
+			{
+				if (subRangeLast == rangeEnd)
+					return make_iterator_range(iterator(rangeEnd, rangeEnd), iterator(rangeEnd, rangeEnd));
+				++subRangeLast;
+			}
+
+			auto endSubRangeBegin = rangeEnd;
+			RAH_STD::advance(endSubRangeBegin, -intptr_t(n - 1));
+
+			iterator iter1(subRangeBegin, subRangeLast);
+			iterator iter2(endSubRangeBegin, rangeEnd);
+			return make_iterator_range(iter1, iter2);
+		});
+}
 
-	auto endSubRangeBegin = rangeEnd;
-	RAH_STD::advance(endSubRangeBegin, -intptr_t(n - 1));
+/// Forward and input ranges can't give the end of the last window, so their windows are copied in a buffer.
+/// The result is single-pass.
+template<typename R> RAH_CONSTEXPR17 auto sliding(R&& range, size_t n, RAH_STD::input_iterator_tag)
+{
+	return sliding_buffered(RAH_STD::forward<R>(range), n);
+}
+} // namespace details
+/// \endcond
 
-	iterator iter1(subRangeBegin, subRangeLast);
-	iterator iter2(endSubRangeBegin, rangeEnd);
-	return make_iterator_range(iter1, iter2);
+template<typename R> RAH_CONSTEXPR17 auto sliding(R&& range, size_t n)
+{
+	return RAH_INSTRUMENT_VIEW("sliding", details::sliding(RAH_STD::forward<R>(range), n, range_iter_categ_t<R>()));
 }
 
-inline auto sliding(size_t n)
+inline RAH_CONSTEXPR17 auto sliding(size_t n)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -683,18 +3002,369 @@ inline auto sliding(size_t n)
 		});
 }
 
-// ******************************************* drop_exactly ***************************************
+// *********************************** sliding_reduce **************************************************
+
+/// \cond PRIVATE
+namespace details
+{
+/// Window aggregation for invertible operations: the exiting value is removed using @b inverse
+template<typename T, typename F, typename I, typename A = RAH_STD::allocator<T>>
+struct invertible_window
+{
+	using value_type = T;
+	F op_;
+	I inverse_;
+	RAH_STD::vector<T, A> values_; ///< Ring buffer of the values in the window
+	size_t oldest_ = 0;
+	RAH_NAMESPACE::details::optional<T> total_;
+
+	invertible_window(size_t n, F const& op, A const& alloc = A())
+		: invertible_window(n, op, I(), alloc)
+	{
+	}
+	invertible_window(size_t n, F const& op, I const& inverse, A const& alloc = A())
+		: op_(op)
+		, inverse_(inverse)
+		, values_(alloc)
+	{
+		values_.reserve(n);
+	}
+	void clear() { values_.clear(); oldest_ = 0; total_.reset(); }
+	void push(T value)
+	{
+		total_ = total_.has_value() ? T(op_(*total_, value)) : value;
+		values_.push_back(RAH_STD::move(value));
+	}
+	void slide(T value)
+	{
+		total_ = T(op_(T(inverse_(*total_, values_[oldest_])), value));
+		values_[oldest_] = RAH_STD::move(value);
+		if (++oldest_ == values_.size())
+			oldest_ = 0;
+	}
+	T get() const { return *total_; }
+};
+
+/// Window aggregation for min/max, using a monotonic queue.
+/// The queue only keep the values which can still become the result: @b pred(a, b) is true
+/// when a have to be kept before b.
+template<typename T, typename P, typename A = RAH_STD::allocator<T>>
+struct monotonic_window
+{
+	using value_type = T;
+	using Candidate = RAH_STD::pair<size_t, T>;
+	P pred_;
+	size_t windowSize_;
+	/// (index, value) of the candidates
+	RAH_STD::vector<Candidate, typename RAH_STD::allocator_traits<A>::template rebind_alloc<Candidate>> candidates_;
+	size_t front_ = 0; ///< Position of the first candidate in candidates_
+	size_t count_ = 0; ///< Count of pushed values
+
+	template<typename F>
+	monotonic_window(size_t n, F const&, A const& alloc = A())
+		: windowSize_(n)
+		, candidates_(alloc)
+	{
+		candidates_.reserve(n * 2);
+	}
+	void clear() { candidates_.clear(); front_ = 0; count_ = 0; }
+	void push(T value)
+	{
+		while (candidates_.size() != front_ and not pred_(candidates_.back().second, value))
+			candidates_.pop_back();
+		candidates_.emplace_back(count_++, RAH_STD::move(value));
+	}
+	void slide(T value)
+	{
+		push(RAH_STD::move(value));
+		// Only the value which just leave the window can be expired
+		if (candidates_[front_].first + windowSize_ < count_)
+			++front_;
+		// Free the space of the expired candidates. Done every n slides at most, so amortized O(1)
+		if (front_ >= windowSize_)
+		{
+			candidates_.erase(rah_begin(candidates_), rah_begin(candidates_) + front_);
+			front_ = 0;
+		}
+	}
+	T get() const { return candidates_[front_].second; }
+};
+
+/// Window aggregation for any associative operation, using two stacks.
+/// The newest values are pushed on the back stack. When the oldest value have to be removed
+/// and the front stack is empty, the back stack is flipped into the front stack, storing
+/// the aggregate of each value with all the following ones.
+template<typename T, typename F, typename A = RAH_STD::allocator<T>>
+struct two_stack_window
+{
+	using value_type = T;
+	F op_;
+	RAH_STD::vector<T, A> front_; ///< front_[i] aggregate all the values from i to 0 (the oldest is on top)
+	RAH_STD::vector<T, A> back_; ///< Newest values, in insertion order
+	RAH_NAMESPACE::details::optional<T> backTotal_; ///< Aggregate of back_
+
+	two_stack_window(size_t n, F const& op, A const& alloc = A())
+		: op_(op)
+		, front_(alloc)
+		, back_(alloc)
+	{
+		front_.reserve(n);
+		back_.reserve(n);
+	}
+	void clear() { front_.clear(); back_.clear(); backTotal_.reset(); }
+	void push(T value)
+	{
+		backTotal_ = backTotal_.has_value() ? T(op_(*backTotal_, value)) : value;
+		back_.push_back(RAH_STD::move(value));
+	}
+	void slide(T value)
+	{
+		if (front_.empty())
+		{
+			for (auto iter = back_.rbegin(); iter != back_.rend(); ++iter)
+				front_.push_back(front_.empty() ? *iter : T(op_(*iter, front_.back())));
+			back_.clear();
+			backTotal_.reset();
+		}
+		front_.pop_back();
+		push(RAH_STD::move(value));
+	}
+	T get() const
+	{
+		if (front_.empty())
+			return *backTotal_;
+		if (not backTotal_.has_value())
+			return front_.back();
+		return op_(front_.back(), *backTotal_);
+	}
+};
+
+struct is_greater
+{
+	template<typename A, typename B> bool operator()(A&& a, B&& b) const { return b < a; }
+};
+
+/// Choose the aggregation algorithm of a window, depending on the operation.
+/// The window buffers are allocated using @b A
+template<typename T, typename F, typename A = RAH_STD::allocator<T>>
+struct sliding_window { using type = two_stack_window<T, F, A>; };
+template<typename T, typename U, typename A> struct sliding_window<T, RAH_STD::plus<U>, A>
+{
+	using type = invertible_window<T, RAH_STD::plus<U>, RAH_STD::minus<U>, A>;
+};
+template<typename T, typename U, typename A> struct sliding_window<T, RAH_STD::bit_xor<U>, A>
+{
+	using type = invertible_window<T, RAH_STD::bit_xor<U>, RAH_STD::bit_xor<U>, A>;
+};
+template<typename T, typename A> struct sliding_window<T, minimum, A> { using type = monotonic_window<T, is_lesser, A>; };
+template<typename T, typename A> struct sliding_window<T, maximum, A> { using type = monotonic_window<T, is_greater, A>; };
+} // namespace details
+/// \endcond
+
+/// @see rah::view::sliding_reduce
+template<typename V>
+struct sliding_reduce_iterator : iterator_facade<sliding_reduce_iterator<V>, typename V::value_type, RAH_STD::input_iterator_tag>
+{
+	using base_iterator = range_begin_type_t<typename V::base_view>;
+	V const* view_ = nullptr;
+	base_iterator iter_; ///< Next value to enter the window
+	bool atEnd_ = true;
+
+	sliding_reduce_iterator() = default;
+	sliding_reduce_iterator(V const* view, base_iterator iter) : view_(view), iter_(iter), atEnd_(false)
+	{
+		auto const endIter = rah_end(view_->base_);
+		for (size_t i = 0; i != view_->windowSize_; ++i, ++iter_)
+		{
+			if (iter_ == endIter)
+			{
+				atEnd_ = true;
+				return;
+			}
+			view_->window_.push(*iter_);
+		}
+	}
 
-template<typename R> auto drop_exactly(R&& range, size_t count)
+	void increment()
+	{
+		if (iter_ == rah_end(view_->base_))
+			atEnd_ = true;
+		else
+		{
+			view_->window_.slide(*iter_);
+			++iter_;
+		}
+	}
+	auto dereference() const -> typename V::value_type { return view_->window_.get(); }
+	bool equal(sliding_reduce_iterator const& other) const
+	{
+		return atEnd_ == other.atEnd_ and (atEnd_ or iter_ == other.iter_);
+	}
+};
+
+/// @see rah::view::sliding_reduce
+template<typename R, typename W>
+struct sliding_reduce_view
+{
+	static constexpr bool is_view = true; ///< See details::is_movable_container
+	using base_view = R;
+	using value_type = typename W::value_type;
+	using iterator = sliding_reduce_iterator<sliding_reduce_view>;
+
+	R base_;
+	size_t windowSize_;
+	mutable W window_;
+
+	sliding_reduce_view(R base, size_t n, W window)
+		: base_(RAH_STD::move(base))
+		, windowSize_(n)
+		, window_(RAH_STD::move(window))
+	{
+	}
+
+	/// Start a new iteration, clearing the window
+	iterator begin() const
+	{
+		window_.clear();
+		return { this, rah_begin(base_) };
+	}
+	iterator end() const { return {}; }
+};
+
+/// @brief Reduce each window of @b n consecutive elements using the associative operation @b op,
+/// in amortized O(1) by element.
+/// @return A range of the reduced value of each window, like view::sliding | view::transform(reduce)
+/// @remark The algorithm depend on @b op :
+///   - RAH_STD::plus and RAH_STD::bit_xor remove the exiting element using their inverse.
+///     (With floating point values, rounding errors accumulate along the range)
+///   - rah::minimum and rah::maximum use a monotonic queue
+///   - Any other associative operation use two stacks. It need at most 3 calls to @b op by element.
+/// @remark The window is stored in the view, which is single-pass (input iterators) and must outlive its iterators.
+/// Only one element of the input range is read at a time, so it can be a generator.
+///
+/// @snippet test.cpp rah::view::sliding_reduce
+template<typename R, typename F, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto sliding_reduce(R&& range, size_t n, F&& op)
+{
+	assert(n != 0);
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using Operation = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	using Window = typename details::sliding_window<value_type, Operation>::type;
+	auto view = all(RAH_STD::forward<R>(range));
+	return sliding_reduce_view<decltype(view), Window>(RAH_STD::move(view), n, Window(n, op));
+}
+
+/// @brief Reduce each window of @b n consecutive elements using the operation @b op,
+/// removing the exiting element using the operation @b inverse, so that inverse(op(a, b), a) == b
+/// @return A range of the reduced value of each window
+///
+/// @snippet test.cpp rah::view::sliding_reduce_inverse
+template<
+	typename R,
+	typename F,
+	typename I,
+	typename = RAH_STD::enable_if_t<is_range<R>::value>,
+	typename = RAH_STD::enable_if_t<
+		not RAH_NAMESPACE::details::is_allocator_arg<RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<I>>>::value>>
+auto sliding_reduce(R&& range, size_t n, F&& op, I&& inverse)
+{
+	assert(n != 0);
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using Operation = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	using Inverse = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<I>>;
+	using Window = details::invertible_window<value_type, Operation, Inverse>;
+	auto view = all(RAH_STD::forward<R>(range));
+	return sliding_reduce_view<decltype(view), Window>(RAH_STD::move(view), n, Window(n, op, inverse));
+}
+
+/// @brief Reduce each window of @b n consecutive elements using the operation @b op,
+/// with the window buffers allocated using @b alloc
+/// @param alloc An allocator, a pointer to a rah::arena, or a pointer to a RAH_STD::pmr::memory_resource.
+///
+/// @snippet test.cpp rah::view::sliding_reduce_alloc
+template<
+	typename R,
+	typename F,
+	typename A,
+	typename = RAH_STD::enable_if_t<is_range<R>::value>,
+	typename = RAH_STD::enable_if_t<RAH_NAMESPACE::details::is_allocator_arg<A>::value>>
+auto sliding_reduce(R&& range, size_t n, F&& op, A const& alloc)
+{
+	assert(n != 0);
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using Operation = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	using Alloc = RAH_NAMESPACE::details::allocator_for_t<A, value_type>;
+	using Window = typename details::sliding_window<value_type, Operation, Alloc>::type;
+	auto view = all(RAH_STD::forward<R>(range));
+	return sliding_reduce_view<decltype(view), Window>(RAH_STD::move(view), n, Window(n, op, Alloc(alloc)));
+}
+
+/// @brief Reduce each window of @b n consecutive elements using the operation @b op and its @b inverse,
+/// with the window buffer allocated using @b alloc
+template<typename R, typename F, typename I, typename A, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto sliding_reduce(R&& range, size_t n, F&& op, I&& inverse, A const& alloc)
 {
+	assert(n != 0);
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using Operation = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
+	using Inverse = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<I>>;
+	using Alloc = RAH_NAMESPACE::details::allocator_for_t<A, value_type>;
+	using Window = details::invertible_window<value_type, Operation, Inverse, Alloc>;
 	auto view = all(RAH_STD::forward<R>(range));
-	auto iter1 = rah_begin(view);
-	auto iter2 = rah_end(view);
-	RAH_STD::advance(iter1, count);
-	return make_iterator_range(iter1, iter2);
+	return sliding_reduce_view<decltype(view), Window>(
+		RAH_STD::move(view), n, Window(n, op, inverse, Alloc(alloc)));
+}
+
+/// @see rah::view::sliding_reduce(R&& range, size_t n, F&& op)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::sliding_reduce_pipeable
+template<typename F>
+auto sliding_reduce(size_t n, F&& op)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return sliding_reduce(RAH_STD::forward<decltype(range)>(range), n, op);
+		});
+}
+
+/// @see rah::view::sliding_reduce(R&& range, size_t n, F&& op, I&& inverse)
+/// @see rah::view::sliding_reduce(R&& range, size_t n, F&& op, A const& alloc)
+/// @remark pipeable syntax
+template<typename F, typename I>
+auto sliding_reduce(size_t n, F&& op, I&& inverse)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return sliding_reduce(RAH_STD::forward<decltype(range)>(range), n, op, inverse);
+		});
+}
+
+/// @see rah::view::sliding_reduce(R&& range, size_t n, F&& op, I&& inverse, A const& alloc)
+/// @remark pipeable syntax
+template<typename F, typename I, typename A>
+auto sliding_reduce(size_t n, F&& op, I&& inverse, A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return sliding_reduce(RAH_STD::forward<decltype(range)>(range), n, op, inverse, alloc);
+		});
+}
+
+// ******************************************* drop_exactly ***************************************
+
+template<typename R> RAH_CONSTEXPR17 auto drop_exactly(R&& range, size_t count)
+{
+	return RAH_INSTRUMENT_VIEW("drop_exactly", details::adapt(RAH_STD::forward<R>(range), [count](auto view)
+		{
+			auto iter1 = rah_begin(view);
+			auto iter2 = rah_end(view);
+			RAH_STD::advance(iter1, count);
+			return make_iterator_range(iter1, iter2);
+		}));
 }
 
-inline auto drop_exactly(size_t count)
+inline RAH_CONSTEXPR17 auto drop_exactly(size_t count)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -704,21 +3374,40 @@ inline auto drop_exactly(size_t count)
 
 // ******************************************* drop ***********************************************
 
-template<typename R> auto drop(R&& range, size_t count)
+/// \cond PRIVATE
+namespace details
 {
-	auto view = all(RAH_STD::forward<R>(range));
-	auto iter1 = rah_begin(view);
-	auto iter2 = rah_end(view);
-	for(size_t i = 0; i < count; ++i)
+template<typename I>
+RAH_CONSTEXPR17 void advance_bounded(I& iter, I const& end, size_t count, RAH_STD::input_iterator_tag)
+{
+	for (size_t i = 0; i < count; ++i)
 	{
-		if (iter1 == iter2)
+		if (iter == end)
 			break;
-		++iter1;
+		++iter;
 	}
-	return make_iterator_range(iter1, iter2);
 }
 
-inline auto drop(size_t count)
+template<typename I>
+RAH_CONSTEXPR17 void advance_bounded(I& iter, I const& end, size_t count, RAH_STD::random_access_iterator_tag)
+{
+	iter += intptr_t(RAH_STD::min(count, size_t(end - iter)));
+}
+} // namespace details
+/// \endcond
+
+template<typename R> RAH_CONSTEXPR17 auto drop(R&& range, size_t count)
+{
+	return RAH_INSTRUMENT_VIEW("drop", details::adapt(RAH_STD::forward<R>(range), [count](auto view)
+		{
+			auto iter1 = rah_begin(view);
+			auto iter2 = rah_end(view);
+			details::advance_bounded(iter1, iter2, count, range_iter_categ_t<decltype(view)>());
+			return make_iterator_range(iter1, iter2);
+		}));
+}
+
+inline RAH_CONSTEXPR17 auto drop(size_t count)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -739,32 +3428,32 @@ struct counted_iterator : iterator_facade<
 	size_t count_ = size_t();
 
 	counted_iterator() = default;
-	counted_iterator(I iter, size_t count) : iter_(iter), count_(count) {}
-
-	void increment() { ++iter_; ++count_; }
-	void advance(intptr_t off) { iter_ += off; count_ += off; }
-	void decrement() { --iter_; --count_; }
-	auto distance_to(counted_iterator const& r) const { return count_ - r.count_; }
-	auto dereference() const -> decltype(*iter_) { return *iter_; }
-	bool equal(counted_iterator const& r) const { return count_ == r.count_; }
+	RAH_CONSTEXPR17 counted_iterator(I iter, size_t count) : iter_(iter), count_(count) {}
+
+	RAH_CONSTEXPR17 void increment() { ++iter_; ++count_; }
+	RAH_CONSTEXPR17 void advance(intptr_t off) { iter_ += off; count_ += off; }
+	RAH_CONSTEXPR17 void decrement() { --iter_; --count_; }
+	RAH_CONSTEXPR17 auto distance_to(counted_iterator const& r) const { return count_ - r.count_; }
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*iter_) { return *iter_; }
+	RAH_CONSTEXPR17 bool equal(counted_iterator const& r) const { return count_ == r.count_; }
 };
 
-template<typename I> auto counted(I&& it, size_t n, decltype(++it, 0) = 0)
+template<typename I> RAH_CONSTEXPR17 auto counted(I&& it, size_t n, decltype(++it, 0) = 0)
 {
 	using iterator = counted_iterator<RAH_STD::remove_reference_t<I>>;
 	iterator iter1(it, 0);
 	iterator iter2(it, n);
-	return make_iterator_range(iter1, iter2);
+	return RAH_INSTRUMENT_VIEW("counted", make_iterator_range(iter1, iter2));
 }
 
 /// @cond
 // Obsolete
-template<typename R> auto counted(R&& range, size_t n, decltype(rah_begin(range), 0) = 0)
+template<typename R> RAH_CONSTEXPR17 auto counted(R&& range, size_t n, decltype(rah_begin(range), 0) = 0)
 {
 	return take(range, n);
 }
 
-inline auto counted(size_t n)
+inline RAH_CONSTEXPR17 auto counted(size_t n)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -786,13 +3475,13 @@ struct unbounded_iterator : iterator_facade<
 	bool end_;
 
 	unbounded_iterator() = default;
-	unbounded_iterator(I iter, bool end) : iter_(iter), end_(end) {}
+	RAH_CONSTEXPR17 unbounded_iterator(I iter, bool end) : iter_(iter), end_(end) {}
 
-	void increment() { ++iter_; }
+	RAH_CONSTEXPR17 void increment() { ++iter_; }
 
-	void advance(intptr_t off) { iter_ += off; }
-	void decrement() { --iter_; }
-	auto distance_to(unbounded_iterator const& r) const
+	RAH_CONSTEXPR17 void advance(intptr_t off) { iter_ += off; }
+	RAH_CONSTEXPR17 void decrement() { --iter_; }
+	RAH_CONSTEXPR17 auto distance_to(unbounded_iterator const& r) const
 	{
 		if (end_)
 		{
@@ -810,8 +3499,8 @@ struct unbounded_iterator : iterator_facade<
 		}
 	}
 
-	auto dereference() const -> decltype(*iter_) { return *iter_; }
-	bool equal(unbounded_iterator const& r) const
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*iter_) { return *iter_; }
+	RAH_CONSTEXPR17 bool equal(unbounded_iterator const& r) const
 	{
 		return end_?
 			r.end_:
@@ -819,12 +3508,12 @@ struct unbounded_iterator : iterator_facade<
 	}
 };
 
-template<typename I> auto unbounded(I&& it)
+template<typename I> RAH_CONSTEXPR17 auto unbounded(I&& it)
 {
 	using iterator = unbounded_iterator<RAH_STD::remove_reference_t<I>>;
 	iterator iter1(it, false);
 	iterator iter2(it, true);
-	return make_iterator_range(iter1, iter2);
+	return RAH_INSTRUMENT_VIEW("unbounded", make_iterator_range(iter1, iter2));
 }
 
 // ********************************** ints ********************************************************
@@ -836,24 +3525,24 @@ struct ints_iterator : iterator_facade<ints_iterator<T>, T, RAH_STD::random_acce
 	T val_ = T();
 
 	ints_iterator() = default;
-	ints_iterator(T val) : val_(val) {}
-
-	void increment() { ++val_; }
-	void advance(intptr_t value) { val_ += T(value); }
-	void decrement() { --val_; }
-	auto distance_to(ints_iterator const& other) const { return (val_ - other.val_); }
-	auto dereference() const { return val_; }
-	bool equal(ints_iterator const& other) const { return val_ == other.val_; }
+	RAH_CONSTEXPR17 ints_iterator(T val) : val_(val) {}
+
+	RAH_CONSTEXPR17 void increment() { ++val_; }
+	RAH_CONSTEXPR17 void advance(intptr_t value) { val_ += T(value); }
+	RAH_CONSTEXPR17 void decrement() { --val_; }
+	RAH_CONSTEXPR17 auto distance_to(ints_iterator const& other) const { return (val_ - other.val_); }
+	RAH_CONSTEXPR17 auto dereference() const { return val_; }
+	RAH_CONSTEXPR17 bool equal(ints_iterator const& other) const { return val_ == other.val_; }
 };
 
-template<typename T = size_t> auto ints(T b = 0, T e = RAH_STD::numeric_limits<T>::max())
+template<typename T = size_t> RAH_CONSTEXPR17 auto ints(T b = 0, T e = RAH_STD::numeric_limits<T>::max())
 {
-	return iterator_range<ints_iterator<T>>{ b, e};
+	return RAH_INSTRUMENT_VIEW("ints", iterator_range<ints_iterator<T>>{ b, e});
 }
 
-template<typename T = size_t> auto closed_ints(T b = 0, T e = RAH_STD::numeric_limits<T>::max() - 1)
+template<typename T = size_t> RAH_CONSTEXPR17 auto closed_ints(T b = 0, T e = RAH_STD::numeric_limits<T>::max() - 1)
 {
-	return iterator_range<ints_iterator<T>>{ b, e + 1};
+	return RAH_INSTRUMENT_VIEW("closed_ints", iterator_range<ints_iterator<T>>{ b, e + 1});
 }
 
 // ********************************** iota ********************************************************
@@ -866,22 +3555,22 @@ struct iota_iterator : iterator_facade<iota_iterator<T>, T, RAH_STD::random_acce
 	T step_ = T(1);
 
 	iota_iterator() = default;
-	iota_iterator(T val, T step) : val_(val), step_(step) {}
-
-	void increment() { val_ += step_; }
-	void advance(intptr_t value) { val_ += T(step_ * value); }
-	void decrement() { val_ -= step_; }
-	auto distance_to(iota_iterator const& other) const { return (val_ - other.val_) / step_; }
-	auto dereference() const { return val_; }
-	bool equal(iota_iterator const& other) const { return val_ == other.val_; }
+	RAH_CONSTEXPR17 iota_iterator(T val, T step) : val_(val), step_(step) {}
+
+	RAH_CONSTEXPR17 void increment() { val_ += step_; }
+	RAH_CONSTEXPR17 void advance(intptr_t value) { val_ += T(step_ * value); }
+	RAH_CONSTEXPR17 void decrement() { val_ -= step_; }
+	RAH_CONSTEXPR17 auto distance_to(iota_iterator const& other) const { return (val_ - other.val_) / step_; }
+	RAH_CONSTEXPR17 auto dereference() const { return val_; }
+	RAH_CONSTEXPR17 bool equal(iota_iterator const& other) const { return val_ == other.val_; }
 };
 
-template<typename T = size_t> auto iota(T b, T e, T step = 1)
+template<typename T = size_t> RAH_CONSTEXPR17 auto iota(T b, T e, T step = 1)
 {
 	assert(step != 0);
 	auto diff = (e - b);
 	diff = ((diff + (step - 1)) / step) * step;
-	return iterator_range<iota_iterator<T>>{ { b, step}, { b + diff, step }};
+	return RAH_INSTRUMENT_VIEW("iota", iterator_range<iota_iterator<T>>{ { b, step}, { b + diff, step }});
 }
 
 // ********************************** repeat ******************************************************
@@ -894,18 +3583,18 @@ struct repeat_iterator : iterator_facade<repeat_iterator<V>, V const&, RAH_STD::
 
 	repeat_iterator() = default;
 	template<typename U>
-	repeat_iterator(U val) : val_(RAH_STD::forward<U>(val)) {}
+	RAH_CONSTEXPR17 repeat_iterator(U val) : val_(RAH_STD::forward<U>(val)) {}
 
-	void increment() { }
-	void advance(intptr_t value) { }
-	void decrement() { }
-	V const& dereference() const { return val_; }
-	bool equal(repeat_iterator const&) const { return false; }
+	RAH_CONSTEXPR17 void increment() { }
+	RAH_CONSTEXPR17 void advance(intptr_t value) { }
+	RAH_CONSTEXPR17 void decrement() { }
+	RAH_CONSTEXPR17 V const& dereference() const { return val_; }
+	RAH_CONSTEXPR17 bool equal(repeat_iterator const&) const { return false; }
 };
 
-template<typename V> auto repeat(V&& value)
+template<typename V> RAH_CONSTEXPR17 auto repeat(V&& value)
 {
-	return iterator_range<repeat_iterator<RAH_STD::remove_const_t<RAH_STD::remove_reference_t<V>>>>{ { value}, { value }};
+	return RAH_INSTRUMENT_VIEW("repeat", iterator_range<repeat_iterator<RAH_STD::remove_const_t<RAH_STD::remove_reference_t<V>>>>{ { value}, { value }});
 }
 
 // ********************************** join ********************************************************
@@ -915,7 +3604,7 @@ struct join_iterator : iterator_facade<join_iterator<R>, range_ref_type_t<range_
 {
 	using Iterator1 = range_begin_type_t<R>;
 	using SubRangeType = RAH_STD::remove_reference_t<decltype(all(*fake<Iterator1>()))>;
-	using Iterator2 = range_begin_type_t<decltype(*fake<Iterator1>())>;
+	using Iterator2 = range_begin_type_t<SubRangeType>;
 	Iterator1 rangeIter_;
 	Iterator1 rangeEnd_;
 	Iterator2 subRangeIter;
@@ -924,7 +3613,7 @@ struct join_iterator : iterator_facade<join_iterator<R>, range_ref_type_t<range_
 	join_iterator() = default;
 
 	template<typename SR>
-	join_iterator(Iterator1 rangeIter, Iterator1 rangeEnd, SR&& subRange)
+	RAH_CONSTEXPR17 join_iterator(Iterator1 rangeIter, Iterator1 rangeEnd, SR&& subRange)
 		: rangeIter_(rangeIter)
 		, rangeEnd_(rangeEnd)
 		, subRangeIter(rah_begin(subRange))
@@ -935,13 +3624,13 @@ struct join_iterator : iterator_facade<join_iterator<R>, range_ref_type_t<range_
 		next_valid();
 	}
 
-	join_iterator(Iterator1 rangeIter, Iterator1 rangeEnd)
+	RAH_CONSTEXPR17 join_iterator(Iterator1 rangeIter, Iterator1 rangeEnd)
 		: rangeIter_(rangeIter)
 		, rangeEnd_(rangeEnd)
 	{
 	}
 
-	void next_valid()
+	RAH_CONSTEXPR17 void next_valid()
 	{
 		while (subRangeIter == subRangeEnd)
 		{
@@ -957,13 +3646,13 @@ struct join_iterator : iterator_facade<join_iterator<R>, range_ref_type_t<range_
 		}
 	}
 
-	void increment()
+	RAH_CONSTEXPR17 void increment()
 	{
 		++subRangeIter;
 		next_valid();
 	}
-	auto dereference() const ->decltype(*subRangeIter) { return *subRangeIter; }
-	bool equal(join_iterator const& other) const
+	RAH_CONSTEXPR17 auto dereference() const ->decltype(*subRangeIter) { return *subRangeIter; }
+	RAH_CONSTEXPR17 bool equal(join_iterator const& other) const
 	{
 		if (rangeIter_ == rangeEnd_)
 			return rangeIter_ == other.rangeIter_;
@@ -972,33 +3661,115 @@ struct join_iterator : iterator_facade<join_iterator<R>, range_ref_type_t<range_
 	}
 };
 
-template<typename R> auto join(R&& range_of_ranges)
+/// @see rah::view::join
+template<typename V>
+struct join_owning_iterator : iterator_facade<
+	join_owning_iterator<V>,
+	range_ref_type_t<typename V::sub_range&>,
+	RAH_STD::input_iterator_tag
+>
 {
-	auto rangeRef = RAH_NAMESPACE::view::all(range_of_ranges);
-	using join_iterator_type = join_iterator<decltype(rangeRef)>;
-	auto rangeBegin = rah_begin(rangeRef);
-	auto rangeEnd = rah_end(rangeRef);
-	if (empty(rangeRef))
+	using Iterator1 = range_begin_type_t<typename V::base_view>;
+	using Iterator2 = range_begin_type_t<typename V::sub_range&>;
+	V const* view_ = nullptr;
+	Iterator1 rangeIter_;
+	Iterator2 subRangeIter_;
+
+	join_owning_iterator() = default;
+	join_owning_iterator(V const* view, Iterator1 rangeIter) : view_(view), rangeIter_(rangeIter)
+	{
+		if (rangeIter_ == rah_end(view_->base_))
+			return;
+		load_sub_range();
+		next_valid();
+	}
+
+	void load_sub_range()
 	{
-		join_iterator_type b(rangeBegin, rangeEnd);
-		join_iterator_type e(rangeEnd, rangeEnd);
-		return make_iterator_range(b, e);
+		view_->subRange_ = all(*rangeIter_);
+		subRangeIter_ = rah_begin(view_->subRange_);
 	}
-	else
+
+	void next_valid()
+	{
+		while (subRangeIter_ == rah_end(view_->subRange_))
+		{
+			++rangeIter_;
+			if (rangeIter_ == rah_end(view_->base_))
+				return;
+			load_sub_range();
+		}
+	}
+
+	void increment()
+	{
+		++subRangeIter_;
+		next_valid();
+	}
+	auto dereference() const -> decltype(*subRangeIter_) { return *subRangeIter_; }
+	bool equal(join_owning_iterator const& other) const
 	{
-		auto firstSubRange = all(*rangeBegin);
-		join_iterator_type b(
-			rangeBegin,
-			rangeEnd,
-			RAH_STD::forward<decltype(firstSubRange)>(firstSubRange));
-		join_iterator_type e(rangeEnd, rangeEnd);
-		return make_iterator_range(b, e);
+		if (rangeIter_ == rah_end(view_->base_))
+			return rangeIter_ == other.rangeIter_;
+		else
+			return rangeIter_ == other.rangeIter_ && subRangeIter_ == other.subRangeIter_;
 	}
+};
+
+/// @see rah::view::join
+/// The sub-ranges are generated by value, so the current one is stored in the view
+template<typename R>
+struct join_owning_view
+{
+	static constexpr bool is_view = true; ///< See details::is_movable_container
+	using base_view = R;
+	using sub_range = decltype(all(*fake<range_begin_type_t<R>>()));
+	using iterator = join_owning_iterator<join_owning_view>;
+
+	R base_;
+	mutable sub_range subRange_{};
+
+	/// Start a new iteration, reading again the first sub-range
+	iterator begin() const { return { this, rah_begin(base_) }; }
+	iterator end() const { return { this, rah_end(base_) }; }
+};
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename R> RAH_CONSTEXPR17 auto join(R rangeRef, RAH_STD::false_type)
+{
+	using join_iterator_type = join_iterator<decltype(rangeRef)>;
+	auto rangeBegin = rah_begin(rangeRef);
+	auto rangeEnd = rah_end(rangeRef);
+	join_iterator_type b = empty(rangeRef) ?
+		join_iterator_type(rangeBegin, rangeEnd) :
+		join_iterator_type(rangeBegin, rangeEnd, all(*rangeBegin));
+	join_iterator_type e(rangeEnd, rangeEnd);
+	return RAH_INSTRUMENT_VIEW("join", make_iterator_range(b, e));
+}
+
+/// The sub-ranges are containers returned by value, which can't outlive the iterators.
+/// The current one is kept in the view, which is single-pass.
+template<typename R> auto join(R rangeRef, RAH_STD::true_type)
+{
+	return join_owning_view<R>{ RAH_STD::move(rangeRef) };
+}
+} // namespace details
+/// \endcond
+
+template<typename R> RAH_CONSTEXPR17 auto join(R&& range_of_ranges)
+{
+	return details::adapt(RAH_STD::forward<R>(range_of_ranges), [](auto rangeRef)
+		{
+			using SubRange = decltype(all(*rah_begin(rangeRef)));
+			return details::join(rangeRef, details::is_owning_view<SubRange>());
+		});
 }
 
-inline auto join()
+inline RAH_CONSTEXPR17 auto join()
 {
-	return make_pipeable([](auto&& range) {return join(range); });
+	return make_pipeable([](auto&& range) {return join(RAH_STD::forward<decltype(range)>(range)); });
 }
 
 // ********************************** cycle ********************************************************
@@ -1018,7 +3789,7 @@ struct cycle_iterator : iterator_facade<
 
 	cycle_iterator() = default;
 	template<typename U>
-	explicit cycle_iterator(U&& range, Iterator iter, int64_t cycleIndex)
+	explicit RAH_CONSTEXPR17 cycle_iterator(U&& range, Iterator iter, int64_t cycleIndex)
 		: range_(RAH_STD::forward<U>(range))
 		, beginIter_(rah_begin(range_))
 		, endIter_(rah_end(range_))
@@ -1027,7 +3798,7 @@ struct cycle_iterator : iterator_facade<
 	{
 	}
 
-	void increment()
+	RAH_CONSTEXPR17 void increment()
 	{
 		++iter_;
 		while (iter_ == endIter_)
@@ -1036,7 +3807,7 @@ struct cycle_iterator : iterator_facade<
 			++cycleIndex_;
 		}
 	}
-	void decrement()
+	RAH_CONSTEXPR17 void decrement()
 	{
 		while (iter_ == beginIter_)
 		{
@@ -1045,26 +3816,27 @@ struct cycle_iterator : iterator_facade<
 		}
 		--iter_;
 	}
-	auto dereference() const ->decltype(*iter_) { return *iter_; }
-	bool equal(cycle_iterator const& other) const
+	RAH_CONSTEXPR17 auto dereference() const ->decltype(*iter_) { return *iter_; }
+	RAH_CONSTEXPR17 bool equal(cycle_iterator const& other) const
 	{
 		return cycleIndex_ == other.cycleIndex_ and iter_ == other.iter_;
 	}
 };
 
-template<typename R> auto cycle(R&& range)
+template<typename R> RAH_CONSTEXPR17 auto cycle(R&& range)
 {
-	auto rangeRef = range | RAH_NAMESPACE::view::all();
-	using iterator_type = cycle_iterator<RAH_STD::remove_reference_t<decltype(rangeRef)>>;
-	auto view = all(RAH_STD::forward<R>(range));
-	iterator_type beginIter(rangeRef, rah_begin(view), 0);
-	iterator_type endIter(rangeRef, rah_end(view), -1);
-	return make_iterator_range(beginIter, endIter);
+	return RAH_INSTRUMENT_VIEW("cycle", details::adapt(RAH_STD::forward<R>(range), [](auto view)
+		{
+			using iterator_type = cycle_iterator<decltype(view)>;
+			iterator_type beginIter(view, rah_begin(view), 0);
+			iterator_type endIter(view, rah_end(view), -1);
+			return make_iterator_range(beginIter, endIter);
+		}));
 }
 
-inline auto cycle()
+inline RAH_CONSTEXPR17 auto cycle()
 {
-	return make_pipeable([](auto&& range) {return cycle(range); });
+	return make_pipeable([](auto&& range) {return cycle(RAH_STD::forward<decltype(range)>(range)); });
 }
 
 // ********************************** generate ****************************************************
@@ -1076,20 +3848,20 @@ struct generate_iterator : iterator_facade<generate_iterator<F>, decltype(fake<F
 	mutable RAH_NAMESPACE::details::optional<F> func_;
 
 	generate_iterator() = default;
-	generate_iterator(F const& func) : func_(func) {}
+	RAH_CONSTEXPR17 generate_iterator(F const& func) : func_(func) {}
 
-	void increment() { }
-	auto dereference() const { return (*func_)(); }
-	bool equal(generate_iterator const&) const { return false; }
+	RAH_CONSTEXPR17 void increment() { }
+	RAH_CONSTEXPR17 auto dereference() const { return (*func_)(); }
+	RAH_CONSTEXPR17 bool equal(generate_iterator const&) const { return false; }
 };
 
-template<typename F> auto generate(F&& func)
+template<typename F> RAH_CONSTEXPR17 auto generate(F&& func)
 {
 	using Functor = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
-	return iterator_range<generate_iterator<Functor>>{ { func}, { func }};
+	return RAH_INSTRUMENT_VIEW("generate", iterator_range<generate_iterator<Functor>>{ { func}, { func }});
 }
 
-template<typename F> auto generate_n(size_t count, F&& func)
+template<typename F> RAH_CONSTEXPR17 auto generate_n(size_t count, F&& func)
 {
 	return generate(RAH_STD::forward<F>(func)) | take(count);
 }
@@ -1107,27 +3879,29 @@ struct transform_iterator : iterator_facade<
 	RAH_NAMESPACE::details::optional<F> func_;
 
 	transform_iterator() = default;
-	transform_iterator(range_begin_type_t<R> const& iter, F const& func) : iter_(iter), func_(func) {}
-
-	void increment() { ++iter_; }
-	void advance(intptr_t off) { iter_ += off; }
-	void decrement() { --iter_; }
-	auto distance_to(transform_iterator const& r) const { return iter_ - r.iter_; }
-	auto dereference() const -> decltype((*func_)(*iter_)) { return (*func_)(*iter_); }
-	bool equal(transform_iterator const& r) const { return iter_ == r.iter_; }
+	RAH_CONSTEXPR17 transform_iterator(range_begin_type_t<R> const& iter, F const& func) : iter_(iter), func_(func) {}
+
+	RAH_CONSTEXPR17 void increment() { ++iter_; }
+	RAH_CONSTEXPR17 void advance(intptr_t off) { iter_ += off; }
+	RAH_CONSTEXPR17 void decrement() { --iter_; }
+	RAH_CONSTEXPR17 auto distance_to(transform_iterator const& r) const { return iter_ - r.iter_; }
+	RAH_CONSTEXPR17 auto dereference() const -> decltype((*func_)(*iter_)) { return (*func_)(*iter_); }
+	RAH_CONSTEXPR17 bool equal(transform_iterator const& r) const { return iter_ == r.iter_; }
 };
 
-template<typename R, typename F> auto transform(R&& range, F&& func)
+template<typename R, typename F> RAH_CONSTEXPR17 auto transform(R&& range, F&& func)
 {
 	using Functor = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<F>>;
-	using iterator = transform_iterator<RAH_STD::remove_reference_t<R>, Functor>;
-	auto view = all(RAH_STD::forward<R>(range));
-	auto iter1 = rah_begin(view);
-	auto iter2 = rah_end(view);
-	return iterator_range<iterator>{ { iter1, func }, { iter2, func } };
+	return RAH_INSTRUMENT_VIEW("transform", details::adapt(RAH_STD::forward<R>(range),
+		[func = Functor(RAH_STD::forward<F>(func))](auto view)
+		{
+			using iterator = transform_iterator<decltype(view), Functor>;
+			using range = RAH_NAMESPACE::details::extent_range<iterator, decltype(view)>;
+			return range{ { rah_begin(view), func }, { rah_end(view), func } };
+		}));
 }
 
-template<typename F> auto transform(F&& func)
+template<typename F> RAH_CONSTEXPR17 auto transform(F&& func)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1150,13 +3924,13 @@ struct set_difference_iterator : iterator_facade<
 	InputIt2 last2_;
 
 	set_difference_iterator() = default;
-	set_difference_iterator(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
+	RAH_CONSTEXPR17 set_difference_iterator(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
 		: first1_(first1) , last1_(last1) , first2_(first2), last2_(last2)
 	{
 		next_value();
 	}
 
-	void next_value()
+	RAH_CONSTEXPR17 void next_value()
 	{
 		while (first2_ != last2_ and first1_ != last1_)
 		{
@@ -1172,42 +3946,45 @@ struct set_difference_iterator : iterator_facade<
 		}
 	}
 
-	void increment()
+	RAH_CONSTEXPR17 void increment()
 	{
 		++first1_;
 		next_value();
 	}
-	auto dereference() const -> decltype(*first1_) { return *first1_; }
-	bool equal(set_difference_iterator const& r) const { return first1_ == r.first1_; }
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*first1_) { return *first1_; }
+	RAH_CONSTEXPR17 bool equal(set_difference_iterator const& r) const { return first1_ == r.first1_; }
 };
 
-template<typename R1, typename R2> auto set_difference(R1&& range1, R2&& range2)
+template<typename R1, typename R2> RAH_CONSTEXPR17 auto set_difference(R1&& range1, R2&& range2)
 {
-	using Iter1 = range_begin_type_t<R1>;
-	using Iter2 = range_begin_type_t<R2>;
-	using Iterator = set_difference_iterator<Iter1, Iter2>;
-	auto view1 = all(RAH_STD::forward<R1>(range1));
-	auto view2 = all(RAH_STD::forward<R2>(range2));
-	return iterator_range<Iterator>{
-		{ Iterator(rah_begin(view1), rah_end(view1), rah_begin(view2), rah_end(view2)) },
-		{ Iterator(rah_end(view1), rah_end(view1), rah_end(view2), rah_end(view2)) },
+	auto makeView = [](auto view1, auto view2)
+	{
+		using Iter1 = range_begin_type_t<decltype(view1)>;
+		using Iter2 = range_begin_type_t<decltype(view2)>;
+		using Iterator = set_difference_iterator<Iter1, Iter2>;
+		return iterator_range<Iterator>{
+			{ Iterator(rah_begin(view1), rah_end(view1), rah_begin(view2), rah_end(view2)) },
+			{ Iterator(rah_end(view1), rah_end(view1), rah_end(view2), rah_end(view2)) },
+		};
 	};
+	return RAH_INSTRUMENT_VIEW("set_difference",
+		details::adapt_all(makeView, RAH_STD::forward<R1>(range1), RAH_STD::forward<R2>(range2)));
 }
 
-template<typename R2> auto set_difference(R2&& range2)
+template<typename R2> RAH_CONSTEXPR17 auto set_difference(R2&& range2)
 {
 	return make_pipeable([r2 = range2 | view::all()](auto&& range) {return set_difference(range, r2); });
 }
 
 // ********************************** for_each ****************************************************
 
-template<typename R, typename F> auto for_each(R&& range, F&& func)
+template<typename R, typename F> RAH_CONSTEXPR17 auto for_each(R&& range, F&& func)
 {
 	return range | RAH_NAMESPACE::view::transform(func) | RAH_NAMESPACE::view::join();
 }
 
 template<typename F>
-inline auto for_each(F&& func)
+inline RAH_CONSTEXPR17 auto for_each(F&& func)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1217,33 +3994,35 @@ inline auto for_each(F&& func)
 
 // ***************************************** slice ************************************************
 
-template<typename R> auto slice(R&& range, intptr_t begin_idx, intptr_t end_idx)
+template<typename R> RAH_CONSTEXPR17 auto slice(R&& range, intptr_t begin_idx, intptr_t end_idx)
 {
 	static_assert(not RAH_STD::is_same<range_iter_categ_t<R>, RAH_STD::forward_iterator_tag>::value, 
 		"Can't use slice on non-bidirectional iterators. Try to use view::drop and view::take");
-	auto findIter = [](auto b, auto e, intptr_t idx)
-	{
-		if (idx < 0)
-		{
-			idx += 1;
-			RAH_STD::advance(e, idx);
-			return e;
-		}
-		else
+	return RAH_INSTRUMENT_VIEW("slice", details::adapt(RAH_STD::forward<R>(range), [=](auto view)
 		{
-			RAH_STD::advance(b, idx);
-			return b;
-		}
-	};
-	auto view = all(RAH_STD::forward<R>(range));
-	auto b_in = rah_begin(view);
-	auto e_in = rah_end(view);
-	auto b_out = findIter(b_in, e_in, begin_idx);
-	auto e_out = findIter(b_in, e_in, end_idx);
-	return iterator_range<decltype(b_out)>{ {b_out}, { e_out } };
-}
-
-inline auto slice(intptr_t begin, intptr_t end)
+			auto findIter = [](auto b, auto e, intptr_t idx)
+			{
+				if (idx < 0)
+				{
+					idx += 1;
+					RAH_STD::advance(e, idx);
+					return e;
+				}
+				else
+				{
+					RAH_STD::advance(b, idx);
+					return b;
+				}
+			};
+			auto b_in = rah_begin(view);
+			auto e_in = rah_end(view);
+			auto b_out = findIter(b_in, e_in, begin_idx);
+			auto e_out = findIter(b_in, e_in, end_idx);
+			return iterator_range<decltype(b_out)>{ {b_out}, { e_out } };
+		}));
+}
+
+inline RAH_CONSTEXPR17 auto slice(intptr_t begin, intptr_t end)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1261,38 +4040,41 @@ struct stride_iterator : iterator_facade<stride_iterator<R>, range_ref_type_t<R>
 	size_t step_;
 
 	stride_iterator() = default;
-	stride_iterator(range_begin_type_t<R> const& iter, range_end_type_t<R> const& end, size_t step)
+	RAH_CONSTEXPR17 stride_iterator(range_begin_type_t<R> const& iter, range_end_type_t<R> const& end, size_t step)
 		: iter_(iter), end_(end), step_(step) {}
 
-	auto increment()
+	RAH_CONSTEXPR17 auto increment()
 	{
 		for (size_t i = 0; i < step_ && iter_ != end_; ++i)
 			++iter_;
 	}
 
-	auto decrement()
+	RAH_CONSTEXPR17 auto decrement()
 	{
 		for (size_t i = 0; i < step_; ++i)
 			--iter_;
 	}
 
-	void advance(intptr_t value) { iter_ += step_ * value; }
-	auto dereference() const -> decltype(*iter_) { return *iter_; }
-	bool equal(stride_iterator const& other) const { return iter_ == other.iter_; }
-	auto distance_to(stride_iterator const other) const { return (iter_ - other.iter_) / step_; }
+	RAH_CONSTEXPR17 void advance(intptr_t value) { iter_ += step_ * value; }
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*iter_) { return *iter_; }
+	RAH_CONSTEXPR17 bool equal(stride_iterator const& other) const { return iter_ == other.iter_; }
+	RAH_CONSTEXPR17 auto distance_to(stride_iterator const other) const { return (iter_ - other.iter_) / step_; }
 };
 
 
-template<typename R> auto stride(R&& range, size_t step)
+template<typename R> RAH_CONSTEXPR17 auto stride(R&& range, size_t step)
 {
-	auto view = all(RAH_STD::forward<R>(range));
-	auto iter = rah_begin(view);
-	auto endIter = rah_end(view);
-	return iterator_range<stride_iterator<RAH_STD::remove_reference_t<R>>>{
-		{ iter, endIter, step}, { endIter, endIter, step }};
+	return RAH_INSTRUMENT_VIEW("stride", details::adapt(RAH_STD::forward<R>(range), [step](auto view)
+		{
+			auto iter = rah_begin(view);
+			auto endIter = rah_end(view);
+			constexpr size_t Extent = static_max_size<decltype(view)>::value;
+			return iterator_range<stride_iterator<decltype(view)>, Extent>{
+				{ iter, endIter, step}, { endIter, endIter, step }};
+		}));
 }
 
-inline auto stride(size_t step)
+inline RAH_CONSTEXPR17 auto stride(size_t step)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1305,9 +4087,11 @@ inline auto stride(size_t step)
 // Use reverse instead of retro
 template<typename R> [[deprecated]] auto retro(R&& range)
 {
-	auto view = all(RAH_STD::forward<R>(range));
-	return make_iterator_range(
-		RAH_STD::make_reverse_iterator(rah_end(view)), RAH_STD::make_reverse_iterator(rah_begin(view)));
+	return details::adapt(RAH_STD::forward<R>(range), [](auto view)
+		{
+			return make_iterator_range(
+				RAH_STD::make_reverse_iterator(rah_end(view)), RAH_STD::make_reverse_iterator(rah_begin(view)));
+		});
 }
 
 // Use reverse instead of retro
@@ -1319,16 +4103,46 @@ template<typename R> [[deprecated]] auto retro(R&& range)
 		});
 }
 
+// ***************************************** move *************************************************
+
+/// @brief Create a view yielding rvalue references to the elements of the range, so that they
+/// are moved (and not copied) by the algorithms and containers which read it.
+///
+/// @snippet test.cpp rah::view::move
+template<typename R> auto move(R&& range)
+{
+	return RAH_INSTRUMENT_VIEW("move", details::adapt(RAH_STD::forward<R>(range), [](auto view)
+		{
+			return make_iterator_range(
+				RAH_STD::make_move_iterator(rah_begin(view)), RAH_STD::make_move_iterator(rah_end(view)));
+		}));
+}
+
+/// @see rah::view::move(R&& range)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::move_pipeable
+inline auto move()
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return view::move(RAH_STD::forward<decltype(range)>(range));
+		});
+}
+
 // ***************************************** reverse **********************************************
 
-template<typename R> auto reverse(R&& range)
+template<typename R> RAH_CONSTEXPR17 auto reverse(R&& range)
 {
-	auto view = all(RAH_STD::forward<R>(range));
-	return make_iterator_range(
-		RAH_STD::make_reverse_iterator(rah_end(view)), RAH_STD::make_reverse_iterator(rah_begin(view)));
+	return RAH_INSTRUMENT_VIEW("reverse", details::adapt(RAH_STD::forward<R>(range), [](auto view)
+		{
+			using iterator = RAH_STD::reverse_iterator<range_begin_type_t<decltype(view)>>;
+			using range = RAH_NAMESPACE::details::extent_range<iterator, decltype(view)>;
+			return range{ iterator(rah_end(view)), iterator(rah_begin(view)) };
+		}));
 }
 
-inline auto reverse()
+inline RAH_CONSTEXPR17 auto reverse()
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1339,7 +4153,7 @@ inline auto reverse()
 // ********************************** single ******************************************************
 
 template<typename V>
-auto single(V&& value)
+RAH_CONSTEXPR17 auto single(V&& value)
 {
 	return repeat(value) | take(1);
 }
@@ -1349,7 +4163,7 @@ auto single(V&& value)
 namespace details
 {
 template <typename Tuple, typename F, size_t ...Indices>
-void for_each_impl(Tuple&& tuple, F&& f, RAH_STD::index_sequence<Indices...>)
+RAH_CONSTEXPR17 void for_each_impl(Tuple&& tuple, F&& f, RAH_STD::index_sequence<Indices...>)
 {
 	using swallow = int[];
 	(void)swallow {
@@ -1359,7 +4173,7 @@ void for_each_impl(Tuple&& tuple, F&& f, RAH_STD::index_sequence<Indices...>)
 }
 
 template <typename Tuple, typename F>
-void for_each(Tuple&& tuple, F&& f)
+RAH_CONSTEXPR17 void for_each(Tuple&& tuple, F&& f)
 {
 	constexpr size_t N = RAH_STD::tuple_size<RAH_STD::remove_reference_t<Tuple>>::value;
 	for_each_impl(RAH_STD::forward<Tuple>(tuple), RAH_STD::forward<F>(f),
@@ -1367,27 +4181,27 @@ void for_each(Tuple&& tuple, F&& f)
 }
 
 template <class F, typename... Args, size_t... Is>
-auto transform_each_impl(const RAH_STD::tuple<Args...>& t, F&& f, RAH_STD::index_sequence<Is...>) {
+RAH_CONSTEXPR17 auto transform_each_impl(const RAH_STD::tuple<Args...>& t, F&& f, RAH_STD::index_sequence<Is...>) {
 	return RAH_STD::make_tuple(
 		f(RAH_STD::get<Is>(t))...
 	);
 }
 
 template <class F, typename... Args>
-auto transform_each(const RAH_STD::tuple<Args...>& t, F&& f) {
+RAH_CONSTEXPR17 auto transform_each(const RAH_STD::tuple<Args...>& t, F&& f) {
 	return transform_each_impl(
 		t, RAH_STD::forward<F>(f), RAH_STD::make_index_sequence<sizeof...(Args)>{});
 }
 
 template <typename... Args, size_t... Is>
-auto deref_impl(const RAH_STD::tuple<Args...>& t, RAH_STD::index_sequence<Is...>) {
+RAH_CONSTEXPR17 auto deref_impl(const RAH_STD::tuple<Args...>& t, RAH_STD::index_sequence<Is...>) {
 	return RAH_STD::tuple<typename RAH_STD::iterator_traits<Args>::reference...>(
 		(*RAH_STD::get<Is>(t))...
 	);
 }
 
 template <typename... Args>
-auto deref(const RAH_STD::tuple<Args...>& t) {
+RAH_CONSTEXPR17 auto deref(const RAH_STD::tuple<Args...>& t) {
 	return deref_impl(t, RAH_STD::make_index_sequence<sizeof...(Args)>{});
 }
 
@@ -1412,115 +4226,505 @@ struct Equal<0>
 };
 
 template <typename... Args>
-auto equal(RAH_STD::tuple<Args...> const& a, RAH_STD::tuple<Args...> const& b)
+RAH_CONSTEXPR17 auto equal(RAH_STD::tuple<Args...> const& a, RAH_STD::tuple<Args...> const& b, RAH_STD::bidirectional_iterator_tag)
 {
 	return Equal<sizeof...(Args)>{}(a, b);
 }
 
+/// The iterators move in lockstep and the end is computed for them to reach it together.
+/// So only the first one need to be compared.
+template <typename... Args>
+RAH_CONSTEXPR17 auto equal(RAH_STD::tuple<Args...> const& a, RAH_STD::tuple<Args...> const& b, RAH_STD::random_access_iterator_tag)
+{
+	return RAH_STD::get<0>(a) == RAH_STD::get<0>(b);
+}
+
+template<typename... C> struct all_random_access : RAH_STD::true_type {};
+
+template<typename C, typename... Cs>
+struct all_random_access<C, Cs...> : RAH_STD::integral_constant<bool,
+	RAH_STD::is_base_of<RAH_STD::random_access_iterator_tag, C>::value and all_random_access<Cs...>::value>
+{
+};
+
+template<typename Views, typename IterTuple>
+RAH_CONSTEXPR17 auto zip_end(Views const& views, IterTuple const&, RAH_STD::bidirectional_iterator_tag)
+{
+	return transform_each(views, [](auto&& v) { return rah_end(v); });
+}
+
+/// The end of the shortest range, and the iterators at the same position in the other ranges
+template<typename Views, typename IterTuple>
+RAH_CONSTEXPR17 auto zip_end(Views const& views, IterTuple const& iterTup, RAH_STD::random_access_iterator_tag)
+{
+	size_t size = RAH_STD::numeric_limits<size_t>::max();
+	details::for_each(views, [&size](auto&& v) { size = RAH_STD::min(size, size_t(rah_end(v) - rah_begin(v))); });
+	if (size >= size_t(RAH_STD::numeric_limits<intptr_t>::max())) // Only infinite ranges
+		return zip_end(views, iterTup, RAH_STD::bidirectional_iterator_tag());
+	return transform_each(iterTup, [size](auto&& iter) { return iter + intptr_t(size); });
+}
+} // namespace details
+/// \endcond
+
+template<typename IterTuple, typename Categ = RAH_STD::bidirectional_iterator_tag>
+struct zip_iterator : iterator_facade<
+	zip_iterator<IterTuple, Categ>,
+	decltype(details::deref(fake<IterTuple>())),
+	Categ
+>
+{
+	IterTuple iters_;
+	zip_iterator() = default;
+	RAH_CONSTEXPR17 zip_iterator(IterTuple const& iters) : iters_(iters) {}
+	RAH_CONSTEXPR17 void increment() { details::for_each(iters_, [](auto& iter) { ++iter; }); }
+	RAH_CONSTEXPR17 void advance(intptr_t val) { details::for_each(iters_, [val](auto& iter) { iter += val; }); }
+	RAH_CONSTEXPR17 void decrement() { details::for_each(iters_, [](auto& iter) { --iter; }); }
+	RAH_CONSTEXPR17 auto dereference() const { return details::deref(iters_); }
+	RAH_CONSTEXPR17 auto distance_to(zip_iterator const& other) const { return RAH_STD::get<0>(iters_) - RAH_STD::get<0>(other.iters_); }
+	RAH_CONSTEXPR17 bool equal(zip_iterator const& other) const { return details::equal(iters_, other.iters_, Categ()); }
+};
+
+/// @remark When all the ranges are random access, the zip is random access too, and only the first
+/// iterator is compared to the end.
+template<typename ...R> RAH_CONSTEXPR17 auto zip(R&&... _ranges)
+{
+	using Categ = RAH_STD::conditional_t<
+		details::all_random_access<range_iter_categ_t<R>...>::value,
+		RAH_STD::random_access_iterator_tag,
+		RAH_STD::bidirectional_iterator_tag>;
+	auto makeView = [](auto... rangeViews)
+	{
+		auto views = RAH_STD::make_tuple(rangeViews...);
+		auto iterTup = details::transform_each(views, [](auto&& v){ return rah_begin(v);});
+		auto endTup = details::zip_end(views, iterTup, Categ());
+		constexpr size_t Extent = RAH_NAMESPACE::details::min_extent(static_max_size<decltype(rangeViews)>::value...);
+		constexpr bool Exact = RAH_NAMESPACE::details::all_static(static_size<decltype(rangeViews)>::value...);
+		return iterator_range<zip_iterator<decltype(iterTup), Categ>, Extent, Exact>{ { iterTup }, { endTup }};
+	};
+	return RAH_INSTRUMENT_VIEW("zip", details::adapt_all(makeView, RAH_STD::forward<R>(_ranges)...));
+}
+
+// ************************************ chunk *****************************************************
+
+template<typename R>
+struct chunk_iterator : iterator_facade<chunk_iterator<R>, iterator_range<range_begin_type_t<R>>, RAH_STD::forward_iterator_tag>
+{
+	range_begin_type_t<R> iter_;
+	range_begin_type_t<R> iter2_;
+	range_end_type_t<R> end_;
+	size_t step_;
+
+	chunk_iterator() = default;
+	RAH_CONSTEXPR17 chunk_iterator(
+		range_begin_type_t<R> const& iter,
+		range_begin_type_t<R> const& iter2,
+		range_end_type_t<R> const& end,
+		size_t step = 0)
+		: iter_(iter), iter2_(iter2), end_(end), step_(step)
+	{
+	}
+
+	RAH_CONSTEXPR17 void increment()
+	{
+		iter_ = iter2_;
+		for (size_t i = 0; i != step_ and iter2_ != end_; ++i)
+			++iter2_;
+	}
+
+	RAH_CONSTEXPR17 auto dereference() const { return make_iterator_range(iter_, iter2_); }
+	RAH_CONSTEXPR17 bool equal(chunk_iterator const& other) const { return iter_ == other.iter_; }
+};
+
+template<typename R> RAH_CONSTEXPR17 auto chunk(R&& range, size_t step)
+{
+	return RAH_INSTRUMENT_VIEW("chunk", details::adapt(RAH_STD::forward<R>(range), [step](auto view)
+		{
+			auto iter = rah_begin(view);
+			auto endIter = rah_end(view);
+			using iterator = chunk_iterator<decltype(view)>;
+			iterator begin = { iter, iter, endIter, step };
+			begin.increment();
+			constexpr size_t Extent = static_max_size<decltype(view)>::value;
+			return iterator_range<iterator, Extent>{ { begin }, { endIter, endIter, endIter, step }};
+		}));
+}
+
+inline RAH_CONSTEXPR17 auto chunk(size_t step)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return chunk(RAH_STD::forward<decltype(range)>(range), step);
+		});
+}
+
+// ************************************ chunk_by **************************************************
+
+/// \cond PRIVATE
+namespace details
+{
+/// Find the end of a chunk where @b pred is true for all pair of adjacent elements
+template<typename P>
+struct adjacent_chunk_end
+{
+	P pred_;
+
+	template<typename I, typename E>
+	I operator()(I first, E last)
+	{
+		if (first == last)
+			return first;
+		I prev = first;
+		++first;
+		while (first != last and pred_(*prev, *first))
+		{
+			prev = first;
+			++first;
+		}
+		return first;
+	}
+};
+
+/// Find the end of a chunk where all elements have the same key
+/// @tparam Sorted The elements with the same key are known to be adjacent, so galloping can be used
+template<typename K, bool Sorted = false>
+struct key_chunk_end
+{
+	K key_;
+
+	template<typename I, typename E>
+	I operator()(I first, E last)
+	{
+		using Categ = RAH_STD::conditional_t<Sorted,
+			typename RAH_STD::iterator_traits<I>::iterator_category,
+			RAH_STD::forward_iterator_tag>;
+		return find_end(first, last, Categ());
+	}
+
+	template<typename I, typename E>
+	I find_end(I first, E last, RAH_STD::forward_iterator_tag)
+	{
+		if (first == last)
+			return first;
+		auto const key = key_(*first);
+		++first;
+		while (first != last and key_(*first) == key)
+			++first;
+		return first;
+	}
+
+	/// Galloping search: probe at exponential steps, then binary search the last step
+	template<typename I, typename E>
+	I find_end(I first, E last, RAH_STD::random_access_iterator_tag)
+	{
+		if (first == last)
+			return first;
+		auto const key = key_(*first);
+		intptr_t step = 1;
+		while (last - first > step and key_(first[step]) == key)
+		{
+			first += step;
+			step *= 2;
+		}
+		I const upper = last - first > step ? first + step : last;
+		++first;
+		return RAH_STD::partition_point(first, upper, [&](auto&& value) { return key_(value) == key; });
+	}
+};
+} // namespace details
+/// \endcond
+
+/// @see rah::view::chunk_by
+/// @see rah::view::group_by
+template<typename R, typename F>
+struct chunk_by_iterator : iterator_facade<chunk_by_iterator<R, F>, iterator_range<range_begin_type_t<R>>, RAH_STD::forward_iterator_tag>
+{
+	range_begin_type_t<R> iter_;
+	range_begin_type_t<R> iter2_;
+	range_end_type_t<R> end_;
+	RAH_NAMESPACE::details::optional<F> findChunkEnd_;
+
+	chunk_by_iterator() = default;
+	RAH_CONSTEXPR17 chunk_by_iterator(
+		range_begin_type_t<R> const& iter,
+		range_end_type_t<R> const& end,
+		F const& findChunkEnd)
+		: iter_(iter), iter2_(iter), end_(end), findChunkEnd_(findChunkEnd)
+	{
+		iter2_ = (*findChunkEnd_)(iter_, end_);
+	}
+
+	RAH_CONSTEXPR17 void increment()
+	{
+		iter_ = iter2_;
+		iter2_ = (*findChunkEnd_)(iter_, end_);
+	}
+
+	RAH_CONSTEXPR17 auto dereference() const { return make_iterator_range(iter_, iter2_); }
+	RAH_CONSTEXPR17 bool equal(chunk_by_iterator const& other) const { return iter_ == other.iter_; }
+};
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename R, typename F> RAH_CONSTEXPR17 auto make_chunk_by(R&& range, F const& findChunkEnd)
+{
+	return adapt(RAH_STD::forward<R>(range), [findChunkEnd](auto view)
+		{
+			auto iter = rah_begin(view);
+			auto endIter = rah_end(view);
+			using iterator = chunk_by_iterator<decltype(view), F>;
+			return iterator_range<iterator>{ { iter, endIter, findChunkEnd }, { endIter, endIter, findChunkEnd } };
+		});
+}
 } // namespace details
 /// \endcond
 
-template<typename IterTuple>
-struct zip_iterator : iterator_facade<
-	zip_iterator<IterTuple>,
-	decltype(details::deref(fake<IterTuple>())),
-	RAH_STD::bidirectional_iterator_tag
->
+/// @brief Split the range in sub-ranges of adjacent elements, where @b pred(prev, next) is true for each pair of
+/// adjacent elements.
+/// @remark Each sub-range is an iterator_range, found in one forward pass.
+///
+/// @snippet test.cpp chunk_by
+template<typename R, typename P, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+RAH_CONSTEXPR17 auto chunk_by(R&& range, P&& pred)
+{
+	using Predicate = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<P>>;
+	return RAH_INSTRUMENT_VIEW("chunk_by", details::make_chunk_by(RAH_STD::forward<R>(range), details::adjacent_chunk_end<Predicate>{ pred }));
+}
+
+/// @see rah::view::chunk_by(R&& range, P&& pred)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp chunk_by_pipeable
+template<typename P> RAH_CONSTEXPR17 auto chunk_by(P&& pred)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return chunk_by(RAH_STD::forward<decltype(range)>(range), pred);
+		});
+}
+
+// ************************************ group_by **************************************************
+
+/// @brief Split the range in sub-ranges of adjacent elements having the same key.
+/// Typically used on a range sorted by key.
+/// @remark The sub-ranges are found in one forward pass, on any kind of range.
+/// Use group_by_sorted when the elements with the same key are known to be adjacent.
+///
+/// @snippet test.cpp group_by
+template<typename R, typename K, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+RAH_CONSTEXPR17 auto group_by(R&& range, K&& key)
+{
+	using KeyFunc = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<K>>;
+	return RAH_INSTRUMENT_VIEW("group_by", details::make_chunk_by(RAH_STD::forward<R>(range), details::key_chunk_end<KeyFunc>{ key }));
+}
+
+/// @see rah::view::group_by(R&& range, K&& key)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp group_by_pipeable
+template<typename K> RAH_CONSTEXPR17 auto group_by(K&& key)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return group_by(RAH_STD::forward<decltype(range)>(range), key);
+		});
+}
+
+/// @brief Split the range in sub-ranges of elements having the same key, like group_by.
+/// @pre All elements with the same key are adjacent (like in a range sorted by key)
+/// @remark On random access ranges, the end of each sub-range is found by galloping search,
+/// so a sub-range of N elements only need O(log N) calls to @b key. Interesting for long runs and a cheap @b key.
+///
+/// @snippet test.cpp group_by_sorted
+template<typename R, typename K, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+RAH_CONSTEXPR17 auto group_by_sorted(R&& range, K&& key)
 {
-	IterTuple iters_;
-	zip_iterator() = default;
-	zip_iterator(IterTuple const& iters) : iters_(iters) {}
-	void increment() { details::for_each(iters_, [](auto& iter) { ++iter; }); }
-	void advance(intptr_t val) { for_each(iters_, [val](auto& iter) { iter += val; }); }
-	void decrement() { details::for_each(iters_, [](auto& iter) { --iter; }); }
-	auto dereference() const { return details::deref(iters_); }
-	auto distance_to(zip_iterator const& other) const { return RAH_STD::get<0>(iters_) - RAH_STD::get<0>(other.iters_); }
-	bool equal(zip_iterator const& other) const { return details::equal(iters_, other.iters_); }
-};
+	using KeyFunc = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<K>>;
+	return RAH_INSTRUMENT_VIEW("group_by_sorted",
+		details::make_chunk_by(RAH_STD::forward<R>(range), details::key_chunk_end<KeyFunc, true>{ key }));
+}
 
-template<typename ...R> auto zip(R&&... _ranges)
+/// @see rah::view::group_by_sorted(R&& range, K&& key)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp group_by_sorted_pipeable
+template<typename K> RAH_CONSTEXPR17 auto group_by_sorted(K&& key)
 {
-	auto views = RAH_STD::make_tuple(all(RAH_STD::forward<R>(_ranges))...);
-	auto iterTup = details::transform_each(views, [](auto&& v){ return rah_begin(v);});
-	auto endTup = details::transform_each(views, [](auto&& v){ return rah_end(v);});
-	return iterator_range<zip_iterator<decltype(iterTup)>>{ { iterTup }, { endTup }};
+	return make_pipeable([=](auto&& range)
+		{
+			return group_by_sorted(RAH_STD::forward<decltype(range)>(range), key);
+		});
 }
 
-// ************************************ chunk *****************************************************
+// ************************************ distinct **************************************************
 
-template<typename R>
-struct chunk_iterator : iterator_facade<chunk_iterator<R>, iterator_range<range_begin_type_t<R>>, RAH_STD::forward_iterator_tag>
+/// @see rah::view::distinct
+template<typename V>
+struct distinct_iterator : iterator_facade<distinct_iterator<V>, typename V::value_type const&, RAH_STD::input_iterator_tag>
 {
-	range_begin_type_t<R> iter_;
-	range_begin_type_t<R> iter2_;
-	range_end_type_t<R> end_;
-	size_t step_;
+	using base_iterator = range_begin_type_t<typename V::base_view>;
+	V const* view_ = nullptr;
+	base_iterator iter_;
+	size_t index_ = 0; ///< Index of the current value in the seen-set
 
-	chunk_iterator() = default;
-	chunk_iterator(
-		range_begin_type_t<R> const& iter,
-		range_begin_type_t<R> const& iter2,
-		range_end_type_t<R> const& end,
-		size_t step = 0)
-		: iter_(iter), iter2_(iter2), end_(end), step_(step)
+	distinct_iterator() = default;
+	distinct_iterator(V const* view, base_iterator iter) : view_(view), iter_(iter)
+	{
+		next_value();
+	}
+
+	void next_value()
 	{
+		auto const endIter = rah_end(view_->base_);
+		for (; iter_ != endIter; ++iter_)
+		{
+			auto const inserted = view_->seen_.insert(*iter_);
+			if (inserted.second)
+			{
+				index_ = inserted.first - view_->seen_.begin();
+				break;
+			}
+		}
 	}
 
 	void increment()
 	{
-		iter_ = iter2_;
-		for (size_t i = 0; i != step_ and iter2_ != end_; ++i)
-			++iter2_;
+		++iter_;
+		next_value();
+	}
+	auto dereference() const -> typename V::value_type const& { return view_->seen_.begin()[index_]; }
+	bool equal(distinct_iterator const& other) const { return iter_ == other.iter_; }
+};
+
+/// @see rah::view::distinct
+template<typename R, typename H, typename E, typename A = RAH_STD::allocator<RAH_STD::remove_cv_t<range_value_type_t<R>>>>
+struct distinct_view
+{
+	static constexpr bool is_view = true; ///< See details::is_movable_container
+	using base_view = R;
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using iterator = distinct_iterator<distinct_view>;
+
+	R base_;
+	mutable flat_hash_set<value_type, H, E, A> seen_;
+
+	distinct_view(R base, H const& hash, E const& equal, A const& alloc = A())
+		: base_(RAH_STD::move(base))
+		, seen_(0, hash, equal, alloc)
+	{
 	}
 
-	auto dereference() const { return make_iterator_range(iter_, iter2_); }
-	bool equal(chunk_iterator const& other) const { return iter_ == other.iter_; }
+	/// Start a new iteration, forgetting the previously seen values
+	iterator begin() const
+	{
+		seen_.clear();
+		seen_.reserve(RAH_NAMESPACE::size_hint(base_));
+		return { this, rah_begin(base_) };
+	}
+	iterator end() const
+	{
+		iterator iter;
+		iter.iter_ = rah_end(base_);
+		return iter;
+	}
 };
 
-template<typename R> auto chunk(R&& range, size_t step)
+/// @brief Remove the duplicate elements of the range, keeping only the first occurrence of each value.
+/// The order of elements is preserved.
+/// @remark Seen values are copied into a rah::flat_hash_set, preallocated using rah::size_hint.
+/// @remark The view is single-pass (its iterators are input iterators, sharing the seen-set):
+/// calling begin() restart the iteration, and the view must outlive its iterators.
+///
+/// @snippet test.cpp rah::view::distinct
+template<
+	typename R,
+	typename H = RAH_STD::hash<RAH_STD::remove_cv_t<range_value_type_t<R>>>,
+	typename E = RAH_STD::equal_to<RAH_STD::remove_cv_t<range_value_type_t<R>>>,
+	typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto distinct(R&& range, H&& hash = {}, E&& equal = {})
+{
+	auto view = all(RAH_STD::forward<R>(range));
+	using Hash = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<H>>;
+	using Equal = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<E>>;
+	return distinct_view<decltype(view), Hash, Equal>(RAH_STD::move(view), hash, equal);
+}
+
+/// @brief Remove the duplicate elements of the range, with the seen-set allocated using @b alloc
+/// @param alloc An allocator, a pointer to a rah::arena, or a pointer to a RAH_STD::pmr::memory_resource.
+///
+/// @snippet test.cpp rah::view::distinct_alloc
+template<typename R, typename H, typename E, typename A, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto distinct(R&& range, H&& hash, E&& equal, A const& alloc)
 {
 	auto view = all(RAH_STD::forward<R>(range));
-	auto iter = rah_begin(view);
-	auto endIter = rah_end(view);
-	using iterator = chunk_iterator<RAH_STD::remove_reference_t<R>>;
-	iterator begin = { iter, iter, endIter, step };
-	begin.increment();
-	return iterator_range<iterator>{ { begin }, { endIter, endIter, endIter, step }};
+	using Hash = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<H>>;
+	using Equal = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<E>>;
+	using Alloc = RAH_NAMESPACE::details::allocator_for_t<A, RAH_STD::remove_cv_t<range_value_type_t<R>>>;
+	return distinct_view<decltype(view), Hash, Equal, Alloc>(RAH_STD::move(view), hash, equal, Alloc(alloc));
+}
+
+/// @see rah::view::distinct(R&& range, H&& hash, E&& equal)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::distinct_pipeable
+inline auto distinct()
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return distinct(RAH_STD::forward<decltype(range)>(range));
+		});
 }
 
-inline auto chunk(size_t step)
+/// @see rah::view::distinct(R&& range, H&& hash, E&& equal)
+/// @remark pipeable syntax
+template<typename H, typename E, typename = RAH_STD::enable_if_t<not is_range<H>::value>>
+auto distinct(H&& hash, E&& equal)
 {
 	return make_pipeable([=](auto&& range)
 		{
-			return chunk(RAH_STD::forward<decltype(range)>(range), step);
+			return distinct(RAH_STD::forward<decltype(range)>(range), hash, equal);
+		});
+}
+
+/// @see rah::view::distinct(R&& range, H&& hash, E&& equal, A const& alloc)
+/// @remark pipeable syntax
+template<typename H, typename E, typename A, typename = RAH_STD::enable_if_t<not is_range<H>::value>>
+auto distinct(H&& hash, E&& equal, A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return distinct(RAH_STD::forward<decltype(range)>(range), hash, equal, alloc);
 		});
 }
 
 // ***************************************** filter ***********************************************
 
 template<typename R, typename F>
-struct filter_iterator : iterator_facade<filter_iterator<R, F>, range_ref_type_t<R>, RAH_STD::bidirectional_iterator_tag>
+struct filter_iterator : iterator_facade<
+	filter_iterator<R, F>,
+	range_ref_type_t<R>,
+	common_iterator_tag<RAH_STD::bidirectional_iterator_tag, range_iter_categ_t<R>>>
 {
 	using Iterator = range_begin_type_t<R>;
 	Iterator begin_;
 	Iterator iter_;
 	range_end_type_t<R> end_;
 	RAH_NAMESPACE::details::optional<F> func_;
-	typename RAH_STD::iterator_traits<range_begin_type_t<R>>::pointer value_pointer_;
+	typename RAH_STD::iterator_traits<range_begin_type_t<R>>::pointer value_pointer_{};
 
 	// Get a pointer to the pointed value,
 	//   OR a pointer to a copy of the pointed value (when not a reference iterator)
 	template <class I> struct get_pointer
 	{
-		static auto get(I const& iter) { return iter.operator->(); }
+		static RAH_CONSTEXPR17 auto get(I const& iter) { return iter.operator->(); }
 	};
 	template <class V> struct get_pointer<V*>
 	{
-		static auto get(V* ptr) { return ptr; }
+		static RAH_CONSTEXPR17 auto get(V* ptr) { return ptr; }
 	};
 
 	filter_iterator() = default;
-	filter_iterator(
+	RAH_CONSTEXPR17 filter_iterator(
 		range_begin_type_t<R> const& begin,
 		range_begin_type_t<R> const& iter,
 		range_end_type_t<R> const& end,
@@ -1530,7 +4734,7 @@ struct filter_iterator : iterator_facade<filter_iterator<R, F>, range_ref_type_t
 		next_value();
 	}
 
-	void next_value()
+	RAH_CONSTEXPR17 void next_value()
 	{
 		while (iter_ != end_ && not (*func_)(*(value_pointer_ = get_pointer<Iterator>::get(iter_))))
 		{
@@ -1539,13 +4743,13 @@ struct filter_iterator : iterator_facade<filter_iterator<R, F>, range_ref_type_t
 		}
 	}
 
-	void increment()
+	RAH_CONSTEXPR17 void increment()
 	{
 		++iter_;
 		next_value();
 	}
 
-	void decrement()
+	RAH_CONSTEXPR17 void decrement()
 	{
 		do
 		{
@@ -1553,23 +4757,26 @@ struct filter_iterator : iterator_facade<filter_iterator<R, F>, range_ref_type_t
 		} while (not (*func_)(*iter_) && iter_ != begin_);
 	}
 
-	auto dereference() const -> decltype(*iter_) { return *value_pointer_; }
-	bool equal(filter_iterator const& other) const { return iter_ == other.iter_; }
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*iter_) { return *value_pointer_; }
+	RAH_CONSTEXPR17 bool equal(filter_iterator const& other) const { return iter_ == other.iter_; }
 };
 
-template<typename R, typename P> auto filter(R&& range, P&& pred)
+template<typename R, typename P> RAH_CONSTEXPR17 auto filter(R&& range, P&& pred)
 {
-	auto view = all(RAH_STD::forward<R>(range));
-	auto iter = rah_begin(view);
-	auto endIter = rah_end(view);
 	using Predicate = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<P>>;
-	return iterator_range<filter_iterator<RAH_STD::remove_reference_t<R>, Predicate>>{
-		{ iter, iter, endIter, pred },
-		{ iter, endIter, endIter, pred }
-	};
+	return RAH_INSTRUMENT_VIEW("filter", details::adapt(RAH_STD::forward<R>(range),
+		[pred = Predicate(RAH_STD::forward<P>(pred))](auto view)
+		{
+			auto iter = rah_begin(view);
+			auto endIter = rah_end(view);
+			return iterator_range<filter_iterator<decltype(view), Predicate>>{
+				{ iter, iter, endIter, pred },
+				{ iter, endIter, endIter, pred }
+			};
+		}));
 }
 
-template<typename P> auto filter(P&& pred)
+template<typename P> RAH_CONSTEXPR17 auto filter(P&& pred)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1587,7 +4794,7 @@ struct concat_iterator : iterator_facade<concat_iterator<IterPair, V>, V, RAH_ST
 	size_t range_index_;
 
 	concat_iterator() = default;
-	concat_iterator(IterPair const& iter, IterPair const& end, size_t range_index)
+	RAH_CONSTEXPR17 concat_iterator(IterPair const& iter, IterPair const& end, size_t range_index)
 		: iter_(iter), end_(end), range_index_(range_index)
 	{
 		if (range_index == 0)
@@ -1597,7 +4804,7 @@ struct concat_iterator : iterator_facade<concat_iterator<IterPair, V>, V, RAH_ST
 		}
 	}
 
-	void increment()
+	RAH_CONSTEXPR17 void increment()
 	{
 		if (range_index_ == 0)
 		{
@@ -1610,7 +4817,7 @@ struct concat_iterator : iterator_facade<concat_iterator<IterPair, V>, V, RAH_ST
 			++RAH_STD::get<1>(iter_);
 	}
 
-	auto dereference() const -> decltype(*RAH_STD::get<0>(iter_))
+	RAH_CONSTEXPR17 auto dereference() const -> decltype(*RAH_STD::get<0>(iter_))
 	{
 		if (range_index_ == 0)
 			return *RAH_STD::get<0>(iter_);
@@ -1618,7 +4825,7 @@ struct concat_iterator : iterator_facade<concat_iterator<IterPair, V>, V, RAH_ST
 			return *RAH_STD::get<1>(iter_);
 	}
 
-	bool equal(concat_iterator const& other) const
+	RAH_CONSTEXPR17 bool equal(concat_iterator const& other) const
 	{
 		if (range_index_ != other.range_index_)
 			return false;
@@ -1630,46 +4837,54 @@ struct concat_iterator : iterator_facade<concat_iterator<IterPair, V>, V, RAH_ST
 };
 
 /// @brief return the same range
-template<typename R1> auto concat(R1&& range1)
+template<typename R1> RAH_CONSTEXPR17 auto concat(R1&& range1)
 {
 	return RAH_STD::forward<R1>(range1);
 }
 
-template<typename R1, typename R2> auto concat(R1&& range1, R2&& range2)
+template<typename R1, typename R2> RAH_CONSTEXPR17 auto concat(R1&& range1, R2&& range2)
 {
-	auto view1 = all(RAH_STD::forward<R1>(range1));
-	auto view2 = all(RAH_STD::forward<R2>(range2));
-	auto begin_range1 = RAH_STD::make_pair(rah_begin(view1), rah_begin(view2));
-	auto begin_range2 = RAH_STD::make_pair(rah_end(view1), rah_end(view2));
-	auto end_range1 = RAH_STD::make_pair(rah_end(view1), rah_end(view2));
-	auto end_range2 = RAH_STD::make_pair(rah_end(view1), rah_end(view2));
-	return iterator_range<
-		concat_iterator<
-		RAH_STD::pair<range_begin_type_t<R1>, range_begin_type_t<R2>>,
-		range_ref_type_t<R1>>>
+	auto makeView = [](auto view1, auto view2)
 	{
-		{ begin_range1, begin_range2, 0 },
-		{ end_range1, end_range2, 1 },
+		auto begin_range1 = RAH_STD::make_pair(rah_begin(view1), rah_begin(view2));
+		auto begin_range2 = RAH_STD::make_pair(rah_end(view1), rah_end(view2));
+		auto end_range1 = RAH_STD::make_pair(rah_end(view1), rah_end(view2));
+		auto end_range2 = RAH_STD::make_pair(rah_end(view1), rah_end(view2));
+		return iterator_range<
+			concat_iterator<
+			RAH_STD::pair<range_begin_type_t<decltype(view1)>, range_begin_type_t<decltype(view2)>>,
+			range_ref_type_t<decltype(view1)>>>
+		{
+			{ begin_range1, begin_range2, 0 },
+			{ end_range1, end_range2, 1 },
+		};
 	};
+	return RAH_INSTRUMENT_VIEW("concat",
+		details::adapt_all(makeView, RAH_STD::forward<R1>(range1), RAH_STD::forward<R2>(range2)));
 }
 
 /// @see rah::view::concat(R1&& range1, R2&& range2)
 template<typename R1, typename R2, typename ...Ranges>
-auto concat(R1&& range1, R2&& range2, Ranges&&... ranges)
+RAH_CONSTEXPR17 auto concat(R1&& range1, R2&& range2, Ranges&&... ranges)
 {
 	return concat(concat(RAH_STD::forward<R1>(range1), RAH_STD::forward<R2>(range2)), ranges...);
 }
 
 // *************************** enumerate **********************************************************
 
-template<typename R> auto enumerate(R&& range)
+template<typename R> RAH_CONSTEXPR17 auto enumerate(R&& range)
 {
-	auto view = all(RAH_STD::forward<R>(range));
-	size_t const dist = RAH_STD::distance(rah_begin(view), rah_end(view));
-	return zip(iota(size_t(0), dist), view);
+	return details::adapt(RAH_STD::forward<R>(range), [](auto view)
+		{
+			size_t const dist = RAH_STD::distance(rah_begin(view), rah_end(view));
+			auto pairs = zip(iota(size_t(0), dist), view);
+			// The iota has the size of view
+			using range = RAH_NAMESPACE::details::extent_range<range_begin_type_t<decltype(pairs)>, decltype(view)>;
+			return range{ rah_begin(pairs), rah_end(pairs) };
+		});
 }
 
-inline auto enumerate()
+inline RAH_CONSTEXPR17 auto enumerate()
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1692,12 +4907,12 @@ struct get_tuple_elt
 	}
 };
 
-template<typename R> auto map_value(R&& range)
+template<typename R> RAH_CONSTEXPR17 auto map_value(R&& range)
 {
 	return transform(RAH_STD::forward<R>(range), get_tuple_elt<1>{});
 }
 
-inline auto map_value()
+inline RAH_CONSTEXPR17 auto map_value()
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1707,12 +4922,12 @@ inline auto map_value()
 
 // ****************************** map_key **********************************************************
 
-template<typename R> auto map_key(R&& range)
+template<typename R> RAH_CONSTEXPR17 auto map_key(R&& range)
 {
 	return RAH_NAMESPACE::view::transform(RAH_STD::forward<R>(range), get_tuple_elt<0>{});
 }
 
-inline auto map_key()
+inline RAH_CONSTEXPR17 auto map_key()
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1722,21 +4937,55 @@ inline auto map_key()
 
 // *********************************** sort *******************************************************
 
+/// \cond PRIVATE
+namespace details
+{
+/// The container returned by view::sort: @b C, or a RAH_STD::vector using the allocator @b A if @b C is void
+template<typename C, typename R, typename A = void>
+using sorted_container_t = RAH_STD::conditional_t<
+	RAH_STD::is_same<C, void>::value,
+	RAH_STD::vector<
+		RAH_STD::remove_cv_t<range_value_type_t<R>>,
+		RAH_NAMESPACE::details::allocator_for_t<A, RAH_STD::remove_cv_t<range_value_type_t<R>>>>,
+	C>;
+} // namespace details
+/// \endcond
+
 /// @brief Make a sorted view of a range
 /// @return A view that is sorted
 /// @remark This view is not lasy. The sorting is computed immediately.
+/// @remark The result is a @b C, which have to be a random access container, or a RAH_STD::vector
+/// by default. A rvalue of this type is moved into the result then sorted in place, without copy.
+/// The elements of other rvalue containers are moved.
 ///
 /// @snippet test.cpp rah::view::sort
 /// @snippet test.cpp rah::view::sort_pred
-template<typename R, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+/// @snippet test.cpp rah::view::sort_rvalue
+template<typename C = void, typename R, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
 auto sort(R&& range, P&& pred = {})
 {
-	using value_type = range_value_type_t<R>;
-	using Container = typename RAH_STD::vector<RAH_STD::remove_cv_t<value_type>>;
-	Container result;
-	auto view = all(RAH_STD::forward<R>(range));
-	result.reserve(RAH_STD::distance(rah_begin(view), rah_end(view)));
-	RAH_STD::copy(rah_begin(view), rah_end(view), RAH_STD::back_inserter(result));
+	using Container = details::sorted_container_t<C, R>;
+	Container result = RAH_NAMESPACE::details::take_container<Container>(RAH_STD::forward<R>(range));
+	RAH_STD::sort(rah_begin(result), rah_end(result), pred);
+	return result;
+}
+
+/// @brief Make a sorted view of a range, allocated using @b alloc
+/// @param alloc An allocator, a pointer to a rah::arena, or a pointer to a RAH_STD::pmr::memory_resource.
+/// @remark When @b C is not given, the result is a RAH_STD::vector using the matching allocator
+/// (rah::arena_allocator for an arena, RAH_STD::pmr::polymorphic_allocator for a memory_resource)
+///
+/// @snippet test.cpp rah::view::sort_alloc
+template<
+	typename C = void,
+	typename R,
+	typename P,
+	typename A,
+	typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto sort(R&& range, P&& pred, A const& alloc)
+{
+	using Container = details::sorted_container_t<C, R, A>;
+	Container result = RAH_NAMESPACE::details::take_container<Container>(RAH_STD::forward<R>(range), alloc);
 	RAH_STD::sort(rah_begin(result), rah_end(result), pred);
 	return result;
 }
@@ -1748,23 +4997,424 @@ auto sort(R&& range, P&& pred = {})
 ///
 /// @snippet test.cpp rah::view::sort_pipeable
 /// @snippet test.cpp rah::view::sort_pred_pipeable
-template<typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+/// @snippet test.cpp rah::view::sort_container_pipeable
+template<typename C = void, typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
 auto sort(P&& pred = {})
 {
 	return make_pipeable([=](auto&& range)
 		{
-			return view::sort(RAH_STD::forward<decltype(range)>(range), pred);
+			return view::sort<C>(RAH_STD::forward<decltype(range)>(range), pred);
+		});
+}
+
+/// @brief Make a sorted view of a range, allocated using @b alloc
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::sort_alloc_pipeable
+template<typename C = void, typename P, typename A, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort(P&& pred, A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return view::sort<C>(RAH_STD::forward<decltype(range)>(range), pred, alloc);
+		});
+}
+
+// *********************************** lazy_sort *******************************************************
+
+/// @see rah::view::lazy_sort
+template<typename V>
+struct lazy_sort_iterator : iterator_facade<lazy_sort_iterator<V>, typename V::value_type&, RAH_STD::forward_iterator_tag>
+{
+	V const* view_ = nullptr;
+	size_t index_ = 0;
+
+	lazy_sort_iterator() = default;
+	lazy_sort_iterator(V const* view, size_t index) : view_(view), index_(index) {}
+
+	void increment() { ++index_; }
+	auto dereference() const -> typename V::value_type& { return view_->get(index_); }
+	bool equal(lazy_sort_iterator const& other) const { return index_ == other.index_; }
+};
+
+/// @see rah::view::lazy_sort
+template<typename T, typename P, typename A = RAH_STD::allocator<T>>
+struct lazy_sort_view
+{
+	static constexpr bool is_view = true; ///< See details::is_movable_container
+	using value_type = T;
+	using iterator = lazy_sort_iterator<lazy_sort_view>;
+
+	// The unsorted part is a heap with the smallest element in front.
+	// Each popped element is moved at the back of the heap, so the sorted part grows from the end.
+	mutable RAH_STD::vector<T, A> buffer_;
+	mutable size_t sortedCount_ = 0;
+	mutable P pred_;
+
+	lazy_sort_view(RAH_STD::vector<T, A>&& buffer, P const& pred)
+		: buffer_(RAH_STD::move(buffer))
+		, pred_(pred)
+	{
+		RAH_STD::make_heap(rah_begin(buffer_), rah_end(buffer_), heap_pred());
+	}
+
+	auto heap_pred() const
+	{
+		P* pred = &pred_;
+		return [pred](auto&& a, auto&& b) { return (*pred)(b, a); };
+	}
+
+	/// Get the element at the given index in the sorted sequence. Sort up to index if needed.
+	T& get(size_t index) const
+	{
+		size_t const size = buffer_.size();
+		assert(index < size);
+		while (sortedCount_ <= index)
+		{
+			RAH_STD::pop_heap(rah_begin(buffer_), rah_begin(buffer_) + (size - sortedCount_), heap_pred());
+			++sortedCount_;
+		}
+		return buffer_[size - 1 - index];
+	}
+
+	iterator begin() const { return { this, 0 }; }
+	iterator end() const { return { this, buffer_.size() }; }
+};
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename R, typename P, typename T, typename A>
+auto lazy_sort(R&& range, P&& pred, RAH_STD::vector<T, A>&& buffer)
+{
+	using Predicate = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<P>>;
+	auto view = all(RAH_STD::forward<R>(range));
+	buffer.reserve(RAH_STD::distance(rah_begin(view), rah_end(view)));
+	RAH_STD::copy(rah_begin(view), rah_end(view), RAH_STD::back_inserter(buffer));
+	return lazy_sort_view<T, Predicate, A>(RAH_STD::move(buffer), pred);
+}
+} // namespace details
+/// \endcond
+
+/// @brief Make a sorted view of a range, sorting only when elements are read
+/// @return A view that is sorted
+/// @remark The range is copied and turned into a heap in O(n). Reading the k first elements
+/// then cost O(k log n), which make it fast to get the "top k" of a range.
+/// @remark Iterating the view modify its internal buffer, so the view must outlive its iterators.
+///
+/// @snippet test.cpp rah::view::lazy_sort
+/// @snippet test.cpp rah::view::lazy_sort_pred
+template<typename R, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto lazy_sort(R&& range, P&& pred = {})
+{
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	return details::lazy_sort(RAH_STD::forward<R>(range), pred, RAH_STD::vector<value_type>());
+}
+
+/// @brief Make a sorted view of a range, sorting only when elements are read, with the buffer
+/// allocated using @b alloc
+/// @param alloc An allocator, a pointer to a rah::arena, or a pointer to a RAH_STD::pmr::memory_resource.
+///
+/// @snippet test.cpp rah::view::lazy_sort_alloc
+template<typename R, typename P, typename A, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto lazy_sort(R&& range, P&& pred, A const& alloc)
+{
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using Alloc = RAH_NAMESPACE::details::allocator_for_t<A, value_type>;
+	return details::lazy_sort(RAH_STD::forward<R>(range), pred, RAH_STD::vector<value_type, Alloc>(Alloc(alloc)));
+}
+
+/// @brief Make a sorted view of a range, sorting only when elements are read
+/// @return A view that is sorted
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::lazy_sort_pipeable
+/// @snippet test.cpp rah::view::lazy_sort_pred_pipeable
+template<typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto lazy_sort(P&& pred = {})
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return view::lazy_sort(RAH_STD::forward<decltype(range)>(range), pred);
+		});
+}
+
+/// @see rah::view::lazy_sort(R&& range, P&& pred, A const& alloc)
+/// @remark pipeable syntax
+template<typename P, typename A, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto lazy_sort(P&& pred, A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return view::lazy_sort(RAH_STD::forward<decltype(range)>(range), pred, alloc);
+		});
+}
+
+// *********************************** sort_by *********************************************************
+
+/// @brief Make a view of a range, sorted by the keys returned by @b key, compared with @b pred
+/// @return A view that is sorted
+/// @remark This view is not lasy. The sorting is computed immediately.
+/// @remark The key of each element is computed only once, so this is faster than
+/// a predicate calling @b key when the key is costly to compute.
+/// @remark Like in view::sort, the result is a @b C, or a RAH_STD::vector by default.
+/// A rvalue of this type is moved into the result.
+///
+/// @snippet test.cpp rah::view::sort_by
+template<
+	typename C = void,
+	typename R,
+	typename P,
+	typename K,
+	RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
+auto sort_by(R&& range, P&& pred, K&& key)
+{
+	using Container = details::sorted_container_t<C, R>;
+	Container result = RAH_NAMESPACE::details::take_container<Container>(RAH_STD::forward<R>(range));
+	RAH_NAMESPACE::details::sort_by_cached_key(rah_begin(result), rah_end(result), key, pred);
+	return result;
+}
+
+/// @brief Make a view of a range, sorted by the keys returned by @b key, using rah::is_lesser
+/// @see rah::view::sort_by(R&& range, P&& pred, K&& key)
+template<typename C = void, typename R, typename K, RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
+auto sort_by(R&& range, K&& key)
+{
+	return view::sort_by<C>(RAH_STD::forward<R>(range), is_lesser(), RAH_STD::forward<K>(key));
+}
+
+/// @brief Make a view of a range, sorted by the keys returned by @b key, and allocated using @b alloc
+/// @param alloc An allocator, a pointer to a rah::arena, or a pointer to a RAH_STD::pmr::memory_resource.
+/// @see rah::view::sort(R&& range, P&& pred, A const& alloc)
+template<
+	typename C = void,
+	typename R,
+	typename P,
+	typename K,
+	typename A,
+	typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto sort_by(R&& range, P&& pred, K&& key, A const& alloc)
+{
+	using Container = details::sorted_container_t<C, R, A>;
+	Container result = RAH_NAMESPACE::details::take_container<Container>(RAH_STD::forward<R>(range), alloc);
+	RAH_NAMESPACE::details::sort_by_cached_key(rah_begin(result), rah_end(result), key, pred);
+	return result;
+}
+
+/// @brief Make a view of a range, sorted by the keys returned by @b key
+/// @return A view that is sorted
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::view::sort_by_pipeable
+template<typename C = void, typename P, typename K, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort_by(P&& pred, K&& key)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return view::sort_by<C>(RAH_STD::forward<decltype(range)>(range), pred, key);
+		});
+}
+
+/// @see rah::view::sort_by(R&& range, K&& key)
+/// @remark pipeable syntax
+template<typename C = void, typename K, typename = RAH_STD::enable_if_t<not is_range<K>::value>>
+auto sort_by(K&& key)
+{
+	return view::sort_by<C>(is_lesser(), RAH_STD::forward<K>(key));
+}
+
+/// @see rah::view::sort_by(R&& range, P&& pred, K&& key, A const& alloc)
+/// @remark pipeable syntax
+template<typename C = void, typename P, typename K, typename A, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort_by(P&& pred, K&& key, A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return view::sort_by<C>(RAH_STD::forward<decltype(range)>(range), pred, key, alloc);
 		});
 }
 
-} // namespace view
-
+} // namespace view
+
+// ****************************************** describe ********************************************
+
+/// @brief Description of a stage of a pipeline. Given by rah::describe.
+struct stage_info
+{
+	char const* name; ///< Name of the view, like "transform". "iterator" or "pointer" for the input ranges.
+	size_t depth; ///< 0 for the last stage of the pipeline, 1 for its inputs, and so on
+	size_t iterator_size; ///< sizeof the iterator
+	char const* category; ///< "input", "forward", "bidirectional" or "random_access"
+	bool sized; ///< The size is known in constant time (random access)
+	bool contiguous; ///< The elements are contiguous in memory
+	bool borrowed; ///< The iterators stay valid when the view is destroyed
+	bool proxy_reference; ///< Dereferencing yield a value (or a proxy), not a real reference
+};
+
+/// \cond PRIVATE
+namespace details
+{
+constexpr char const* category_name(RAH_STD::input_iterator_tag) { return "input"; }
+constexpr char const* category_name(RAH_STD::output_iterator_tag) { return "output"; }
+constexpr char const* category_name(RAH_STD::forward_iterator_tag) { return "forward"; }
+constexpr char const* category_name(RAH_STD::bidirectional_iterator_tag) { return "bidirectional"; }
+constexpr char const* category_name(RAH_STD::random_access_iterator_tag) { return "random_access"; }
+
+/// Name of the view of an iterator, and the iterators it adapts
+template<typename I>
+struct stage_traits
+{
+	static constexpr char const* name = RAH_STD::is_pointer<I>::value ? "pointer" : "iterator";
+	using bases = RAH_STD::tuple<>;
+	static constexpr bool borrowed = true;
+};
+
+#define RAH_STAGE_TRAITS(TEMPLATE_PARAMS, ITERATOR, NAME, BORROWED, ...) \
+template<RAH_STRIP_PARENS TEMPLATE_PARAMS> \
+struct stage_traits<RAH_STRIP_PARENS ITERATOR> \
+{ \
+	static constexpr char const* name = NAME; \
+	using bases = RAH_STD::tuple<__VA_ARGS__>; \
+	static constexpr bool borrowed = BORROWED; \
+};
+#define RAH_STRIP_PARENS(...) __VA_ARGS__
+
+RAH_STAGE_TRAITS((typename I), (view::stats_iterator<I>), "counted_stats", true, I)
+RAH_STAGE_TRAITS((typename I), (view::timed_iterator<I>), "timed", true, I)
+RAH_STAGE_TRAITS((typename R, typename F), (view::tap_iterator<R, F>), "tap", true, range_begin_type_t<R>)
+RAH_STAGE_TRAITS((typename I, size_t N), (view::take_iterator<I, N>), "take", true, I)
+RAH_STAGE_TRAITS((typename I), (view::sliding_iterator<I>), "sliding", true, I)
+RAH_STAGE_TRAITS((typename V), (view::sliding_buffered_iterator<V>), "sliding_buffered", false,
+	range_begin_type_t<typename V::base_view>)
+RAH_STAGE_TRAITS((typename V), (view::sliding_reduce_iterator<V>), "sliding_reduce", false,
+	range_begin_type_t<typename V::base_view>)
+RAH_STAGE_TRAITS((typename I), (view::counted_iterator<I>), "counted", true, I)
+RAH_STAGE_TRAITS((typename I), (view::unbounded_iterator<I>), "unbounded", true, I)
+RAH_STAGE_TRAITS((typename T), (view::ints_iterator<T>), "ints", true)
+RAH_STAGE_TRAITS((typename T), (view::iota_iterator<T>), "iota", true)
+RAH_STAGE_TRAITS((typename V), (view::repeat_iterator<V>), "repeat", true)
+RAH_STAGE_TRAITS((typename R), (view::join_iterator<R>), "join", true,
+	range_begin_type_t<R>, range_begin_type_t<range_ref_type_t<R>>)
+RAH_STAGE_TRAITS((typename V), (view::join_owning_iterator<V>), "join", false,
+	range_begin_type_t<typename V::base_view>, range_begin_type_t<typename V::sub_range>)
+RAH_STAGE_TRAITS((typename R), (view::cycle_iterator<R>), "cycle", true, range_begin_type_t<R>)
+RAH_STAGE_TRAITS((typename F), (view::generate_iterator<F>), "generate", true)
+RAH_STAGE_TRAITS((typename R, typename F), (view::transform_iterator<R, F>), "transform", true, range_begin_type_t<R>)
+RAH_STAGE_TRAITS((typename I1, typename I2), (view::set_difference_iterator<I1, I2>), "set_difference", true, I1, I2)
+RAH_STAGE_TRAITS((typename R), (view::stride_iterator<R>), "stride", true, range_begin_type_t<R>)
+RAH_STAGE_TRAITS((typename... I, typename C), (view::zip_iterator<RAH_STD::tuple<I...>, C>), "zip", true, I...)
+RAH_STAGE_TRAITS((typename R), (view::chunk_iterator<R>), "chunk", true, range_begin_type_t<R>)
+RAH_STAGE_TRAITS((typename R, typename F), (view::chunk_by_iterator<R, F>), "chunk_by", true, range_begin_type_t<R>)
+RAH_STAGE_TRAITS((typename V), (view::distinct_iterator<V>), "distinct", false, range_begin_type_t<typename V::base_view>)
+RAH_STAGE_TRAITS((typename R, typename F), (view::filter_iterator<R, F>), "filter", true, range_begin_type_t<R>)
+RAH_STAGE_TRAITS((typename I1, typename I2, typename V), (view::concat_iterator<RAH_STD::pair<I1, I2>, V>), "concat", true,
+	I1, I2)
+RAH_STAGE_TRAITS((typename V), (view::lazy_sort_iterator<V>), "lazy_sort", false)
+RAH_STAGE_TRAITS((typename I), (RAH_STD::reverse_iterator<I>), "reverse", true, I)
+RAH_STAGE_TRAITS((typename I), (RAH_STD::move_iterator<I>), "move", true, I)
+
+#undef RAH_STAGE_TRAITS
+#undef RAH_STRIP_PARENS
+
+/// The views storing some of their ranges. The iterators of all their stages dangle when the view is destroyed.
+template<typename V> struct owns_ranges : RAH_STD::false_type {};
+template<typename C> struct owns_ranges<view::own_view<C>> : RAH_STD::true_type {};
+template<typename F, typename... V> struct owns_ranges<view::owning_view<F, V...>> : RAH_STD::true_type {};
+} // namespace details
+/// \endcond
+
+/// @brief Description of the stage of a pipeline which yield the iterator @b I
+/// @remark constexpr, so the properties of a stage can be checked by a static_assert
+///
+/// @snippet test.cpp rah::stage_info_of
+template<typename I>
+constexpr stage_info stage_info_of(size_t depth = 0)
+{
+	using category = typename RAH_STD::iterator_traits<I>::iterator_category;
+	return {
+		details::stage_traits<I>::name,
+		depth,
+		sizeof(I),
+		details::category_name(category()),
+		RAH_STD::is_base_of<RAH_STD::random_access_iterator_tag, category>::value,
+		details::is_contiguous_iterator<I>::value,
+		details::stage_traits<I>::borrowed,
+		not RAH_STD::is_reference<typename RAH_STD::iterator_traits<I>::reference>::value
+	};
+}
+
+/// \cond PRIVATE
+namespace details
+{
+template<typename I>
+void describe_stages(RAH_STD::vector<stage_info>& stages, size_t depth, bool owned);
+
+template<typename Bases, size_t... Is>
+void describe_bases(RAH_STD::vector<stage_info>& stages, size_t depth, bool owned, RAH_STD::index_sequence<Is...>)
+{
+	int const expand[] = { 0, (describe_stages<RAH_STD::tuple_element_t<Is, Bases>>(stages, depth, owned), 0)... };
+	(void)expand;
+	(void)depth;
+	(void)owned;
+}
+
+/// @param owned The view stores its ranges (see owns_ranges), so no stage is borrowed
+template<typename I>
+void describe_stages(RAH_STD::vector<stage_info>& stages, size_t depth, bool owned)
+{
+	stage_info info = stage_info_of<I>(depth);
+	info.borrowed = info.borrowed and not owned;
+	stages.push_back(info);
+	using bases = typename stage_traits<I>::bases;
+	describe_bases<bases>(stages, depth + 1, owned, RAH_STD::make_index_sequence<RAH_STD::tuple_size<bases>::value>());
+}
+} // namespace details
+/// \endcond
+
+/// @brief Describe each stage of the pipeline @b range, from the last to the inputs (depth first).
+/// Used to check that a pipeline does not degrade to forward iterators, or does not have bloated iterators.
+///
+/// @snippet test.cpp rah::describe
+template<typename R>
+RAH_STD::vector<stage_info> describe(R&& range)
+{
+	(void)range;
+	RAH_STD::vector<stage_info> stages;
+	using View = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<R>>;
+	details::describe_stages<range_begin_type_t<R>>(stages, 0, details::owns_ranges<View>::value);
+	return stages;
+}
+
+/// @brief Describe each stage of the pipeline @b range, one line by stage, indented by depth.
+///
+/// @snippet test.cpp rah::describe_string
+template<typename R>
+RAH_STD::string describe_string(R&& range)
+{
+	RAH_STD::string result;
+	for (stage_info const& stage : describe(range))
+	{
+		char line[256];
+		RAH_STD::snprintf(line, sizeof(line), "%*s%-*s size=%-3zu %-13s%s%s%s%s\n",
+			int(stage.depth * 2), "",
+			int(20 - RAH_STD::min<size_t>(stage.depth * 2, 20)), stage.name,
+			stage.iterator_size,
+			stage.category,
+			stage.sized ? " sized" : "",
+			stage.contiguous ? " contiguous" : "",
+			stage.borrowed ? "" : " not_borrowed",
+			stage.proxy_reference ? " proxy" : "");
+		result += line;
+	}
+	return result;
+}
+
 // ****************************************** empty ***********************************************
 
 /// @brief Check if the range if empty
 ///
 /// @snippet test.cpp rah::empty
-template<typename R> bool empty(R&& range)
+template<typename R> RAH_CONSTEXPR17 bool empty(R&& range)
 {
 	return rah_begin(range) == rah_end(range);
 }
@@ -1773,7 +5423,7 @@ template<typename R> bool empty(R&& range)
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::empty_pipeable
-inline auto empty()
+inline RAH_CONSTEXPR17 auto empty()
 {
 	return make_pipeable([](auto&& range) {return empty(range); });
 }
@@ -1786,9 +5436,11 @@ inline auto empty()
 template<typename R, typename V>
 auto equal_range(R&& range, V&& value, RAH_STD::enable_if_t<is_range<R>::value, int> = 0)
 {
-	auto view = view::all(RAH_STD::forward<R>(range));
-	auto pair = RAH_STD::equal_range(rah_begin(view), rah_end(view), RAH_STD::forward<V>(value));
-	return make_iterator_range(RAH_STD::get<0>(pair), RAH_STD::get<1>(pair));
+	return view::details::adapt(RAH_STD::forward<R>(range), [value](auto view)
+		{
+			auto pair = RAH_STD::equal_range(rah_begin(view), rah_end(view), value);
+			return make_iterator_range(RAH_STD::get<0>(pair), RAH_STD::get<1>(pair));
+		});
 }
 
 /// @brief Returns a range containing all elements equivalent to value in the range
@@ -1807,12 +5459,14 @@ template<typename V> auto equal_range(V&& value)
 ///
 /// @snippet test.cpp rah::equal_range_pred_0
 /// @snippet test.cpp rah::equal_range_pred
-template<typename R, typename V, typename P>
+template<typename R, typename V, typename P, RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
 auto equal_range(R&& range, V&& value, P&& pred)
 {
-	auto view = view::all(RAH_STD::forward<R>(range));
-	auto pair = RAH_STD::equal_range(rah_begin(view), rah_end(view), RAH_STD::forward<V>(value), RAH_STD::forward<P>(pred));
-	return make_iterator_range(RAH_STD::get<0>(pair), RAH_STD::get<1>(pair));
+	return view::details::adapt(RAH_STD::forward<R>(range), [value, pred](auto view)
+		{
+			auto pair = RAH_STD::equal_range(rah_begin(view), rah_end(view), value, pred);
+			return make_iterator_range(RAH_STD::get<0>(pair), RAH_STD::get<1>(pair));
+		});
 }
 
 /// @brief Returns a range containing all elements equivalent to value in the range
@@ -1829,6 +5483,36 @@ auto equal_range(V&& value, P&& pred, RAH_STD::enable_if_t<!is_range<V>::value,
 		});
 }
 
+/// @brief Returns a range containing all elements whose projection is equivalent to value
+/// @remark pred is called with the projection of an element and the value, in any order
+///
+/// @snippet test.cpp rah::equal_range_proj
+template<typename R, typename V, typename P, typename Proj>
+auto equal_range(R&& range, V&& value, P&& pred, Proj&& proj)
+{
+	return view::details::adapt(RAH_STD::forward<R>(range), [=](auto view)
+		{
+			auto first = RAH_STD::lower_bound(rah_begin(view), rah_end(view), value,
+				[&](auto&& elt, auto&& val) { return pred(proj(elt), val); });
+			auto last = RAH_STD::upper_bound(first, rah_end(view), value,
+				[&](auto&& val, auto&& elt) { return pred(val, proj(elt)); });
+			return make_iterator_range(first, last);
+		});
+}
+
+/// @brief Returns a range containing all elements whose projection is equivalent to value
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::equal_range_proj_pipeable
+template<typename V, typename P, typename Proj, RAH_STD::enable_if_t<!is_range<V>::value, int> = 0>
+auto equal_range(V&& value, P&& pred, Proj&& proj)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return equal_range(RAH_STD::forward<decltype(range)>(range), value, pred, proj);
+		});
+}
+
 // ****************************************** binary_search ***********************************************
 
 /// @brief Checks if an element equivalent to value appears within the range
@@ -1851,13 +5535,39 @@ template<typename V> auto binary_search(V&& value)
 		});
 }
 
+/// @brief Checks if an element whose projection is equivalent to value appears within the range
+/// @remark pred is called with the projection of an element and the value, in any order
+///
+/// @snippet test.cpp rah::binary_search_proj
+template<typename R, typename V, typename P, typename Proj>
+bool binary_search(R&& range, V&& value, P&& pred, Proj&& proj)
+{
+	auto const endIter = rah_end(range);
+	auto const iter = RAH_STD::lower_bound(rah_begin(range), endIter, value,
+		[&](auto&& elt, auto&& val) { return pred(proj(elt), val); });
+	return iter != endIter and not pred(value, proj(*iter));
+}
+
+/// @brief Checks if an element whose projection is equivalent to value appears within the range
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::binary_search_proj_pipeable
+template<typename V, typename P, typename Proj, RAH_STD::enable_if_t<!is_range<V>::value, int> = 0>
+auto binary_search(V&& value, P&& pred, Proj&& proj)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return binary_search(RAH_STD::forward<decltype(range)>(range), value, pred, proj);
+		});
+}
+
 // ****************************************** transform *******************************************
 
 /// @brief Applies the given function unary_op to the range rangeIn and stores the result in the range rangeOut
 ///
 /// @snippet test.cpp rah::transform3
 template<typename RI, typename RO, typename F>
-auto transform(RI&& rangeIn, RO&& rangeOut, F&& unary_op)
+RAH_CONSTEXPR20 auto transform(RI&& rangeIn, RO&& rangeOut, F&& unary_op)
 {
 	return RAH_STD::transform(rah_begin(rangeIn), rah_end(rangeIn), rah_begin(rangeOut), RAH_STD::forward<F>(unary_op));
 }
@@ -1866,7 +5576,7 @@ auto transform(RI&& rangeIn, RO&& rangeOut, F&& unary_op)
 ///
 /// @snippet test.cpp rah::transform4
 template<typename RI1, typename RI2, typename RO, typename F>
-auto transform(RI1&& rangeIn1, RI2&& rangeIn2, RO&& rangeOut, F&& binary_op)
+RAH_CONSTEXPR20 auto transform(RI1&& rangeIn1, RI2&& rangeIn2, RO&& rangeOut, F&& binary_op)
 {
 	return RAH_STD::transform(
 		rah_begin(rangeIn1), rah_end(rangeIn1),
@@ -1875,14 +5585,120 @@ auto transform(RI1&& rangeIn1, RI2&& rangeIn2, RO&& rangeOut, F&& binary_op)
 		RAH_STD::forward<F>(binary_op));
 }
 
+/// \cond PRIVATE
+namespace details
+{
+/// The searching algorithms, usable in constant expressions (the std ones are constexpr since C++20)
+template<typename I, typename S, typename P>
+RAH_CONSTEXPR17 I find_if(I iter, S const& last, P&& pred)
+{
+	if (not RAH_IS_CONSTANT_EVALUATED())
+		return RAH_STD::find_if(iter, last, pred);
+	for (; iter != last; ++iter)
+	{
+		if (pred(*iter))
+			break;
+	}
+	return iter;
+}
+
+template<typename I, typename S, typename P>
+RAH_CONSTEXPR17 I find_if_not(I iter, S const& last, P&& pred)
+{
+	if (not RAH_IS_CONSTANT_EVALUATED())
+		return RAH_STD::find_if_not(iter, last, pred);
+	for (; iter != last; ++iter)
+	{
+		if (not pred(*iter))
+			break;
+	}
+	return iter;
+}
+
+template<typename I, typename S, typename P>
+RAH_CONSTEXPR17 auto count_if(I iter, S const& last, P&& pred)
+{
+	if (not RAH_IS_CONSTANT_EVALUATED())
+		return RAH_STD::count_if(iter, last, pred);
+	typename RAH_STD::iterator_traits<I>::difference_type result = 0;
+	for (; iter != last; ++iter)
+	{
+		if (pred(*iter))
+			++result;
+	}
+	return result;
+}
+
+/// The loop is fully unrolled. The end tests are kept, but removed by the compiler when it knows the size.
+template<typename I, typename S, typename F, size_t... Is>
+RAH_CONSTEXPR17 void for_each_element(I iter, S const& last, F& func, RAH_STD::true_type, RAH_STD::index_sequence<Is...>)
+{
+	using swallow = bool[];
+	(void)swallow {
+		true,
+			((void)Is, iter != last and ((void)func(*iter), (void)++iter, true))...
+	};
+}
+
+template<typename I, typename S, typename F>
+RAH_CONSTEXPR17 void for_each_element(I iter, S const& last, F& func, RAH_STD::false_type, RAH_STD::index_sequence<>)
+{
+	if (not RAH_IS_CONSTANT_EVALUATED())
+	{
+		RAH_STD::for_each(iter, last, RAH_STD::ref(func));
+		return;
+	}
+	for (; iter != last; ++iter)
+		func(*iter);
+}
+
+/// Call @b func on each element of @b range.
+/// The loop is unrolled when the size of @b range is bounded by a small static extent (see RAH_UNROLL_MAX_EXTENT),
+/// like on a std::array or a view::take<N>, and the views keeping their extent.
+template<typename R, typename F>
+RAH_CONSTEXPR17 void for_each_element(R&& range, F& func)
+{
+	constexpr size_t Extent = static_max_size<RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<R>>>::value;
+	constexpr bool Unrolled = Extent <= RAH_UNROLL_MAX_EXTENT;
+	for_each_element(rah_begin(range), rah_end(range), func,
+		RAH_STD::integral_constant<bool, Unrolled>(), RAH_STD::make_index_sequence<Unrolled ? Extent : 0>());
+}
+
+/// Is the loop on @b R unrolled by for_each_element
+template<typename R>
+using is_unrolled = RAH_STD::integral_constant<bool,
+	static_max_size<RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<R>>>::value <= RAH_UNROLL_MAX_EXTENT>;
+
+/// Compare the elements like the std algorithms do
+template<typename I1, typename S1, typename I2, typename S2>
+RAH_CONSTEXPR17 bool equal(I1 iter1, S1 const& last1, I2 iter2, S2 const& last2)
+{
+	for (; iter1 != last1 and iter2 != last2; ++iter1, ++iter2)
+	{
+		if (not RAH_STD::equal_to<>()(*iter1, *iter2))
+			return false;
+	}
+	return iter1 == last1 and iter2 == last2;
+}
+} // namespace details
+/// \endcond
+
 // ********************************************* reduce *******************************************
 
 /// @brief Executes a reducer function on each element of the range, resulting in a single output value
 ///
 /// @snippet test.cpp rah::reduce
-template<typename R, typename I, typename F> auto reduce(R&& range, I&& init, F&& reducer)
+template<typename R, typename I, typename F> RAH_CONSTEXPR17 auto reduce(R&& range, I&& init, F&& reducer)
 {
-	return RAH_STD::accumulate(rah_begin(range), rah_end(range), RAH_STD::forward<I>(init), RAH_STD::forward<F>(reducer));
+	if (not details::is_unrolled<R>::value and not RAH_IS_CONSTANT_EVALUATED())
+		return RAH_STD::accumulate(rah_begin(range), rah_end(range), RAH_STD::decay_t<I>(RAH_STD::forward<I>(init)), reducer);
+	RAH_STD::decay_t<I> result = RAH_STD::forward<I>(init);
+	auto accumulate = [&result, &reducer](auto&& elt)
+	{
+		result = reducer(RAH_STD::move(result), RAH_STD::forward<decltype(elt)>(elt));
+	};
+	details::for_each_element(range, accumulate);
+	return result;
 }
 
 /// @brief Executes a reducer function on each element of the range, resulting in a single output value
@@ -1890,7 +5706,7 @@ template<typename R, typename I, typename F> auto reduce(R&& range, I&& init, F&
 ///
 /// @snippet test.cpp rah::reduce_pipeable
 template<typename I, typename F>
-auto reduce(I&& init, F&& reducer)
+RAH_CONSTEXPR17 auto reduce(I&& init, F&& reducer)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1898,21 +5714,59 @@ auto reduce(I&& init, F&& reducer)
 		});
 }
 
+// ********************************************* aggregate_by *************************************
+
+/// @brief Group the elements by the key returned by @b key_fn, and reduce each group
+/// with @b reducer, starting with @b init.
+/// @return A rah::flat_hash_map of key => reduced value
+/// @remark The map is preallocated for min(rah::size_hint(range), @b keyCountHint) keys
+///
+/// @snippet test.cpp rah::aggregate_by
+template<typename R, typename K, typename I, typename F, RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
+auto aggregate_by(R&& range, K&& key_fn, I&& init, F&& reducer, size_t keyCountHint = 1024)
+{
+	using Key = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<decltype(key_fn(*rah_begin(range)))>>;
+	using Value = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<I>>;
+	flat_hash_map<Key, Value> result(RAH_STD::min(RAH_NAMESPACE::size_hint(range), keyCountHint));
+	auto const endIter = rah_end(range);
+	for (auto iter = rah_begin(range); iter != endIter; ++iter)
+	{
+		auto&& elt = *iter;
+		Value& value = result.try_emplace(key_fn(elt), init).first->second;
+		value = reducer(RAH_STD::move(value), elt);
+	}
+	return result;
+}
+
+/// @brief Group the elements by the key returned by @b key_fn, and reduce each group
+/// with @b reducer, starting with @b init.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::aggregate_by_pipeable
+template<typename K, typename I, typename F, RAH_STD::enable_if_t<not is_range<K>::value, int> = 0>
+auto aggregate_by(K&& key_fn, I&& init, F&& reducer, size_t keyCountHint = 1024)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return aggregate_by(RAH_STD::forward<decltype(range)>(range), key_fn, init, reducer, keyCountHint);
+		});
+}
+
 // ************************* any_of *******************************************
 
 /// @brief Checks if unary predicate pred returns true for at least one element in the range
 ///
 /// @snippet test.cpp rah::any_of
-template<typename R, typename F> bool any_of(R&& range, F&& pred)
+template<typename R, typename F> RAH_CONSTEXPR17 bool any_of(R&& range, F&& pred)
 {
-	return RAH_STD::any_of(rah_begin(range), rah_end(range), RAH_STD::forward<F>(pred));
+	return details::find_if(rah_begin(range), rah_end(range), pred) != rah_end(range);
 }
 
 /// @brief Checks if unary predicate pred returns true for at least one element in the range
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::any_of_pipeable
-template<typename P> auto any_of(P&& pred)
+template<typename P> RAH_CONSTEXPR17 auto any_of(P&& pred)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1925,16 +5779,16 @@ template<typename P> auto any_of(P&& pred)
 /// @brief Checks if unary predicate pred returns true for all elements in the range
 ///
 /// @snippet test.cpp rah::all_of
-template<typename R, typename P> bool all_of(R&& range, P&& pred)
+template<typename R, typename P> RAH_CONSTEXPR17 bool all_of(R&& range, P&& pred)
 {
-	return RAH_STD::all_of(rah_begin(range), rah_end(range), RAH_STD::forward<P>(pred));
+	return details::find_if_not(rah_begin(range), rah_end(range), pred) == rah_end(range);
 }
 
 /// @brief Checks if unary predicate pred returns true for all elements in the range
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::all_of_pipeable
-template<typename P> auto all_of(P&& pred)
+template<typename P> RAH_CONSTEXPR17 auto all_of(P&& pred)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1947,16 +5801,16 @@ template<typename P> auto all_of(P&& pred)
 /// @brief Checks if unary predicate pred returns true for no elements in the range
 ///
 /// @snippet test.cpp rah::none_of
-template<typename R, typename P> bool none_of(R&& range, P&& pred)
+template<typename R, typename P> RAH_CONSTEXPR17 bool none_of(R&& range, P&& pred)
 {
-	return RAH_STD::none_of(rah_begin(range), rah_end(range), RAH_STD::forward<P>(pred));
+	return details::find_if(rah_begin(range), rah_end(range), pred) == rah_end(range);
 }
 
 /// @brief Checks if unary predicate pred returns true for no elements in the range
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::none_of_pipeable
-template<typename P> auto none_of(P&& pred)
+template<typename P> RAH_CONSTEXPR17 auto none_of(P&& pred)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1969,16 +5823,18 @@ template<typename P> auto none_of(P&& pred)
 /// @brief Counts the elements that are equal to value
 ///
 /// @snippet test.cpp rah::count
-template<typename R, typename V> auto count(R&& range, V&& value)
+template<typename R, typename V> RAH_CONSTEXPR17 auto count(R&& range, V&& value)
 {
-	return RAH_STD::count(rah_begin(range), rah_end(range), RAH_STD::forward<V>(value));
+	if (not RAH_IS_CONSTANT_EVALUATED())
+		return RAH_STD::count(rah_begin(range), rah_end(range), value);
+	return details::count_if(rah_begin(range), rah_end(range), [&value](auto&& elt) { return RAH_STD::equal_to<>()(elt, value); });
 }
 
 /// @brief Counts the elements that are equal to value
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::count_pipeable
-template<typename V> auto count(V&& value)
+template<typename V> RAH_CONSTEXPR17 auto count(V&& value)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -1990,15 +5846,15 @@ template<typename V> auto count(V&& value)
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::count_if
-template<typename R, typename P> auto count_if(R&& range, P&& pred)
+template<typename R, typename P> RAH_CONSTEXPR17 auto count_if(R&& range, P&& pred)
 {
-	return RAH_STD::count_if(rah_begin(range), rah_end(range), RAH_STD::forward<P>(pred));
+	return details::count_if(rah_begin(range), rah_end(range), pred);
 }
 
 /// @brief Counts elements for which predicate pred returns true
 ///
 /// @snippet test.cpp rah::count_if_pipeable
-template<typename P> auto count_if(P&& pred)
+template<typename P> RAH_CONSTEXPR17 auto count_if(P&& pred)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -2011,9 +5867,11 @@ template<typename P> auto count_if(P&& pred)
 /// @brief Applies the given function func to each element of the range
 ///
 /// @snippet test.cpp rah::for_each
-template<typename R, typename F> auto for_each(R&& range, F&& func)
+template<typename R, typename F> RAH_CONSTEXPR17 auto for_each(R&& range, F&& func)
 {
-	return ::RAH_STD::for_each(rah_begin(range), rah_end(range), RAH_STD::forward<F>(func));
+	RAH_STD::decay_t<F> function = RAH_STD::forward<F>(func);
+	details::for_each_element(range, function);
+	return function;
 }
 
 /// @brief Applies the given function func to each element of the range
@@ -2031,11 +5889,29 @@ template<typename F> auto for_each(F&& func)
 // ***************************** to_container *****************************************************
 
 /// @brief Return a container of type C, filled with the content of range
+/// @remark A rvalue C is moved. The elements of other rvalue containers, and of view::move, are moved.
+/// @remark When C is a rah::static_vector, its capacity is checked at compile time if the size of range is
+/// statically known (arrays, view::take<N>...)
 ///
 /// @snippet test.cpp rah::to_container
-template<typename C, typename R> auto to_container(R&& range)
+/// @snippet test.cpp rah::to_container_move
+template<typename C, typename R, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto to_container(R&& range)
+{
+	RAH_NAMESPACE::details::check_static_capacity<C, R>();
+	return RAH_NAMESPACE::details::take_container<C>(RAH_STD::forward<R>(range));
+}
+
+/// @brief Return a container of type C, filled with the content of range, and using the allocator @b alloc
+/// @param alloc The allocator of C, or anything convertible to it
+/// (like a pointer to a rah::arena for rah::arena_allocator, or to a RAH_STD::pmr::memory_resource)
+///
+/// @snippet test.cpp rah::to_container_alloc
+template<typename C, typename R, typename A, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto to_container(R&& range, A const& alloc)
 {
-	return C(rah_begin(range), rah_end(range));
+	RAH_NAMESPACE::details::check_static_capacity<C, R>();
+	return RAH_NAMESPACE::details::take_container<C>(RAH_STD::forward<R>(range), alloc);
 }
 
 /// @brief Return a container of type C, filled with the content of range
@@ -2050,12 +5926,61 @@ template<typename C> auto to_container()
 		});
 }
 
+/// @brief Return a container of type C, filled with the content of range, and using the allocator @b alloc
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::to_container_alloc_pipeable
+template<typename C, typename A, typename = RAH_STD::enable_if_t<not is_range<A>::value>>
+auto to_container(A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return to_container<C>(RAH_STD::forward<decltype(range)>(range), alloc);
+		});
+}
+
+// ***************************** to_array *********************************************************
+
+/// @brief Return a std::array filled with the content of range, without allocation.
+/// Its size is the static size of @b range (see rah::static_size): the size of an array or a span,
+/// kept by view::transform, zip, reverse...
+/// When only an upper bound of the size is known (see rah::static_max_size), like after view::stride, or
+/// view::take<N> of a vector, a rah::static_vector of this capacity is returned instead.
+/// @remark Up to RAH_UNROLL_MAX_EXTENT elements, the array is filled without loop
+///
+/// @snippet test.cpp rah::to_array
+template<typename R, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto to_array(R&& range)
+{
+	using Range = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<R>>;
+	constexpr size_t N = static_max_size<Range>::value;
+	static_assert(N != DynamicExtent,
+		"The size of the range is not known at compile time. Use rah::to_container<std::array<T, N>>");
+	using Value = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using Container = RAH_STD::conditional_t<static_size<Range>::value != DynamicExtent,
+		RAH_STD::array<Value, N>,
+		static_vector<Value, N>>;
+	return RAH_NAMESPACE::details::take_container<Container>(RAH_STD::forward<R>(range));
+}
+
+/// @brief Return a std::array filled with the content of range, without allocation.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::to_array_pipeable
+inline auto to_array()
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return to_array(RAH_STD::forward<decltype(range)>(range));
+		});
+}
+
 // ************************* mismatch *************************************************************
 
 /// @brief Finds the first position where two ranges differ
 ///
 /// @snippet test.cpp rah::mismatch
-template<typename R1, typename R2> auto mismatch(R1&& range1, R2&& range2)
+template<typename R1, typename R2> RAH_CONSTEXPR20 auto mismatch(R1&& range1, R2&& range2)
 {
 	return RAH_STD::mismatch(rah_begin(range1), rah_end(range1), rah_begin(range2), rah_end(range2));
 }
@@ -2065,16 +5990,18 @@ template<typename R1, typename R2> auto mismatch(R1&& range1, R2&& range2)
 /// @brief Finds the first element equal to value
 ///
 /// @snippet test.cpp rah::find
-template<typename R, typename V> auto find(R&& range, V&& value)
+template<typename R, typename V> RAH_CONSTEXPR17 auto find(R&& range, V&& value)
 {
-	return RAH_STD::find(rah_begin(range), rah_end(range), RAH_STD::forward<V>(value));
+	if (not RAH_IS_CONSTANT_EVALUATED())
+		return RAH_STD::find(rah_begin(range), rah_end(range), value);
+	return details::find_if(rah_begin(range), rah_end(range), [&value](auto&& elt) { return RAH_STD::equal_to<>()(elt, value); });
 }
 
 /// @brief Finds the first element equal to value
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::find_pipeable
-template<typename V> auto find(V&& value)
+template<typename V> RAH_CONSTEXPR17 auto find(V&& value)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -2085,16 +6012,16 @@ template<typename V> auto find(V&& value)
 /// @brief Finds the first element satisfying specific criteria
 ///
 /// @snippet test.cpp rah::find_if
-template<typename R, typename P> auto find_if(R&& range, P&& pred)
+template<typename R, typename P> RAH_CONSTEXPR17 auto find_if(R&& range, P&& pred)
 {
-	return RAH_STD::find_if(rah_begin(range), rah_end(range), RAH_STD::forward<P>(pred));
+	return details::find_if(rah_begin(range), rah_end(range), pred);
 }
 
 /// @brief Finds the first element satisfying specific criteria
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::find_if_pipeable
-template<typename P> auto find_if(P&& pred)
+template<typename P> RAH_CONSTEXPR17 auto find_if(P&& pred)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -2105,16 +6032,16 @@ template<typename P> auto find_if(P&& pred)
 /// @brief Finds the first element not satisfying specific criteria
 ///
 /// @snippet test.cpp rah::find_if_not
-template<typename R, typename P> auto find_if_not(R&& range, P&& pred)
+template<typename R, typename P> RAH_CONSTEXPR17 auto find_if_not(R&& range, P&& pred)
 {
-	return RAH_STD::find_if_not(rah_begin(range), rah_end(range), RAH_STD::forward<P>(pred));
+	return details::find_if_not(rah_begin(range), rah_end(range), pred);
 }
 
 /// @brief Finds the first element not satisfying specific criteria
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::find_if_not_pipeable
-template<typename P> auto find_if_not(P&& pred)
+template<typename P> RAH_CONSTEXPR17 auto find_if_not(P&& pred)
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -2128,7 +6055,7 @@ template<typename P> auto find_if_not(P&& pred)
 ///
 /// @snippet test.cpp rah::max_element
 template<typename R, RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
-auto max_element(R&& range)
+RAH_CONSTEXPR17 auto max_element(R&& range)
 {
 	return RAH_STD::max_element(rah_begin(range), rah_end(range));
 }
@@ -2148,7 +6075,8 @@ inline auto max_element()
 /// @brief Finds the greatest element in the range
 ///
 /// @snippet test.cpp rah::max_element_pred
-template<typename R, typename P> auto max_element(R&& range, P&& pred)
+template<typename R, typename P, RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
+RAH_CONSTEXPR17 auto max_element(R&& range, P&& pred)
 {
 	return RAH_STD::max_element(rah_begin(range), rah_end(range), RAH_STD::forward<P>(pred));
 }
@@ -2166,13 +6094,35 @@ auto max_element(P&& pred)
 		});
 }
 
+/// @brief Finds the element of the range with the greatest projection
+///
+/// @snippet test.cpp rah::max_element_proj
+template<typename R, typename P, typename Proj>
+auto max_element(R&& range, P&& pred, Proj&& proj)
+{
+	return RAH_STD::max_element(rah_begin(range), rah_end(range), details::make_projected_pred(pred, proj));
+}
+
+/// @brief Finds the element of the range with the greatest projection
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::max_element_proj_pipeable
+template<typename P, typename Proj, RAH_STD::enable_if_t<!is_range<P>::value, int> = 0>
+auto max_element(P&& pred, Proj&& proj)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return max_element(RAH_STD::forward<decltype(range)>(range), pred, proj);
+		});
+}
+
 // ************************************* min_element **********************************************
 
 /// @brief Finds the smallest element in the range
 ///
 /// @snippet test.cpp rah::min_element
 template<typename R, RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
-auto min_element(R&& range)
+RAH_CONSTEXPR17 auto min_element(R&& range)
 {
 	return RAH_STD::min_element(rah_begin(range), rah_end(range));
 }
@@ -2192,7 +6142,8 @@ inline auto min_element()
 /// @brief Finds the smallest element in the range
 ///
 /// @snippet test.cpp rah::min_element_pred
-template<typename R, typename P> auto min_element(R&& range, P&& pred)
+template<typename R, typename P, RAH_STD::enable_if_t<is_range<R>::value, int> = 0>
+RAH_CONSTEXPR17 auto min_element(R&& range, P&& pred)
 {
 	return RAH_STD::min_element(rah_begin(range), rah_end(range), RAH_STD::forward<P>(pred));
 }
@@ -2210,15 +6161,45 @@ auto min_element(P&& pred)
 		});
 }
 
+/// @brief Finds the element of the range with the smallest projection
+///
+/// @snippet test.cpp rah::min_element_proj
+template<typename R, typename P, typename Proj>
+auto min_element(R&& range, P&& pred, Proj&& proj)
+{
+	return RAH_STD::min_element(rah_begin(range), rah_end(range), details::make_projected_pred(pred, proj));
+}
+
+/// @brief Finds the element of the range with the smallest projection
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::min_element_proj_pipeable
+template<typename P, typename Proj, RAH_STD::enable_if_t<!is_range<P>::value, int> = 0>
+auto min_element(P&& pred, Proj&& proj)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return min_element(RAH_STD::forward<decltype(range)>(range), pred, proj);
+		});
+}
+
 // *************************************** copy ***************************************************
 
 /// @brief Copy in range into an other
 /// @return The part of out after the copied part
+/// @remark The elements of a rvalue container, or of view::move, are moved.
+/// @remark When @b out is a rah::back_inserter or a rah::inserter and the size of @b in is known
+/// (random access), the elements are inserted with only one call to the insert method of the container.
 ///
 /// @snippet test.cpp rah::copy
+/// @snippet test.cpp rah::copy_move
 template<typename R1, typename R2> auto copy(R1&& in, R2&& out)
 {
-	return RAH_STD::copy(rah_begin(in), rah_end(in), rah_begin(out));
+	auto const movable = RAH_NAMESPACE::details::is_movable_container<R1>();
+	return RAH_NAMESPACE::details::copy_into(
+		RAH_NAMESPACE::details::move_if(rah_begin(in), movable),
+		RAH_NAMESPACE::details::move_if(rah_end(in), movable),
+		rah_begin(out));
 }
 
 /// @brief Copy in range into an other
@@ -2229,7 +6210,7 @@ template<typename R1, typename R2> auto copy(R1&& in, R2&& out)
 template<typename R2> auto copy(R2&& out)
 {
 	auto all_out = out | RAH_NAMESPACE::view::all();
-	return make_pipeable([=](auto&& in) {return copy(in, all_out); });
+	return make_pipeable([=](auto&& in) {return copy(RAH_STD::forward<decltype(in)>(in), all_out); });
 }
 
 // *************************************** fill ***************************************************
@@ -2237,7 +6218,7 @@ template<typename R2> auto copy(R2&& out)
 /// @brief Assigns the given value to the elements in the range [first, last)
 ///
 /// @snippet test.cpp rah::copy
-template<typename R1, typename V> auto fill(R1&& in, V&& value)
+template<typename R1, typename V> RAH_CONSTEXPR20 auto fill(R1&& in, V&& value)
 {
 	return RAH_STD::fill(rah_begin(in), rah_end(in), value);
 }
@@ -2254,11 +6235,13 @@ template<typename V> auto fill(V&& value)
 // *************************************** back_insert ***************************************************
 
 /// @brief Insert *in* in back of *front*
+/// @remark When the size of @b in is known (random access), the elements are appended with only one
+/// call to the insert method of the container, so with at most one allocation.
 ///
 /// @snippet test.cpp rah::back_insert
 template<typename R1, typename R2> auto back_insert(R1&& in, R2&& out)
 {
-	return copy(in, RAH_NAMESPACE::back_inserter(out));
+	return copy(RAH_STD::forward<R1>(in), RAH_NAMESPACE::back_inserter(out));
 }
 
 /// @brief Insert *in* in back of *front*
@@ -2267,7 +6250,7 @@ template<typename R1, typename R2> auto back_insert(R1&& in, R2&& out)
 /// @snippet test.cpp rah::back_insert_pipeable
 template<typename R2> auto back_insert(R2&& out)
 {
-	return make_pipeable([&](auto&& in) {return back_insert(in, out); });
+	return make_pipeable([&](auto&& in) {return back_insert(RAH_STD::forward<decltype(in)>(in), out); });
 }
 
 // *************************************** copy_if ***************************************************
@@ -2276,7 +6259,7 @@ template<typename R2> auto back_insert(R2&& out)
 /// @return The part of out after the copied part
 ///
 /// @snippet test.cpp rah::copy_if
-template<typename R1, typename R2, typename P> auto copy_if(R1&& in, R2&& out, P&& pred)
+template<typename R1, typename R2, typename P> RAH_CONSTEXPR20 auto copy_if(R1&& in, R2&& out, P&& pred)
 {
 	return RAH_STD::copy_if(rah_begin(in), rah_end(in), rah_begin(out), RAH_STD::forward<P>(pred));
 }
@@ -2297,7 +6280,7 @@ template<typename R2, typename P> auto copy_if(R2&& out, P&& pred)
 /// @brief Get the size of range
 ///
 /// @snippet test.cpp rah::size
-template<typename R> auto size(R&& range)
+template<typename R> RAH_CONSTEXPR17 auto size(R&& range)
 {
 	return RAH_STD::distance(rah_begin(range), rah_end(range));
 }
@@ -2306,7 +6289,7 @@ template<typename R> auto size(R&& range)
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::size_pipeable
-inline auto size()
+inline RAH_CONSTEXPR17 auto size()
 {
 	return make_pipeable([=](auto&& range)
 		{
@@ -2319,8 +6302,10 @@ inline auto size()
 /// @brief Determines if two sets of elements are the same
 ///
 /// @snippet test.cpp rah::equal
-template<typename R1, typename R2> auto equal(R1&& range1, R2&& range2)
+template<typename R1, typename R2> RAH_CONSTEXPR17 bool equal(R1&& range1, R2&& range2)
 {
+	if (RAH_IS_CONSTANT_EVALUATED())
+		return details::equal(rah_begin(range1), rah_end(range1), rah_begin(range2), rah_end(range2));
 #ifdef EASTL_VERSION
 	return RAH_STD::identical(rah_begin(range1), rah_end(range1), rah_begin(range2), rah_end(range2));
 #else
@@ -2332,34 +6317,12 @@ template<typename R1, typename R2> auto equal(R1&& range1, R2&& range2)
 /// @remark pipeable syntax
 ///
 /// @snippet test.cpp rah::equal_pipeable
-template<typename R1> auto equal(R1&& range2)
+template<typename R1> RAH_CONSTEXPR17 auto equal(R1&& range2)
 {
 	auto all_range2 = range2 | RAH_NAMESPACE::view::all();
 	return make_pipeable([=](auto&& range1) { return equal(RAH_STD::forward<decltype(range1)>(range1), all_range2); });
 }
 
-// *********************************** stream_inserter ********************************************
-
-template<typename S>
-struct stream_inserter_iterator : iterator_facade<stream_inserter_iterator<S>, typename S::char_type, RAH_STD::output_iterator_tag>
-{
-	S* stream_ = nullptr;
-	stream_inserter_iterator() = default;
-	stream_inserter_iterator(S& stream) : stream_(&stream) { }
-	template<typename V> void put(V&& value) const { (*stream_) << value; }
-};
-
-/// @brief Make a range which output to a stream
-///
-/// @snippet test.cpp rah::stream_inserter
-template<typename S> auto stream_inserter(S&& stream)
-{
-	using Stream = RAH_STD::remove_reference_t<S>;
-	auto begin = stream_inserter_iterator<Stream>(stream);
-	auto end = stream_inserter_iterator<Stream>(stream);
-	return RAH_NAMESPACE::make_iterator_range(begin, end);
-}
-
 // *********************************** remove_if **************************************************
 
 /// @brief Keep at the begining of the range only elements for which pred(elt) is false\n
@@ -2485,46 +6448,250 @@ template<typename R> auto erase(R&& range)
 
 /// @brief Sort a range in place, using the given predicate.
 ///
-/// @snippet test.cpp rah::sort
-/// @snippet test.cpp rah::sort_pred
-template<typename R, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
-void sort(R& range, P&& pred = {})
+/// @snippet test.cpp rah::sort
+/// @snippet test.cpp rah::sort_pred
+template<typename R, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+void sort(R& range, P&& pred = {})
+{
+	RAH_STD::sort(rah_begin(range), rah_end(range), pred);
+}
+
+/// @brief Sort a range in place, using the given predicate.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::sort_pipeable
+/// @snippet test.cpp rah::sort_pred_pipeable
+template<typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort(P&& pred = {})
+{
+	return make_pipeable([=](auto& range) { return sort(range, pred); });
+}
+
+/// @brief Sort a range in place, using the given predicate on the projection of elements.
+///
+/// @snippet test.cpp rah::sort_proj
+template<typename R, typename P, typename Proj, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+void sort(R& range, P&& pred, Proj&& proj)
+{
+	RAH_STD::sort(rah_begin(range), rah_end(range), details::make_projected_pred(pred, proj));
+}
+
+/// @brief Sort a range in place, using the given predicate on the projection of elements.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::sort_proj_pipeable
+template<typename P, typename Proj, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort(P&& pred, Proj&& proj)
+{
+	return make_pipeable([=](auto& range) { return sort(range, pred, proj); });
+}
+
+// *********************************** stable_sort ************************************************
+
+/// @brief Sorts the elements in the range in ascending order. The order of equivalent elements is guaranteed to be preserved.
+///
+/// @snippet test.cpp rah::stable_sort
+/// @snippet test.cpp rah::stable_sort_pred
+template<typename R, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+void stable_sort(R& range, P&& pred = {})
+{
+	RAH_STD::stable_sort(rah_begin(range), rah_end(range), pred);
+}
+
+/// @brief Sorts the elements in the range in ascending order. The order of equivalent elements is guaranteed to be preserved.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::stable_sort_pipeable
+/// @snippet test.cpp rah::stable_sort_pred_pipeable
+template<typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto stable_sort(P&& pred = {})
+{
+	return make_pipeable([=](auto& range) { return stable_sort(range, pred); });
+}
+
+/// @brief Sorts the elements in the range, using the given predicate on the projection of elements. The order of equivalent elements is guaranteed to be preserved.
+///
+/// @snippet test.cpp rah::stable_sort_proj
+template<typename R, typename P, typename Proj, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+void stable_sort(R& range, P&& pred, Proj&& proj)
+{
+	RAH_STD::stable_sort(rah_begin(range), rah_end(range), details::make_projected_pred(pred, proj));
+}
+
+/// @brief Sorts the elements in the range, using the given predicate on the projection of elements. The order of equivalent elements is guaranteed to be preserved.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::stable_sort_proj_pipeable
+template<typename P, typename Proj, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto stable_sort(P&& pred, Proj&& proj)
+{
+	return make_pipeable([=](auto& range) { return stable_sort(range, pred, proj); });
+}
+
+// *********************************** nth_element *****************************************************
+
+/// @brief Partially sort the range so that the element pointed by @b nth is the one which would be
+/// at this position in a sorted range. All elements before @b nth are not greater than it,
+/// and all elements after are not less.
+///
+/// @snippet test.cpp rah::nth_element
+/// @snippet test.cpp rah::nth_element_pred
+template<typename R, typename I, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+void nth_element(R&& range, I nth, P&& pred = {})
+{
+	RAH_STD::nth_element(rah_begin(range), nth, rah_end(range), pred);
+}
+
+/// @see rah::nth_element(R&&, I, P&&)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::nth_element_pipeable
+template<typename I, typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<I>::value>>
+auto nth_element(I nth, P&& pred = {})
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return RAH_NAMESPACE::nth_element(RAH_STD::forward<decltype(range)>(range), nth, pred);
+		});
+}
+
+// *********************************** partial_sort ****************************************************
+
+/// @brief Rearranges elements such that the range [begin, middle) contains the sorted
+/// (middle - begin) smallest elements in the range. The order of the remaining elements is unspecified.
+///
+/// @snippet test.cpp rah::partial_sort
+/// @snippet test.cpp rah::partial_sort_pred
+template<typename R, typename I, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+void partial_sort(R&& range, I middle, P&& pred = {})
+{
+	RAH_STD::partial_sort(rah_begin(range), middle, rah_end(range), pred);
+}
+
+/// @see rah::partial_sort(R&&, I, P&&)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::partial_sort_pipeable
+template<typename I, typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<I>::value>>
+auto partial_sort(I middle, P&& pred = {})
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return RAH_NAMESPACE::partial_sort(RAH_STD::forward<decltype(range)>(range), middle, pred);
+		});
+}
+
+// *********************************** partial_sort_copy ***********************************************
+
+/// @brief Copy in @b out the smallest elements of @b in, sorted. The count of copied elements is
+/// the smaller of the two range sizes.
+/// @return The part of out after the copied part
+///
+/// @snippet test.cpp rah::partial_sort_copy
+template<
+	typename R1, typename R2, typename P = is_lesser,
+	typename = RAH_STD::enable_if_t<is_range<R2>::value>>
+auto partial_sort_copy(R1&& in, R2&& out, P&& pred = {})
 {
-	RAH_STD::sort(rah_begin(range), rah_end(range), pred);
+	return RAH_STD::partial_sort_copy(rah_begin(in), rah_end(in), rah_begin(out), rah_end(out), pred);
 }
 
-/// @brief Sort a range in place, using the given predicate.
+/// @see rah::partial_sort_copy(R1&&, R2&&, P&&)
 /// @remark pipeable syntax
 ///
-/// @snippet test.cpp rah::sort_pipeable
-/// @snippet test.cpp rah::sort_pred_pipeable
-template<typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
-auto sort(P&& pred = {})
+/// @snippet test.cpp rah::partial_sort_copy_pipeable
+template<typename R2, typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto partial_sort_copy(R2&& out, P&& pred = {})
 {
-	return make_pipeable([=](auto& range) { return sort(range, pred); });
+	auto all_out = out | RAH_NAMESPACE::view::all();
+	return make_pipeable([=](auto&& in) {return partial_sort_copy(in, all_out, pred); });
 }
 
-// *********************************** stable_sort ************************************************
+// *********************************** top_k ***********************************************************
 
-/// @brief Sorts the elements in the range in ascending order. The order of equivalent elements is guaranteed to be preserved.
+/// \cond PRIVATE
+namespace details
+{
+template<typename R, typename P, typename H>
+H top_k(R&& range, size_t k, P&& pred, H heap)
+{
+	if (k == 0)
+		return heap;
+	heap.reserve(k);
+	// heap.front() is the greatest of the kept elements, so the first to be replaced
+	auto iter = rah_begin(range);
+	auto endIter = rah_end(range);
+	for (; iter != endIter and heap.size() != k; ++iter)
+	{
+		heap.emplace_back(*iter);
+		RAH_STD::push_heap(rah_begin(heap), rah_end(heap), pred);
+	}
+	for (; iter != endIter; ++iter)
+	{
+		auto&& value = *iter;
+		if (pred(value, heap.front()))
+		{
+			RAH_STD::pop_heap(rah_begin(heap), rah_end(heap), pred);
+			heap.back() = RAH_STD::forward<decltype(value)>(value);
+			RAH_STD::push_heap(rah_begin(heap), rah_end(heap), pred);
+		}
+	}
+	RAH_STD::sort_heap(rah_begin(heap), rah_end(heap), pred);
+	return heap;
+}
+} // namespace details
+/// \endcond
+
+/// @brief Get the @b k smallest elements of the range (according to @b pred), sorted.
+/// @return A vector of at most k elements
+/// @remark The range is read only once and only k elements are kept at a time (in a bounded heap),
+/// so it works on single-pass ranges or ranges of unknown size, like view::generate or view::join.
 ///
-/// @snippet test.cpp rah::stable_sort
-/// @snippet test.cpp rah::stable_sort_pred
+/// @snippet test.cpp rah::top_k
+/// @snippet test.cpp rah::top_k_pred
 template<typename R, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<R>::value>>
-void stable_sort(R& range, P&& pred = {})
+auto top_k(R&& range, size_t k, P&& pred = {})
 {
-	RAH_STD::stable_sort(rah_begin(range), rah_end(range), pred);
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	return details::top_k(RAH_STD::forward<R>(range), k, pred, RAH_STD::vector<value_type>());
 }
 
-/// @brief Sorts the elements in the range in ascending order. The order of equivalent elements is guaranteed to be preserved.
+/// @brief Get the @b k smallest elements of the range (according to @b pred), sorted, in a vector
+/// allocated using @b alloc
+/// @param alloc An allocator, a pointer to a rah::arena, or a pointer to a RAH_STD::pmr::memory_resource.
+///
+/// @snippet test.cpp rah::top_k_alloc
+template<typename R, typename P, typename A, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto top_k(R&& range, size_t k, P&& pred, A const& alloc)
+{
+	using value_type = RAH_STD::remove_cv_t<range_value_type_t<R>>;
+	using Alloc = details::allocator_for_t<A, value_type>;
+	return details::top_k(RAH_STD::forward<R>(range), k, pred, RAH_STD::vector<value_type, Alloc>(Alloc(alloc)));
+}
+
+/// @brief Get the @b k smallest elements of the range (according to @b pred), sorted.
 /// @remark pipeable syntax
 ///
-/// @snippet test.cpp rah::stable_sort_pipeable
-/// @snippet test.cpp rah::stable_sort_pred_pipeable
+/// @snippet test.cpp rah::top_k_pipeable
+/// @snippet test.cpp rah::top_k_pred_pipeable
 template<typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
-auto stable_sort(P&& pred = {})
+auto top_k(size_t k, P&& pred = {})
 {
-	return make_pipeable([=](auto& range) { return stable_sort(range, pred); });
+	return make_pipeable([=](auto&& range)
+		{
+			return top_k(RAH_STD::forward<decltype(range)>(range), k, pred);
+		});
+}
+
+/// @see rah::top_k(R&& range, size_t k, P&& pred, A const& alloc)
+/// @remark pipeable syntax
+template<typename P, typename A, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto top_k(size_t k, P&& pred, A const& alloc)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return top_k(RAH_STD::forward<decltype(range)>(range), k, pred, alloc);
+		});
 }
 
 // *********************************** shuffle *******************************************************
@@ -2553,7 +6720,7 @@ auto shuffle(URBG&& g)
 /// Apply the '==' operator on two values of any type
 struct is_equal
 {
-	template<typename A, typename B> bool operator()(A&& a, B&& b) { return a == b; }
+	template<typename A, typename B> bool operator()(A&& a, B&& b) const { return a == b; }
 };
 
 /// @brief Remove all but first successuve values which are equals. Without resizing the range.
@@ -2582,6 +6749,30 @@ auto unique(P&& pred = {})
 		});
 }
 
+/// @brief Remove all but first successive values which have equal projections. Without resizing the range.
+/// @return The end part of the range, which have to be remove.
+///
+/// @snippet test.cpp rah::unique_proj
+template<typename R, typename P, typename Proj, typename = RAH_STD::enable_if_t<is_range<R>::value>>
+auto unique(R&& range, P&& pred, Proj&& proj)
+{
+	return RAH_STD::unique(rah_begin(range), rah_end(range), details::make_projected_pred(pred, proj));
+}
+
+/// @brief Remove all but first successive values which have equal projections. Without resizing the range.
+/// @return The end part of the range, which have to be remove.
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::unique_proj_pipeable
+template<typename P, typename Proj, RAH_STD::enable_if_t<not is_range<P>::value, int> = 0>
+auto unique(P&& pred, Proj&& proj)
+{
+	return make_pipeable([=](auto&& range)
+		{
+			return unique(RAH_STD::forward<decltype(range)>(range), pred, proj);
+		});
+}
+
 // *********************************** set_difference ************************************************
 
 /// @brief Copies the elements from the sorted range in1 which are not found in the sorted range in2 to the range out
@@ -2612,6 +6803,198 @@ void set_intersection(IN1&& in1, IN2&& in2, OUT_&& out)
 		rah_begin(out));
 }
 
+// *********************************** radix_sort ******************************************************
+
+/// \cond PRIVATE
+namespace details
+{
+/// Map a key to bytes with the same ordering. @b byte(key, 0) is the least significant one.
+template<typename K, typename = int>
+struct radix_key
+{
+	static_assert(sizeof(K) == 0,
+		"radix sort key must be an integral, enum or floating point type, or a std::pair or std::array of them");
+};
+
+/// Keys encoded in an unsigned integer
+template<typename K, typename E>
+struct radix_scalar_key
+{
+	static constexpr size_t size = sizeof(typename E::type);
+	static size_t byte(K key, size_t index) { return size_t(E::encode(key) >> (index * 8)) & 0xFF; }
+};
+
+template<typename K>
+struct unsigned_key
+{
+	using type = K;
+	static type encode(K key) { return key; }
+};
+
+template<typename K>
+struct radix_key<K, RAH_STD::enable_if_t<RAH_STD::is_integral<K>::value and RAH_STD::is_unsigned<K>::value, int>>
+	: radix_scalar_key<K, unsigned_key<K>>
+{
+};
+
+template<typename K>
+struct signed_key
+{
+	using type = RAH_STD::make_unsigned_t<K>;
+	// Flip the sign bit so that negative values come first
+	static type encode(K key) { return type(type(key) ^ (type(1) << (sizeof(type) * 8 - 1))); }
+};
+
+template<typename K>
+struct radix_key<K, RAH_STD::enable_if_t<RAH_STD::is_integral<K>::value and RAH_STD::is_signed<K>::value, int>>
+	: radix_scalar_key<K, signed_key<K>>
+{
+};
+
+template<typename K>
+struct radix_key<K, RAH_STD::enable_if_t<RAH_STD::is_enum<K>::value, int>>
+{
+	using underlying = radix_key<RAH_STD::underlying_type_t<K>>;
+	static constexpr size_t size = underlying::size;
+	static size_t byte(K key, size_t index) { return underlying::byte(RAH_STD::underlying_type_t<K>(key), index); }
+};
+
+template<typename K>
+struct float_key
+{
+	static_assert(sizeof(K) == 4 or sizeof(K) == 8, "Only 32 and 64 bits floating point are supported");
+	using type = RAH_STD::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+	// Positive values: flip the sign bit. Negative values: flip all bits (to reverse their order)
+	static type encode(K key)
+	{
+		type bits;
+		std::memcpy(&bits, &key, sizeof(bits));
+		type const signBit = type(1) << (sizeof(type) * 8 - 1);
+		return (bits & signBit) ? type(~bits) : type(bits | signBit);
+	}
+};
+
+template<typename K>
+struct radix_key<K, RAH_STD::enable_if_t<RAH_STD::is_floating_point<K>::value, int>>
+	: radix_scalar_key<K, float_key<K>>
+{
+};
+
+/// Lexicographic order: @b first is the most significant
+template<typename A, typename B>
+struct radix_key<RAH_STD::pair<A, B>>
+{
+	static constexpr size_t size = radix_key<A>::size + radix_key<B>::size;
+	static size_t byte(RAH_STD::pair<A, B> const& key, size_t index)
+	{
+		return index < radix_key<B>::size ?
+			radix_key<B>::byte(key.second, index) :
+			radix_key<A>::byte(key.first, index - radix_key<B>::size);
+	}
+};
+
+/// Lexicographic order: the first element is the most significant
+template<typename T, size_t N>
+struct radix_key<RAH_STD::array<T, N>>
+{
+	static constexpr size_t size = radix_key<T>::size * N;
+	static size_t byte(RAH_STD::array<T, N> const& key, size_t index)
+	{
+		return radix_key<T>::byte(key[N - 1 - index / radix_key<T>::size], index % radix_key<T>::size);
+	}
+};
+
+/// Histograms of the big keys are not on the stack
+using radix_histogram = RAH_STD::array<size_t, 256>;
+template<size_t PassCount>
+using radix_histograms = RAH_STD::conditional_t<(PassCount <= 16),
+	RAH_STD::array<radix_histogram, PassCount>,
+	RAH_STD::vector<radix_histogram>>;
+
+inline void init_histograms(RAH_STD::vector<radix_histogram>& histograms, size_t passCount)
+{
+	histograms.assign(passCount, radix_histogram{});
+}
+
+template<size_t PassCount>
+void init_histograms(RAH_STD::array<radix_histogram, PassCount>& histograms, size_t)
+{
+	histograms = {};
+}
+
+/// Make @b scratch the size of the range.
+/// The new elements are default constructed, or copies of @b value when they can't be.
+template<typename B, typename V>
+void resize_scratch(B& scratch, size_t count, V const&, RAH_STD::true_type)
+{
+	scratch.resize(count);
+}
+
+template<typename B, typename V>
+void resize_scratch(B& scratch, size_t count, V const& value, RAH_STD::false_type)
+{
+	scratch.resize(count, value);
+}
+
+/// LSD radix sort, one byte per pass. Stable.
+/// @param scratch Temporary buffer, resized to the size of the range
+template<typename I, typename B, typename P>
+void radix_sort(I first, I last, B& scratch, P&& proj)
+{
+	using Key = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<decltype(proj(*first))>>;
+	using KeyTraits = radix_key<Key>;
+	constexpr size_t PassCount = KeyTraits::size;
+	auto const count = size_t(last - first);
+	if (count < 2)
+		return;
+
+	// Compute all histograms in one read
+	radix_histograms<PassCount> histograms;
+	init_histograms(histograms, PassCount);
+	for (I iter = first; iter != last; ++iter)
+	{
+		auto&& key = proj(*iter);
+		for (size_t pass = 0; pass != PassCount; ++pass)
+			++histograms[pass][KeyTraits::byte(key, pass)];
+	}
+
+	using Value = typename RAH_STD::iterator_traits<I>::value_type;
+	resize_scratch(scratch, count, *first, RAH_STD::is_default_constructible<Value>());
+	auto const bufferBegin = rah_begin(scratch);
+	bool inBuffer = false; // Is the data currently in the scratch buffer?
+	auto scatter = [&](auto srcBegin, auto srcEnd, auto dstBegin, size_t pass, size_t(&offsets)[256])
+	{
+		for (auto iter = srcBegin; iter != srcEnd; ++iter)
+		{
+			auto const byte = KeyTraits::byte(proj(*iter), pass);
+			dstBegin[offsets[byte]++] = RAH_STD::move(*iter);
+		}
+	};
+	for (size_t pass = 0; pass != PassCount; ++pass)
+	{
+		radix_histogram const& histogram = histograms[pass];
+		// Skip the pass if all keys have the same byte
+		if (histogram[KeyTraits::byte(proj(inBuffer ? *bufferBegin : *first), pass)] == count)
+			continue;
+		size_t offsets[256];
+		size_t sum = 0;
+		for (size_t i = 0; i != 256; ++i)
+		{
+			offsets[i] = sum;
+			sum += histogram[i];
+		}
+		if (inBuffer)
+			scatter(bufferBegin, rah_end(scratch), first, pass, offsets);
+		else
+			scatter(first, last, bufferBegin, pass, offsets);
+		inBuffer = not inBuffer;
+	}
+	if (inBuffer)
+		RAH_STD::move(bufferBegin, rah_end(scratch), first);
+}
+} // namespace details
+/// \endcond
+
 namespace action
 {
 
@@ -2644,6 +7027,64 @@ auto unique(P&& pred = {})
 	});
 }
 
+// *********************************** distinct ***************************************************
+
+/// @brief Remove all duplicate elements, keeping the first occurrence of each value in place.
+/// @return Reference to container
+/// @remark No element is copied: the seen-set only store iterators to the kept elements.
+///
+/// @snippet test.cpp rah::action::distinct
+template<
+	typename C,
+	typename H = RAH_STD::hash<range_value_type_t<C>>,
+	typename E = RAH_STD::equal_to<range_value_type_t<C>>,
+	typename = RAH_STD::enable_if_t<is_range<C>::value>>
+auto&& distinct(C&& container, H&& hash = {}, E&& equal = {})
+{
+	using Iterator = range_begin_type_t<C>;
+	using Hash = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<H>>;
+	using Equal = RAH_STD::remove_cv_t<RAH_STD::remove_reference_t<E>>;
+	RAH_NAMESPACE::details::flat_hash_table<Iterator, RAH_NAMESPACE::details::dereference_iterator, Hash, Equal> seen(
+		RAH_NAMESPACE::size_hint(container), {}, hash, equal);
+	auto write = rah_begin(container);
+	auto const endIter = rah_end(container);
+	for (auto read = write; read != endIter; ++read)
+	{
+		if (seen.emplace_key(*read, write).second)
+		{
+			if (read != write)
+				*write = RAH_STD::move(*read);
+			++write;
+		}
+	}
+	container.erase(write, container.end());
+	return RAH_STD::forward<C>(container);
+}
+
+/// @brief Remove all duplicate elements, keeping the first occurrence of each value in place.
+/// @return Reference to container
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::action::distinct_pipeable
+inline auto distinct()
+{
+	return make_pipeable([=](auto&& range) -> auto&&
+	{
+		return action::distinct(RAH_STD::forward<decltype(range)>(range));
+	});
+}
+
+/// @see rah::action::distinct(C&&, H&&, E&&)
+/// @remark pipeable syntax
+template<typename H, typename E, typename = RAH_STD::enable_if_t<not is_range<H>::value>>
+auto distinct(H&& hash, E&& equal)
+{
+	return make_pipeable([=](auto&& range) -> auto&&
+	{
+		return action::distinct(RAH_STD::forward<decltype(range)>(range), hash, equal);
+	});
+}
+
 // *********************************** remove_if **************************************************
 
 /// @brief Keep only elements for which pred(elt) is false\n
@@ -2723,6 +7164,176 @@ auto sort(P&& pred = {})
 	});
 }
 
+// *********************************** radix_sort ******************************************************
+
+/// @brief Sort a range in place, using a LSD radix sort. The sort is stable.
+/// @return reference to container
+/// @remark Elements have to be integral, enum or floating point values, or std::pair or std::array of them
+/// (compared lexicographically).
+/// @remark Use a temporary buffer of the size of the range. It can be given as @b scratch to be reused.
+///
+/// @snippet test.cpp rah::action::radix_sort
+template<typename C, typename = RAH_STD::enable_if_t<is_range<C>::value>>
+auto&& radix_sort(C&& container)
+{
+	RAH_STD::vector<range_value_type_t<C>> scratch;
+	details::radix_sort(rah_begin(container), rah_end(container), scratch, identity{});
+	return RAH_STD::forward<C>(container);
+}
+
+/// @see rah::action::radix_sort(C&&)
+/// @param scratch Temporary buffer which is reused between calls
+///
+/// @snippet test.cpp rah::action::radix_sort_scratch
+template<typename C, typename B>
+auto&& radix_sort(C&& container, B& scratch)
+{
+	details::radix_sort(rah_begin(container), rah_end(container), scratch, identity{});
+	return RAH_STD::forward<C>(container);
+}
+
+/// @brief Sort a range in place, using a LSD radix sort. The sort is stable.
+/// @return reference to container
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::action::radix_sort_pipeable
+inline auto radix_sort()
+{
+	return make_pipeable([=](auto&& range) -> auto&&
+	{
+		return action::radix_sort(RAH_STD::forward<decltype(range)>(range));
+	});
+}
+
+// *********************************** sort_by_key *****************************************************
+
+/// @brief Sort a range in place according to the key returned by @b proj, using a LSD radix sort.
+/// The sort is stable.
+/// @return reference to container
+/// @remark Keys have to be integral, enum or floating point values, or std::pair or std::array of them
+/// (compared lexicographically).
+/// @remark @b proj is called several times for each element so it should be cheap (like getting a member).
+/// @remark Use a temporary buffer of the size of the range. It can be given as @b scratch to be reused.
+/// Its new elements are default constructed, or copies of an element when they are not default constructible.
+///
+/// @snippet test.cpp rah::action::sort_by_key
+template<typename C, typename P, typename = RAH_STD::enable_if_t<is_range<C>::value>>
+auto&& sort_by_key(C&& container, P&& proj)
+{
+	RAH_STD::vector<range_value_type_t<C>> scratch;
+	details::radix_sort(rah_begin(container), rah_end(container), scratch, proj);
+	return RAH_STD::forward<C>(container);
+}
+
+/// @see rah::action::sort_by_key(C&&, P&&)
+/// @param scratch Temporary buffer which is reused between calls
+template<typename C, typename P, typename B, typename = RAH_STD::enable_if_t<is_range<C>::value>>
+auto&& sort_by_key(C&& container, P&& proj, B& scratch)
+{
+	details::radix_sort(rah_begin(container), rah_end(container), scratch, proj);
+	return RAH_STD::forward<C>(container);
+}
+
+/// @see rah::action::sort_by_key(C&&, P&&)
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::action::sort_by_key_pipeable
+template<typename P, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort_by_key(P&& proj)
+{
+	return make_pipeable([=](auto&& range) -> auto&&
+	{
+		return action::sort_by_key(RAH_STD::forward<decltype(range)>(range), proj);
+	});
+}
+
+/// @see rah::action::sort_by_key(C&&, P&&, B&)
+/// @remark pipeable syntax
+template<typename P, typename B, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort_by_key(P&& proj, B& scratch)
+{
+	return make_pipeable([=, &scratch](auto&& range) -> auto&&
+	{
+		return action::sort_by_key(RAH_STD::forward<decltype(range)>(range), proj, scratch);
+	});
+}
+
+// *********************************** sort_by_cached_key **********************************************
+
+/// @brief Sort a range in place, by the keys returned by @b key.
+/// Equivalent keys keep their relative order.
+/// @return reference to container
+/// @remark The key of each element is computed only once, so this is faster than
+/// a predicate calling @b key when the key is costly to compute.
+///
+/// @snippet test.cpp rah::action::sort_by_cached_key
+template<typename C, typename P, typename K, RAH_STD::enable_if_t<is_range<C>::value, int> = 0>
+auto&& sort_by_cached_key(C&& container, P&& pred, K&& key)
+{
+	details::sort_by_cached_key(rah_begin(container), rah_end(container), key, pred);
+	return RAH_STD::forward<C>(container);
+}
+
+/// @brief Sort a range in place, by the keys returned by @b key, using rah::is_lesser
+/// @see rah::action::sort_by_cached_key(C&& container, P&& pred, K&& key)
+template<typename C, typename K, RAH_STD::enable_if_t<is_range<C>::value, int> = 0>
+auto&& sort_by_cached_key(C&& container, K&& key)
+{
+	return action::sort_by_cached_key(RAH_STD::forward<C>(container), is_lesser(), RAH_STD::forward<K>(key));
+}
+
+/// @brief Sort a range in place, by the keys returned by @b key.
+/// @return reference to container
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::action::sort_by_cached_key_pipeable
+template<typename P, typename K, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto sort_by_cached_key(P&& pred, K&& key)
+{
+	return make_pipeable([=](auto&& range) -> auto&&
+	{
+		return action::sort_by_cached_key(RAH_STD::forward<decltype(range)>(range), pred, key);
+	});
+}
+
+/// @see rah::action::sort_by_cached_key(C&& container, K&& key)
+/// @remark pipeable syntax
+template<typename K, typename = RAH_STD::enable_if_t<not is_range<K>::value>>
+auto sort_by_cached_key(K&& key)
+{
+	return action::sort_by_cached_key(is_lesser(), RAH_STD::forward<K>(key));
+}
+
+// *********************************** top_k ***********************************************************
+
+/// @brief Keep only the @b k smallest elements of the container (according to @b pred), sorted.
+/// @return reference to container
+///
+/// @snippet test.cpp rah::action::top_k
+/// @snippet test.cpp rah::action::top_k_pred
+template<typename C, typename P = is_lesser, typename = RAH_STD::enable_if_t<is_range<C>::value>>
+auto&& top_k(C&& container, size_t k, P&& pred = {})
+{
+	auto const middle = rah_begin(container) + RAH_STD::min<intptr_t>(k, RAH_NAMESPACE::size(container));
+	RAH_NAMESPACE::partial_sort(container, middle, pred);
+	container.erase(middle, container.end());
+	return RAH_STD::forward<C>(container);
+}
+
+/// @brief Keep only the @b k smallest elements of the container (according to @b pred), sorted.
+/// @return reference to container
+/// @remark pipeable syntax
+///
+/// @snippet test.cpp rah::action::top_k_pipeable
+template<typename P = is_lesser, typename = RAH_STD::enable_if_t<not is_range<P>::value>>
+auto top_k(size_t k, P&& pred = {})
+{
+	return make_pipeable([=](auto&& range) -> auto&&
+	{
+		return action::top_k(RAH_STD::forward<decltype(range)>(range), k, pred);
+	});
+}
+
 // *********************************** shuffle *******************************************************
 
 /// @brief Reorders the elements in the given range such that each possible permutation of those elements has equal probability of appearance.
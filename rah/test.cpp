@@ -13,6 +13,8 @@
 #include <vector>
 #include <map>
 #include <list>
+#include <deque>
+#include <memory>
 #include <forward_list>
 #include <ciso646>
 #include <sstream>
@@ -82,6 +84,23 @@ constexpr bool is_rvalue_reference_v = std::is_rvalue_reference<T>::value;
 template<typename T>
 struct WhatIsIt;
 
+/// Allocator counting the allocations
+template<typename T>
+struct CountingAllocator : std::allocator<T>
+{
+	using value_type = T;
+	static size_t allocCount;
+	template<typename U> struct rebind { using other = CountingAllocator<U>; };
+	CountingAllocator() = default;
+	template<typename U> CountingAllocator(CountingAllocator<U> const&) {}
+	T* allocate(size_t n)
+	{
+		++allocCount;
+		return std::allocator<T>::allocate(n);
+	}
+};
+template<typename T> size_t CountingAllocator<T>::allocCount = 0;
+
 /// [make_pipeable create]
 auto test_count(int i)
 {
@@ -127,6 +146,21 @@ auto customGenerate()
 	return rah::iterator_range<CustomGenerator>{};
 }
 
+/// [rah::view::own_return]
+std::vector<int> make_vector()
+{
+	return { 0, 1, 2, 3, 4, 5 };
+}
+
+// The vector is moved into the returned view
+auto odd_squares()
+{
+	return make_vector()
+		| rah::view::filter([](int i) { return i % 2 == 1; })
+		| rah::view::transform([](int i) { return i * i; });
+}
+/// [rah::view::own_return]
+
 int main()
 {
 	{
@@ -150,6 +184,81 @@ int main()
 			result.push_back(i);
 		assert(result == std::vector<int>({ 20 }));
 	}
+	{
+		/// [rah::view::own]
+		std::vector<int> vec{ 0, 1, 2, 3 };
+		int const* data = vec.data();
+		auto view = rah::view::own(std::move(vec));
+		assert(rah::equal(view, il<int>{ 0, 1, 2, 3 }));
+		assert(&(*view.begin()) == data); // Moved, not copied
+		/// [rah::view::own]
+	}
+	{
+		/// [rah::view::own_pipeable]
+		auto view = make_vector() | rah::view::own() | rah::view::take(2);
+		assert(rah::equal(view, il<int>{ 0, 1 }));
+		/// [rah::view::own_pipeable]
+	}
+	{
+		/// [rah::view::own_return_use]
+		assert(rah::equal(odd_squares(), il<int>{ 1, 9, 25 }));
+		/// [rah::view::own_return_use]
+	}
+	{
+		// The container is stored in the view, and destroyed with it
+		auto shared = std::make_shared<int>(42);
+		std::weak_ptr<int> weak = shared;
+		auto deref = [](auto const& ptr) { return *ptr; };
+		{
+			auto view = std::vector<std::shared_ptr<int>>{ std::move(shared) } | rah::view::transform(deref);
+			auto moved = std::move(view);
+			assert(not weak.expired());
+			assert(*moved.begin() == 42);
+			// The iterators are the ones of a view on a lvalue container
+			std::vector<std::shared_ptr<int>> lvalue;
+			static_assert(std::is_same<
+				decltype(moved.begin()),
+				decltype((lvalue | rah::view::transform(deref)).begin())>::value, "");
+		}
+		assert(weak.expired());
+	}
+	{
+		// Every adaptor can take a rvalue container
+		assert(rah::equal(make_vector() | rah::view::drop(4), il<int>{ 4, 5 }));
+		assert(rah::equal(make_vector() | rah::view::reverse() | rah::view::take(2), il<int>{ 5, 4 }));
+		assert(rah::equal(make_vector() | rah::view::stride(2), il<int>{ 0, 2, 4 }));
+		assert(rah::equal(make_vector() | rah::view::slice(1, 3), il<int>{ 1, 2 }));
+		assert(rah::equal(make_vector() | rah::view::cycle() | rah::view::take(8), il<int>{ 0, 1, 2, 3, 4, 5, 0, 1 }));
+		assert(rah::equal(
+			rah::view::zip(make_vector(), std::vector<char>{ 'a', 'b' }),
+			il<std::tuple<int, char>>{ { 0, 'a' }, { 1, 'b' } }));
+		assert(rah::equal(rah::view::concat(make_vector(), std::vector<int>{ 6 }), il<int>{ 0, 1, 2, 3, 4, 5, 6 }));
+		assert(rah::equal(rah::view::set_difference(make_vector(), std::vector<int>{ 1, 2, 3 }), il<int>{ 0, 4, 5 }));
+		assert(rah::size(make_vector() | rah::view::chunk(4)) == 2);
+		assert(rah::size(make_vector() | rah::view::sliding(3)) == 4);
+		assert(rah::size(make_vector() | rah::view::enumerate()) == 6);
+		assert(rah::equal(
+			std::vector<std::vector<int>>{ { 0, 1 }, { 2 } } | rah::view::join(),
+			il<int>{ 0, 1, 2 }));
+		// Join sub-ranges generated by value
+		assert(rah::equal(
+			rah::view::iota(1, 4) | rah::view::transform([](int i) { return std::vector<int>(i, i); }) | rah::view::join(),
+			il<int>{ 1, 2, 2, 3, 3, 3 }));
+		{
+			// The current sub-range is stored in the view, which is single-pass
+			auto joined = rah::view::iota(0, 4) | rah::view::transform([](int i) { return std::vector<int>(i, i); })
+				| rah::view::join();
+			static_assert(std::is_same<rah::range_iter_categ_t<decltype(joined)>, std::input_iterator_tag>::value, "");
+			assert(rah::equal(joined, il<int>{ 1, 2, 2, 3, 3, 3 }));
+		}
+		// Stateful views can be chained
+		assert(rah::equal(
+			std::vector<int>{ 3, 1, 3, 2, 1 } | rah::view::distinct() | rah::view::transform([](int i) { return i * 10; }),
+			il<int>{ 30, 10, 20 }));
+		assert(rah::equal(
+			make_vector() | rah::view::sliding_reduce(2, std::plus<>()) | rah::view::take(2),
+			il<int>{ 1, 3 }));
+	}
 	{
 		/// [single]
 		std::vector<int> result;
@@ -432,6 +541,258 @@ int main()
 		/// [repeat]
 	}
 
+	{
+		/// [rah::view::counted_stats]
+		rah::view_stats stats("vector");
+		std::vector<int> in{ 0, 1, 2, 3 };
+		auto view = rah::view::counted_stats(in, stats);
+		assert(rah::equal(view, il<int>{ 0, 1, 2, 3 }));
+		assert(stats.increments == 4);
+		assert(stats.dereferences == 4);
+		/// [rah::view::counted_stats]
+	}
+	{
+		// The counts are atomic, and the stats can be copied
+		rah::view_stats stats("vector");
+		std::vector<int> in{ 0, 1, 2 };
+		rah::for_each(in | rah::view::counted_stats(stats), [](int) {});
+		rah::view_stats const snapshot = stats;
+		stats.reset();
+		assert(snapshot.increments == 3 and stats.increments == 0);
+		static_assert(std::is_same<decltype(stats.increments.value_), std::atomic<size_t>>::value, "");
+	}
+	{
+		/// [rah::view::counted_stats_pipeable]
+		rah::view_stats source("iota");
+		rah::view_stats evens("filter");
+		rah::view_stats predicate("is_even");
+		auto range = rah::view::iota(0, 10)
+			| rah::view::counted_stats(source)
+			| rah::view::filter(rah::counted_calls([](int i) { return i % 2 == 0; }, predicate))
+			| rah::view::counted_stats(evens);
+		assert(rah::equal(range, il<int>{ 0, 2, 4, 6, 8 }));
+		assert(source.increments == 10);
+		assert(source.dereferences == 10);
+		assert(predicate.calls == 10);
+		assert(evens.increments == 5);
+		assert(evens.dereferences == 5);
+		evens.reset();
+		assert(evens.increments == 0 and evens.name == std::string("filter"));
+		/// [rah::view::counted_stats_pipeable]
+	}
+	{
+		/// [rah::counted_calls]
+		rah::view_stats stats;
+		auto less = rah::counted_calls(std::less<>(), stats);
+		std::vector<int> in{ 3, 1, 2 };
+		std::sort(begin(in), end(in), less);
+		assert(in == std::vector<int>({ 1, 2, 3 }));
+		assert(stats.calls != 0);
+		/// [rah::counted_calls]
+	}
+	{
+		/// [rah::view::tap]
+		std::vector<int> seen;
+		auto view = rah::view::tap(rah::view::iota(0, 3), [&](int i) { seen.push_back(i); });
+		assert(rah::equal(view, il<int>{ 0, 1, 2 }));
+		assert(seen == std::vector<int>({ 0, 1, 2 }));
+		/// [rah::view::tap]
+	}
+	{
+		/// [rah::view::tap_pipeable]
+		std::vector<int> in{ 0, 1, 2, 3 };
+		int sum = 0;
+		for (int& i : in | rah::view::tap([&](int i) { sum += i; }))
+			i *= 2; // The elements are still references
+		assert(sum == 6);
+		assert(in == std::vector<int>({ 0, 2, 4, 6 }));
+		/// [rah::view::tap_pipeable]
+	}
+	{
+		/// [rah::latency_histogram]
+		rah::latency_histogram histogram;
+		for (int i = 0; i != 98; ++i)
+			histogram.add(1);
+		histogram.add(1000);
+		histogram.add(1000);
+		assert(histogram.count() == 100);
+		assert(histogram.total() == 2098);
+		assert(histogram.percentile(0.5) == 1);
+		assert(histogram.percentile(0.99) == 1023); // 1000 is in the bucket [512, 1024)
+		/// [rah::latency_histogram]
+	}
+	{
+		/// [rah::timed_calls]
+		rah::stage_timing timing("is_even", 4); // Measure one call out of 4
+		auto evens = rah::view::iota(0, 100)
+			| rah::view::filter(rah::timed_calls([](int i) { return i % 2 == 0; }, timing));
+		assert(rah::count(evens, 0) == 1);
+		rah::timing_report const report = timing.report();
+		assert(report.name == std::string("is_even"));
+		assert(report.calls == 100);
+		assert(report.samples == 25);
+		assert(report.p50 <= report.p99);
+		/// [rah::timed_calls]
+	}
+	{
+		/// [rah::view::timed]
+		rah::stage_timing timing("transform");
+		auto view = rah::view::timed(rah::view::iota(0, 10) | rah::view::transform([](int i) { return i * 2; }), timing);
+		assert(rah::equal(view, il<int>{ 0, 2, 4, 6, 8, 10, 12, 14, 16, 18 }));
+		assert(timing.calls() == 20); // 10 increments and 10 dereferences
+		assert(timing.histogram().count() == 20);
+		/// [rah::view::timed]
+	}
+	{
+		/// [rah::view::timed_pipeable]
+		rah::stage_timing timing("filter", 8);
+		std::vector<int> in{ 0, 1, 2, 3, 4, 5, 6, 7 };
+		auto odds = in | rah::view::filter([](int i) { return i % 2 == 1; }) | rah::view::timed(timing);
+		assert(rah::equal(odds, il<int>{ 1, 3, 5, 7 }));
+		assert(timing.calls() == 8);
+		assert(timing.histogram().count() == 1);
+		timing.reset();
+		assert(timing.calls() == 0 and timing.histogram().count() == 0);
+		/// [rah::view::timed_pipeable]
+	}
+	{
+		/// [rah::stage_info_of]
+		static_assert(rah::stage_info_of<int*>().contiguous, "");
+		static_assert(rah::stage_info_of<int*>().sized, "");
+		static_assert(not rah::stage_info_of<std::list<int>::iterator>().sized, "");
+		static_assert(not rah::stage_info_of<std::list<int>::iterator>().proxy_reference, "");
+		static_assert(rah::stage_info_of<rah::view::iota_iterator<int>>().proxy_reference, "");
+		/// [rah::stage_info_of]
+	}
+	{
+		// The containers are only checked for the value types they accept
+		static_assert(rah::stage_info_of<std::string::const_iterator>().contiguous, "");
+		static_assert(rah::stage_info_of<std::vector<double>::iterator>().contiguous, "");
+		static_assert(not rah::stage_info_of<std::list<double>::iterator>().contiguous, "");
+		static_assert(not rah::stage_info_of<std::vector<bool>::iterator>().contiguous, "");
+	}
+#ifndef RAH_INSTRUMENT
+	{
+		/// [rah::describe]
+		std::vector<int> in{ 0, 1, 2, 3 };
+		auto view = in
+			| rah::view::transform([](int i) { return i * 2; })
+			| rah::view::filter([](int i) { return i > 2; });
+		std::vector<rah::stage_info> const stages = rah::describe(view);
+		assert(stages.size() == 3);
+		assert(stages[0].name == std::string("filter") and stages[0].depth == 0);
+		assert(stages[0].category == std::string("bidirectional")); // filter is not random access
+		assert(stages[1].name == std::string("transform") and stages[1].depth == 1);
+		assert(stages[1].sized and stages[1].proxy_reference);
+		assert(stages[2].name == std::string("iterator") and stages[2].depth == 2);
+		assert(stages[2].contiguous and not stages[2].proxy_reference);
+		assert(stages[2].iterator_size == sizeof(std::vector<int>::iterator));
+		/// [rah::describe]
+	}
+	{
+		/// [rah::describe_string]
+		std::vector<int> in{ 0, 1, 2, 3 };
+		std::list<int> in2{ 4, 5, 6 };
+		std::string const description = rah::describe_string(rah::view::zip(in, in2) | rah::view::reverse());
+		// reverse                size=...  bidirectional proxy
+		//   zip                  size=...  bidirectional proxy
+		//     iterator           size=...  random_access sized contiguous
+		//     iterator           size=...  bidirectional
+		assert(std::count(description.begin(), description.end(), '\n') == 4);
+		assert(description.compare(0, 7, "reverse") == 0);
+		assert(description.find("  zip") != std::string::npos);
+		assert(description.find("contiguous") != std::string::npos);
+		/// [rah::describe_string]
+	}
+	{
+		// Views keeping their iterators in the view are not borrowed
+		std::vector<int> in{ 0, 1, 2, 3 };
+		auto stages = rah::describe(in | rah::view::sliding_reduce(2, std::plus<>()));
+		assert(stages.size() == 2);
+		assert(not stages[0].borrowed and stages[1].borrowed);
+		assert(rah::describe(rah::view::iota(0, 3)).size() == 1);
+	}
+	{
+		// A view storing a rvalue container is not borrowed
+		auto stages = rah::describe(make_vector() | rah::view::transform([](int i) { return i * 2; }));
+		assert(stages.size() == 2 and stages[0].name == std::string("transform"));
+		assert(not stages[0].borrowed and not stages[1].borrowed);
+		assert(not rah::describe(rah::view::own(make_vector()))[0].borrowed);
+		std::vector<int> in{ 0, 1, 2, 3 };
+		assert(rah::describe(in | rah::view::transform([](int i) { return i * 2; }))[0].borrowed);
+		auto joined = rah::view::iota(1, 3) | rah::view::transform([](int i) { return std::vector<int>(i, i); }) | rah::view::join();
+		assert(rah::describe(joined)[0].name == std::string("join") and not rah::describe(joined)[0].borrowed);
+	}
+#endif
+#if defined(RAH_CPP17) and not defined(RAH_INSTRUMENT)
+	{
+		/// [constexpr]
+		// Views and algorithms can be evaluated at compile time
+		constexpr auto square = [](int i) { return i * i; };
+		constexpr auto is_even = [](int i) { return i % 2 == 0; };
+		static_assert((rah::view::iota(0, 10)
+			| rah::view::transform(square)
+			| rah::view::filter(is_even)
+			| rah::reduce(0, std::plus<>())) == 120, "");
+		static constexpr std::array<int, 5> a{ 1, 2, 3, 4, 5 };
+		static constexpr std::array<int, 5> b{ 5, 4, 3, 2, 1 };
+		static_assert((rah::view::zip(a, b)
+			| rah::view::transform([](auto ab) { return std::get<0>(ab) * std::get<1>(ab); })
+			| rah::reduce(0, std::plus<>())) == 35, "");
+		// Lookup table made at compile time
+		constexpr auto squares = [=]
+		{
+			std::array<int, 8> table{};
+			for (auto&& index_value : rah::view::enumerate(table))
+				std::get<1>(index_value) = square(int(std::get<0>(index_value)));
+			return table;
+		}();
+		static_assert(squares[7] == 49, "");
+		/// [constexpr]
+		static_assert(rah::equal(a | rah::view::reverse(), b), "");
+		static_assert(rah::equal(a | rah::view::take(3) | rah::view::drop(1), std::array<int, 2>{ 2, 3 }), "");
+		static_assert(rah::equal(a | rah::view::take<2>(), std::array<int, 2>{ 1, 2 }), "");
+		static_assert(rah::equal(a | rah::view::stride(2), std::array<int, 3>{ 1, 3, 5 }), "");
+		static_assert(rah::equal(a | rah::view::slice(1, 3), std::array<int, 2>{ 2, 3 }), "");
+		static_assert(rah::equal(a | rah::view::counted(2), std::array<int, 2>{ 1, 2 }), "");
+		static_assert(rah::equal(rah::view::concat(a, b) | rah::view::take(6), std::array<int, 6>{ 1, 2, 3, 4, 5, 5 }), "");
+		static_assert(rah::equal(rah::view::repeat(7) | rah::view::take(2), std::array<int, 2>{ 7, 7 }), "");
+		static_assert(rah::equal(rah::view::closed_ints(1, 5), a), "");
+		static_assert((a
+			| rah::view::sliding(2)
+			| rah::view::transform([](auto window) { return *rah::max_element(window); })
+			| rah::reduce(0, std::plus<>())) == 14, "");
+		static_assert((a
+			| rah::view::chunk(2)
+			| rah::view::transform([](auto chunk) { return rah::size(chunk); })
+			| rah::reduce(0, std::plus<>())) == 5, "");
+		static_assert(rah::count_if(a, is_even) == 2, "");
+		static_assert(rah::count(a, 3) == 1, "");
+		static_assert(*rah::find(a, 3) == 3, "");
+		static_assert(*rah::find_if_not(a, [](int i) { return i < 4; }) == 4, "");
+		static_assert(rah::all_of(a, [](int i) { return i > 0; }), "");
+		static_assert(rah::any_of(a, is_even), "");
+		static_assert(rah::none_of(a, [](int i) { return i > 5; }), "");
+		static_assert(rah::size(a | rah::view::filter(is_even)) == 2, "");
+		static_assert(not rah::empty(a), "");
+		static_assert(*rah::min_element(a) == 1, "");
+	}
+#endif
+#ifdef RAH_INSTRUMENT
+	{
+		/// [rah::instrumented_views]
+		rah::view_stats const* iotaStats = nullptr;
+		assert(rah::equal(rah::view::iota(0, 3) | rah::view::transform([](int i) { return i * 2; }), il<int>{ 0, 2, 4 }));
+		for (rah::view_stats const& stats : rah::instrumented_views())
+		{
+			if (stats.name == std::string("iota"))
+				iotaStats = &stats;
+		}
+		assert(iotaStats != nullptr);
+		assert(iotaStats->dereferences >= 3);
+		/// [rah::instrumented_views]
+	}
+#endif
 	{
 		/// [take]
 		std::vector<int> in{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
@@ -460,6 +821,80 @@ int main()
 		/// [take_pipeable]
 	}
 
+	{
+		// take and drop of a random access range are ranges of the same iterators
+		std::vector<int> in{ 0, 1, 2, 3, 4, 5 };
+		auto range = in | rah::view::take(4) | rah::view::drop(1);
+#ifndef RAH_INSTRUMENT
+		static_assert(std::is_same<decltype(range), rah::iterator_range<std::vector<int>::iterator>>::value, "");
+#endif
+		assert(rah::equal(range, il<int>{ 1, 2, 3 }));
+		assert(rah::empty(in | rah::view::drop(10)));
+		assert(rah::equal(rah::view::ints(0) | rah::view::take(3), il<size_t>{ 0, 1, 2 }));
+		assert(rah::equal(std::list<int>{ 0, 1, 2 } | rah::view::take(2) | rah::view::drop(1), il<int>{ 1 }));
+	}
+
+	{
+		/// [rah::view::take_static]
+		std::vector<int> in{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		auto range = rah::view::take<5>(in);
+		static_assert(rah::static_max_size<decltype(range)>::value == 5, "");
+		assert(rah::equal(range, il<int>{ 0, 1, 2, 3, 4 }));
+		std::array<int, 3> small{ 0, 1, 2 };
+		auto range2 = rah::view::take<1000>(small);
+		static_assert(rah::static_max_size<decltype(range2)>::value == 3, "");
+		assert(rah::equal(range2, il<int>{ 0, 1, 2 }));
+		/// [rah::view::take_static]
+	}
+
+	{
+		/// [rah::view::take_static_pipeable]
+		std::vector<int> in{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		assert(rah::equal(in | rah::view::take<5>(), il<int>{ 0, 1, 2, 3, 4 }));
+		assert(rah::equal(in | rah::view::take<1000>(), in));
+		/// [rah::view::take_static_pipeable]
+	}
+
+	{
+		/// [rah::static_max_size]
+		std::array<int, 8> a{ 0, 1, 2, 3, 4, 5, 6, 7 };
+		std::array<int, 4> b{ 1, 1, 1, 1 };
+		auto twice = [](int i) { return i * 2; };
+		static_assert(rah::static_max_size<decltype(a | rah::view::transform(twice))>::value == 8, "");
+		static_assert(rah::static_max_size<decltype(rah::view::zip(a, b))>::value == 4, "");
+		static_assert(rah::static_max_size<decltype(a | rah::view::take(3))>::value == 8, "");
+		static_assert(rah::static_max_size<decltype(a | rah::view::stride(2))>::value == 8, "");
+		static_assert(rah::static_max_size<decltype(a | rah::view::chunk(2))>::value == 8, "");
+		static_assert(rah::static_max_size<decltype(a | rah::view::reverse())>::value == 8, "");
+		static_assert(rah::static_max_size<decltype(a | rah::view::enumerate())>::value == 8, "");
+		static_assert(rah::static_max_size<decltype(a | rah::view::filter(&is_odd))>::value == rah::DynamicExtent, "");
+		auto range = a | rah::view::reverse() | rah::view::take<6>() | rah::view::transform(twice);
+		static_assert(rah::static_max_size<decltype(range)>::value == 6, "");
+		assert(rah::equal(range, il<int>{ 14, 12, 10, 8, 6, 4 }));
+		/// [rah::static_max_size]
+	}
+
+	{
+		/// [rah::static_size]
+		std::array<int, 8> a{ 0, 1, 2, 3, 4, 5, 6, 7 };
+		std::array<int, 4> b{ 1, 1, 1, 1 };
+		auto twice = [](int i) { return i * 2; };
+		static_assert(rah::static_size<decltype(a | rah::view::transform(twice))>::value == 8, "");
+		static_assert(rah::static_size<decltype(rah::view::zip(a, b))>::value == 4, "");
+		static_assert(rah::static_size<decltype(a | rah::view::reverse())>::value == 8, "");
+		static_assert(rah::static_size<decltype(a | rah::view::enumerate())>::value == 8, "");
+		static_assert(rah::static_size<decltype(a | rah::view::take<3>())>::value == 3, "");
+		// Only an upper bound is known
+		static_assert(rah::static_size<decltype(a | rah::view::take(3))>::value == rah::DynamicExtent, "");
+		static_assert(rah::static_size<decltype(a | rah::view::stride(2))>::value == rah::DynamicExtent, "");
+		static_assert(rah::static_size<decltype(a | rah::view::chunk(2))>::value == rah::DynamicExtent, "");
+		static_assert(rah::static_size<rah::static_vector<int, 3>>::value == rah::DynamicExtent, "");
+		std::vector<int> v{ 0, 1 };
+		static_assert(rah::static_size<decltype(v | rah::view::take<3>())>::value == rah::DynamicExtent, "");
+		static_assert(rah::static_size<decltype(rah::view::zip(a, v | rah::view::take<3>()))>::value == rah::DynamicExtent, "");
+		/// [rah::static_size]
+	}
+
 	{
 		/// [drop]
 		std::vector<int> in{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
@@ -597,6 +1032,148 @@ int main()
 		assert(out == (std::vector<std::vector<int>>{}));
 	}
 
+	{
+		/// [rah::view::sliding_buffered]
+		int x = 0;
+		auto gen = rah::view::generate([&x]() { return x++; }) | rah::view::take(6);
+		std::vector<std::vector<int>> out;
+		for (auto window : rah::view::sliding_buffered(gen, 3))
+			out.emplace_back(window.begin(), window.end());
+		assert(out == (std::vector<std::vector<int>>{ { 0, 1, 2 }, { 1, 2, 3 }, { 2, 3, 4 }, { 3, 4, 5 } }));
+		/// [rah::view::sliding_buffered]
+	}
+	{
+		/// [rah::view::sliding_buffered_pipeable]
+		std::vector<int> in{ 0, 1, 2, 3, 4, 5 };
+		size_t callCount = 0;
+		auto windows = in
+			| rah::view::transform([&callCount](int i) { ++callCount; return i * 10; })
+			| rah::view::sliding_buffered(3);
+		auto windowSums = windows
+			| rah::view::transform([](auto&& window) { return std::accumulate(window.begin(), window.end(), 0); });
+		assert(rah::equal(windowSums, il<int>{ 30, 60, 90, 120 }));
+		assert(callCount == in.size()); // Each element is computed only once
+		/// [rah::view::sliding_buffered_pipeable]
+	}
+	{
+		/// [rah::view::sliding_buffered_alloc]
+		rah::arena arena;
+		std::vector<int> in{ 0, 1, 2, 3 };
+		auto windows = rah::view::sliding_buffered(in, 2, &arena);
+		assert(windows.buffer_.get_allocator().arena_ == &arena);
+		auto firsts = in | rah::view::sliding_buffered(2, &arena) | rah::view::transform([](auto window) { return *window.begin(); });
+		assert(rah::equal(firsts, il<int>{ 0, 1, 2 }));
+		/// [rah::view::sliding_buffered_alloc]
+	}
+	{
+		// view::sliding use the buffer on forward ranges
+		std::forward_list<int> in{ 0, 1, 2, 3, 4 };
+		std::vector<std::vector<int>> out;
+		for (auto window : in | rah::view::filter([](int i) { return i != 2; }) | rah::view::sliding(2))
+			out.emplace_back(window.begin(), window.end());
+		assert(out == (std::vector<std::vector<int>>{ { 0, 1 }, { 1, 3 }, { 3, 4 } }));
+		// Too short, or empty window
+		for (size_t n : { 0, 6 })
+			assert(rah::empty(in | rah::view::sliding(n)));
+		auto single = in | rah::view::sliding(5);
+		assert(rah::equal(*single.begin(), il<int>{ 0, 1, 2, 3, 4 }));
+		assert(std::next(single.begin()) == single.end());
+		// The result is single-pass
+		static_assert(std::is_same<rah::range_iter_categ_t<decltype(single)>, std::input_iterator_tag>::value, "");
+		std::list<int> bidir{ 0, 1, 2 };
+		using BidirCateg = rah::range_iter_categ_t<decltype(bidir | rah::view::sliding(2))>;
+		static_assert(std::is_same<BidirCateg, std::bidirectional_iterator_tag>::value, "");
+	}
+	{
+		/// [rah::view::sliding_reduce]
+		std::vector<int> in{ 1, 3, 2, 5, 4, 0 };
+		assert(rah::equal(rah::view::sliding_reduce(in, 3, std::plus<>()), il<int>{ 6, 10, 11, 9 }));
+		assert(rah::equal(rah::view::sliding_reduce(in, 3, rah::maximum()), il<int>{ 3, 5, 5, 5 }));
+		assert(rah::equal(rah::view::sliding_reduce(in, 3, rah::minimum()), il<int>{ 1, 2, 2, 0 }));
+		// Any associative operation
+		auto concat = [](std::string const& a, std::string const& b) { return a + b; };
+		std::vector<std::string> words{ "a", "b", "c", "d" };
+		assert(rah::equal(rah::view::sliding_reduce(words, 2, concat), il<std::string>{ "ab", "bc", "cd" }));
+		/// [rah::view::sliding_reduce]
+	}
+	{
+		/// [rah::view::sliding_reduce_inverse]
+		std::vector<double> in{ 1., 2., 4., 8., 16. };
+		auto products = rah::view::sliding_reduce(in, 2, std::multiplies<>(), std::divides<>());
+		assert(rah::equal(products, il<double>{ 2., 8., 32., 128. }));
+		/// [rah::view::sliding_reduce_inverse]
+	}
+	{
+		/// [rah::view::sliding_reduce_alloc]
+		rah::arena arena;
+		std::vector<int> in{ 1, 3, 2, 5, 4, 0 };
+		assert(rah::equal(rah::view::sliding_reduce(in, 3, rah::maximum(), &arena), il<int>{ 3, 5, 5, 5 }));
+		assert(rah::equal(in | rah::view::sliding_reduce(3, std::plus<>(), &arena), il<int>{ 6, 10, 11, 9 }));
+		auto concat = [](std::string const& a, std::string const& b) { return a + b; };
+		std::vector<std::string> words{ "a", "b", "c" };
+		assert(rah::equal(words | rah::view::sliding_reduce(2, concat, &arena), il<std::string>{ "ab", "bc" }));
+		std::vector<double> values{ 1., 2., 4. };
+		auto products = rah::view::sliding_reduce(values, 2, std::multiplies<>(), std::divides<>(), &arena);
+		assert(rah::equal(products, il<double>{ 2., 8. }));
+		assert(arena.capacity() != 0);
+		/// [rah::view::sliding_reduce_alloc]
+	}
+	{
+		/// [rah::view::sliding_reduce_pipeable]
+		int x = 0;
+		auto movingMax = rah::view::generate([&x]() { return (x++ * 7) % 10; }) // 0 7 4 1 8 5 2 9 6 3
+			| rah::view::take(10)
+			| rah::view::sliding_reduce(4, rah::maximum());
+		assert(rah::equal(movingMax, il<int>{ 7, 8, 8, 8, 9, 9, 9 }));
+		/// [rah::view::sliding_reduce_pipeable]
+	}
+	{
+		// The window is shared by the iterators, so the view is single-pass
+		std::vector<int> in{ 1, 2, 3, 4 };
+		auto sums = in | rah::view::sliding_reduce(2, std::plus<>());
+		static_assert(std::is_same<rah::range_iter_categ_t<decltype(sums)>, std::input_iterator_tag>::value, "");
+	}
+	{
+		// Shorter than the window
+		std::vector<int> in{ 1, 2 };
+		assert(rah::empty(in | rah::view::sliding_reduce(3, std::plus<>())));
+		assert(rah::equal(in | rah::view::sliding_reduce(2, std::plus<>()), il<int>{ 3 }));
+		assert(rah::equal(in | rah::view::sliding_reduce(1, rah::minimum()), il<int>{ 1, 2 }));
+	}
+	{
+		// Compare every algorithm with the naive one
+		std::vector<unsigned> in;
+		unsigned seed = 12345;
+		for (size_t i = 0; i != 1000; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			in.push_back((seed >> 16) % 100);
+		}
+		auto naive = [&](size_t n, auto op)
+		{
+			return in
+				| rah::view::sliding(n)
+				| rah::view::transform([op](auto&& window) {
+				return std::accumulate(std::next(begin(window)), end(window), *begin(window), op); })
+				| rah::to_container<std::vector<unsigned>>();
+		};
+		// Not commutative
+		auto second = [](unsigned, unsigned b) { return b; };
+		for (size_t n : {1, 2, 7, 64})
+		{
+			assert(rah::equal(in | rah::view::sliding_reduce(n, std::plus<unsigned>()), naive(n, std::plus<>())));
+			assert(rah::equal(in | rah::view::sliding_reduce(n, std::bit_xor<>()), naive(n, std::bit_xor<>())));
+			assert(rah::equal(in | rah::view::sliding_reduce(n, rah::minimum()), naive(n, rah::minimum())));
+			assert(rah::equal(in | rah::view::sliding_reduce(n, rah::maximum()), naive(n, rah::maximum())));
+			assert(rah::equal(in | rah::view::sliding_reduce(n, second), naive(n, second)));
+			auto gcd = [](unsigned a, unsigned b) { while (b != 0) { unsigned t = a % b; a = b; b = t; } return a; };
+			auto gcds = in | rah::view::sliding_reduce(n, gcd);
+			assert(rah::equal(gcds, naive(n, gcd)));
+			// Iterating again restart from scratch
+			assert(rah::equal(gcds, naive(n, gcd)));
+		}
+	}
+
 	{
 		std::vector<int> in{ 0, 1, 2, 3 };
 		std::vector<std::vector<int>> out;
@@ -790,6 +1367,19 @@ int main()
 			| rah::view::filter([](auto a_b) {return std::get<1>(a_b); });
 		assert(rah::equal(range, std::vector<std::tuple<int, bool>>({ {2, true}, { 3, true } })));
 	}
+	{
+		// Zip of random access ranges is random access, and stops at the end of the shortest range
+		std::vector<int> inputA{ 1, 2, 3, 4, 5 };
+		std::list<int> list{ 4, 5, 6 };
+		auto range = rah::view::zip(inputA, rah::view::iota(10, 13));
+		static_assert(std::is_same<rah::range_iter_categ_t<decltype(range)>, std::random_access_iterator_tag>::value, "");
+		assert(rah::size(range) == 3);
+		assert(rah::equal(range | rah::view::reverse(), il<std::tuple<int, int>>{ { 3, 12 }, { 2, 11 }, { 1, 10 } }));
+		assert(rah::size(rah::view::zip(rah::view::ints(), rah::view::iota(0, 3))) == 3);
+		auto zipList = rah::view::zip(inputA, list);
+		static_assert(std::is_same<rah::range_iter_categ_t<decltype(zipList)>, std::bidirectional_iterator_tag>::value, "");
+		assert(rah::size(zipList) == 3);
+	}
 	{
 		/// [chunk]
 		std::vector<int> vec_01234{ 0, 1, 2, 3, 4 };
@@ -809,6 +1399,141 @@ int main()
 		/// [chunk_pipeable]
 	}
 
+	{
+		/// [chunk_by]
+		std::vector<int> in{ 1, 2, 2, 3, 1, 2, 0, 4, 5, 2 };
+		std::vector<std::vector<int>> out;
+		for (auto subRange : rah::view::chunk_by(in, [](int a, int b) { return a <= b; }))
+			out.emplace_back(begin(subRange), end(subRange));
+		assert(out == (std::vector<std::vector<int>>{ { 1, 2, 2, 3 }, { 1, 2 }, { 0, 4, 5 }, { 2 } }));
+		/// [chunk_by]
+	}
+	{
+		/// [chunk_by_pipeable]
+		std::forward_list<int> in{ 1, 2, 3, 5, 6, 8 };
+		std::vector<std::vector<int>> out;
+		for (auto subRange : in | rah::view::chunk_by([](int a, int b) { return b == a + 1; }))
+			out.emplace_back(begin(subRange), end(subRange));
+		assert(out == (std::vector<std::vector<int>>{ { 1, 2, 3 }, { 5, 6 }, { 8 } }));
+		/// [chunk_by_pipeable]
+	}
+	{
+		std::vector<int> in;
+		assert(rah::empty(rah::view::chunk_by(in, [](int a, int b) { return a <= b; })));
+	}
+	{
+		/// [group_by]
+		std::vector<std::pair<int, char>> in{ { 1, 'a' }, { 1, 'b' }, { 2, 'c' }, { 4, 'd' }, { 4, 'e' }, { 4, 'f' } };
+		std::vector<std::string> out;
+		for (auto subRange : rah::view::group_by(in, [](auto const& p) { return p.first; }))
+			out.push_back(subRange | rah::view::map_value() | rah::to_container<std::string>());
+		assert(out == std::vector<std::string>({ "ab", "c", "def" }));
+		/// [group_by]
+	}
+	{
+		/// [group_by_pipeable]
+		std::vector<int> in{ 5, 2, 1, 2, 5, 5, 4, 2 };
+		std::vector<std::pair<int, size_t>> out;
+		for (auto subRange : in | rah::action::sort() | rah::view::group_by(rah::identity{}))
+			out.emplace_back(*begin(subRange), rah::size(subRange));
+		assert(out == (std::vector<std::pair<int, size_t>>{ { 1, 1 }, { 2, 3 }, { 4, 1 }, { 5, 3 } }));
+		/// [group_by_pipeable]
+	}
+	{
+		// The runs are adjacent elements only, whatever the iterator category
+		std::vector<int> in{ 1, 1, 2, 1 };
+		std::list<int> inList(in.begin(), in.end());
+		assert(rah::size(in | rah::view::group_by(rah::identity{})) == 3);
+		assert(rah::size(inList | rah::view::group_by(rah::identity{})) == 3);
+		// One forward pass: the key of the first element of a run is also read to end the previous run
+		size_t keyCount = 0;
+		auto key = [&keyCount](int i) { ++keyCount; return i; };
+		for (auto subRange : rah::view::transform(in, rah::identity{}) | rah::view::group_by(key))
+			(void)subRange;
+		assert(keyCount == in.size() + 2);
+	}
+	{
+		/// [group_by_sorted]
+		std::vector<int> in{ 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 3, 3, 3, 3, 3, 3 };
+		std::vector<size_t> sizes;
+		for (auto subRange : rah::view::group_by_sorted(in, rah::identity{}))
+			sizes.push_back(rah::size(subRange));
+		assert(sizes == std::vector<size_t>({ 8, 2, 6 }));
+		/// [group_by_sorted]
+	}
+	{
+		/// [group_by_sorted_pipeable]
+		std::vector<std::pair<int, char>> in{ { 1, 'a' }, { 1, 'b' }, { 2, 'c' }, { 4, 'd' }, { 4, 'e' } };
+		auto groups = in | rah::view::group_by_sorted([](auto const& p) { return p.first; });
+		assert(rah::size(groups) == 3);
+		/// [group_by_sorted_pipeable]
+	}
+	{
+		// Galloping on random access iterators and linear search on forward iterators give the same runs
+		std::vector<int> in;
+		for (int i = 0; i != 300; ++i)
+			for (int j = 0; j != i % 37; ++j)
+				in.push_back(i);
+		std::forward_list<int> inList(in.begin(), in.end());
+		auto runSizes = [](auto&& range)
+		{
+			std::vector<size_t> sizes;
+			for (auto subRange : range | rah::view::group_by_sorted([](int i) { return i / 2; }))
+				sizes.push_back(rah::size(subRange));
+			return sizes;
+		};
+		assert(runSizes(in) == runSizes(inList));
+		assert(rah::reduce(runSizes(in), size_t(), std::plus<size_t>()) == in.size());
+	}
+	{
+		/// [rah::view::distinct]
+		std::vector<int> in{ 3, 1, 3, 2, 1, 4, 2 };
+		auto uniques = rah::view::distinct(in);
+		assert(rah::equal(uniques, il<int>{ 3, 1, 2, 4 }));
+		/// [rah::view::distinct]
+	}
+	{
+		/// [rah::view::distinct_pipeable]
+		std::vector<std::string> in{ "b", "a", "b", "c", "a" };
+		auto uniques = in | rah::view::distinct();
+		assert(rah::equal(uniques, il<std::string>{ "b", "a", "c" }));
+		/// [rah::view::distinct_pipeable]
+	}
+	{
+		/// [rah::view::distinct_alloc]
+		rah::arena arena;
+		std::vector<int> in{ 3, 1, 3, 2, 1 };
+		auto uniques = rah::view::distinct(in, std::hash<int>(), std::equal_to<int>(), &arena);
+		assert(rah::equal(uniques, il<int>{ 3, 1, 2 }));
+		assert(uniques.seen_.get_allocator().arena_ == &arena);
+		auto piped = in | rah::view::distinct(std::hash<int>(), std::equal_to<int>(), &arena);
+		assert(rah::equal(piped, il<int>{ 3, 1, 2 }));
+		/// [rah::view::distinct_alloc]
+	}
+	{
+		// The iterators share the seen-set, so the view is single-pass
+		std::vector<int> in{ 1, 2, 1, 3 };
+		auto uniques = in | rah::view::distinct();
+		static_assert(std::is_same<rah::range_iter_categ_t<decltype(uniques)>, std::input_iterator_tag>::value, "");
+		assert(rah::equal(uniques | rah::view::transform([](int i) { return i * 2; }), il<int>{ 2, 4, 6 }));
+	}
+	{
+		// Custom hash and equality, over a forward range
+		int y = 0;
+		auto byLastDigit = rah::view::generate([&y]() { return y += 7; })
+			| rah::view::take(100)
+			| rah::view::distinct([](int i) { return std::hash<int>()(i % 10); }, [](int a, int b) { return a % 10 == b % 10; });
+		assert(rah::equal(byLastDigit, il<int>{ 7, 14, 21, 28, 35, 42, 49, 56, 63, 70 }));
+	}
+	{
+		std::vector<int> in;
+		for (int i = 0; i != 10000; ++i)
+			in.push_back((i * 7919) % 1000);
+		auto uniques = in | rah::view::distinct();
+		assert(rah::size(uniques) == 1000);
+		// Iterating again restart from scratch
+		assert(rah::size(uniques) == 1000);
+	}
 	{
 		/// [filter]
 		std::vector<int> vec_01234{ 0, 1, 2, 3, 4 };
@@ -1195,6 +1920,35 @@ int main()
 		rah::transform(vecIn1, vecOut, [](int a) {return a + 1; });
 		assert(vecOut == std::vector<int>({ 1, 2, 3, 4 }));
 	}
+	{
+		/// [rah::equal_range_proj]
+		std::vector<std::pair<int, char>> in{ { 1, 'a' }, { 2, 'b' }, { 2, 'c' }, { 3, 'd' } };
+		auto first = [](auto const& p) { return p.first; };
+		auto range = rah::equal_range(in, 2, rah::is_lesser{}, first);
+		assert(rah::equal(range | rah::view::map_value(), il<char>{ 'b', 'c' }));
+		/// [rah::equal_range_proj]
+	}
+	{
+		/// [rah::equal_range_proj_pipeable]
+		std::vector<std::pair<int, char>> in{ { 1, 'a' }, { 2, 'b' }, { 2, 'c' }, { 3, 'd' } };
+		auto range = in | rah::equal_range(3, rah::is_lesser{}, [](auto const& p) { return p.first; });
+		assert(rah::equal(range | rah::view::map_value(), il<char>{ 'd' }));
+		/// [rah::equal_range_proj_pipeable]
+	}
+	{
+		/// [rah::binary_search_proj]
+		std::vector<std::string> in{ "b", "aa", "ccc" };
+		auto length = [](std::string const& str) { return str.size(); };
+		assert(rah::binary_search(in, size_t(2), rah::is_lesser{}, length));
+		assert(not rah::binary_search(in, size_t(4), rah::is_lesser{}, length));
+		/// [rah::binary_search_proj]
+	}
+	{
+		/// [rah::binary_search_proj_pipeable]
+		std::vector<std::string> in{ "b", "aa", "ccc" };
+		assert(in | rah::binary_search(size_t(3), rah::is_lesser{}, [](std::string const& str) { return str.size(); }));
+		/// [rah::binary_search_proj_pipeable]
+	}
 	{
 		/// [rah::transform3]
 		std::vector<int> vecIn1{ 0, 1, 2, 3 };
@@ -1226,6 +1980,51 @@ int main()
 		assert((vecIn1 | rah::reduce(0, [](auto a, auto b) {return a + b; })) == 10);
 		/// [rah::reduce_pipeable]
 	}
+	{
+		/// [rah::aggregate_by]
+		std::vector<std::string> words{ "one", "two", "three", "four", "five", "six" };
+		auto countByLength = rah::aggregate_by(
+			words,
+			[](std::string const& word) { return word.size(); },
+			0,
+			[](int count, std::string const&) { return count + 1; });
+		assert(countByLength.size() == 3);
+		assert(countByLength[3] == 3);
+		assert(countByLength[4] == 2);
+		assert(countByLength[5] == 1);
+		/// [rah::aggregate_by]
+	}
+	{
+		/// [rah::aggregate_by_pipeable]
+		auto sumByModulo = rah::view::iota(0, 10)
+			| rah::aggregate_by([](int i) { return i % 3; }, 0, [](int sum, int i) { return sum + i; });
+		auto sorted = sumByModulo | rah::to_container<std::vector<std::pair<int, int>>>();
+		std::sort(sorted.begin(), sorted.end());
+		assert(sorted == (std::vector<std::pair<int, int>>{ { 0, 18 }, { 1, 12 }, { 2, 15 } }));
+		/// [rah::aggregate_by_pipeable]
+	}
+	{
+		// Many keys, with a poor hash function
+		auto byKey = rah::view::iota(0, 100000)
+			| rah::aggregate_by([](int i) { return (i % 5000) * 1024; }, std::string(), [](std::string s, int) { return s + 'a'; }, 0);
+		assert(byKey.size() == 5000);
+		assert(rah::all_of(byKey, [](auto const& keyValue) { return keyValue.second == "aaaaaaaaaaaaaaaaaaaa"; }));
+		assert(byKey.find(1024 * 4999) != byKey.end());
+		assert(byKey.find(1023) == byKey.end());
+	}
+	{
+		// The keys can't be changed through the iterators
+		auto byKey = rah::view::iota(0, 10) | rah::aggregate_by([](int i) { return i % 3; }, 0, std::plus<int>());
+		static_assert(std::is_const<std::remove_reference_t<decltype(byKey.begin()->first)>>::value, "");
+		byKey.begin()->second = 42;
+		decltype(byKey) copy;
+		copy = byKey;
+		assert(copy.size() == 3 and copy[byKey.begin()->first] == 42 and copy.find(2)->second == 15);
+		rah::flat_hash_set<int> set;
+		assert(set.insert(3).second and not set.insert(3).second);
+		static_assert(std::is_const<std::remove_reference_t<decltype(*set.begin())>>::value, "");
+		static_assert(std::is_const<std::remove_reference_t<decltype(*set.find(3))>>::value, "");
+	}
 
 	/// [rah::any_of]
 	assert(rah::any_of(
@@ -1326,6 +2125,283 @@ int main()
 		assert(out == (std::vector<int>{ 4, 5, 6, 7 }));
 		/// [rah::to_container]
 	}
+	{
+		/// [rah::to_container_move]
+		std::vector<std::unique_ptr<int>> in;
+		in.push_back(std::make_unique<int>(1));
+		in.push_back(std::make_unique<int>(2));
+		// Move the elements of a rvalue container
+		auto list = rah::to_container<std::list<std::unique_ptr<int>>>(std::move(in));
+		assert(*list.front() == 1 and *list.back() == 2);
+		// Move the elements of a view::move
+		auto vec = list | rah::view::move() | rah::to_container<std::vector<std::unique_ptr<int>>>();
+		assert(*vec.front() == 1 and *vec.back() == 2);
+		assert(list.front() == nullptr);
+		/// [rah::to_container_move]
+	}
+	{
+		/// [rah::static_vector]
+		rah::static_vector<std::string, 4> vec;
+		vec.emplace_back("b");
+		vec.push_back("d");
+		vec.insert(vec.begin(), "a");
+		vec.insert(vec.begin() + 2, "c");
+		assert(vec.full());
+		assert(rah::equal(vec, il<std::string>{ "a", "b", "c", "d" }));
+		vec.erase(vec.begin() + 1);
+		assert(rah::equal(vec, il<std::string>{ "a", "c", "d" }));
+		assert(vec.data() + 3 == &vec.back() + 1); // Contiguous storage
+		/// [rah::static_vector]
+	}
+	{
+		/// [rah::static_vector_to_container]
+		// The capacity is checked at compile time
+		auto first = rah::view::iota(0, 1000)
+			| rah::view::take<16>()
+			| rah::to_container<rah::static_vector<int, 16>>();
+		assert(first.size() == 16 and first.back() == 15);
+		std::array<int, 3> array{ 1, 2, 3 };
+		auto copy = rah::to_container<rah::static_vector<int, 3>>(array);
+		assert(rah::equal(copy, array));
+		static_assert(rah::static_max_size<int[8]>::value == 8, "");
+		static_assert(rah::static_max_size<rah::static_vector<int, 3>>::value == 3, "");
+		static_assert(rah::static_max_size<std::vector<int>>::value == rah::DynamicExtent, "");
+		// Here, the size is only known at runtime
+		auto dynamic = std::vector<int>{ 4, 5 } | rah::to_container<rah::static_vector<int, 3>>();
+		assert(rah::equal(dynamic, il<int>{ 4, 5 }));
+		/// [rah::static_vector_to_container]
+	}
+	{
+		/// [rah::static_vector_back_inserter]
+		rah::static_vector<int, 9> out{ 0, 4 };
+		rah::copy(il<int>{ 1, 2, 3 }, rah::inserter(out, out.begin() + 1));
+		rah::copy(std::list<int>{ 5, 6 }, rah::back_inserter(out));
+		rah::copy(rah::view::iota(7, 9), rah::back_inserter(out));
+		assert(rah::equal(out, rah::view::iota(0, 9)));
+		/// [rah::static_vector_back_inserter]
+	}
+	{
+		// Moves, copies and destructions
+		auto counter = std::make_shared<int>(0);
+		rah::static_vector<std::shared_ptr<int>, 4> vec(3, counter);
+		assert(counter.use_count() == 4);
+		auto copy = vec;
+		assert(counter.use_count() == 7);
+		auto moved = std::move(copy);
+		assert(copy.empty() and counter.use_count() == 7);
+		moved.pop_back();
+		vec = moved;
+		assert(vec.size() == 2 and counter.use_count() == 5);
+		vec.clear();
+		moved.clear();
+		assert(counter.use_count() == 1);
+	}
+	{
+		/// [rah::arena]
+		rah::arena arena(1024);
+		for (int request = 0; request != 3; ++request)
+		{
+			void* a = arena.allocate(100);
+			void* b = arena.allocate(16, 16);
+			assert(uintptr_t(b) % 16 == 0);
+			assert(b != a);
+			void* big = arena.allocate(2000); // Bigger than the block
+			assert(big != nullptr);
+			arena.reset(); // Free all. Only the largest block is kept.
+		}
+		assert(arena.capacity() >= 2000 and arena.capacity() < 8192);
+		/// [rah::arena]
+	}
+	{
+		// A reset make the same memory available again
+		rah::arena arena;
+		void* first = arena.allocate(10);
+		arena.reset();
+		assert(arena.allocate(10) == first);
+		arena.release();
+		assert(arena.capacity() == 0);
+	}
+	{
+		/// [rah::arena_allocator]
+		rah::arena arena;
+		std::vector<int, rah::arena_allocator<int>> vec(&arena);
+		for (int i = 0; i != 1000; ++i)
+			vec.push_back(i);
+		assert(vec.size() == 1000 and vec.back() == 999);
+		using ArenaString = std::basic_string<char, std::char_traits<char>, rah::arena_allocator<char>>;
+		std::list<ArenaString, rah::arena_allocator<ArenaString>> list(&arena);
+		list.emplace_back("a string long enough to not fit in the small string buffer", &arena);
+		assert(list.front().size() == 58);
+		/// [rah::arena_allocator]
+	}
+	{
+		// Like std::allocator, a too big count throws
+		rah::arena arena;
+		rah::arena_allocator<int64_t> alloc(&arena);
+		bool thrown = false;
+		try
+		{
+			alloc.allocate(std::numeric_limits<size_t>::max() / 4);
+		}
+		catch (std::bad_array_new_length const&)
+		{
+			thrown = true;
+		}
+		assert(thrown);
+		static_assert(std::is_final<rah::arena>::value, "");
+	}
+	{
+		/// [rah::to_container_alloc]
+		rah::arena arena;
+		using Vector = std::vector<int, rah::arena_allocator<int>>;
+		auto vec = rah::to_container<Vector>(rah::view::iota(0, 4), &arena);
+		assert(vec.get_allocator().arena_ == &arena);
+		assert(rah::equal(vec, il<int>{ 0, 1, 2, 3 }));
+		/// [rah::to_container_alloc]
+	}
+	{
+		/// [rah::to_container_alloc_pipeable]
+		rah::arena arena;
+		using Map = std::map<int, char, std::less<int>, rah::arena_allocator<std::pair<int const, char>>>;
+		auto map = std::vector<std::pair<int, char>>{ { 1, 'a' }, { 2, 'b' } } | rah::to_container<Map>(&arena);
+		assert(map.at(2) == 'b');
+		assert(arena.capacity() != 0);
+		/// [rah::to_container_alloc_pipeable]
+	}
+	{
+		// A rvalue of the same type is moved
+		rah::arena arena;
+		std::vector<int, rah::arena_allocator<int>> in(&arena);
+		in.assign({ 1, 2, 3 });
+		int const* data = in.data();
+		auto out = std::move(in) | rah::to_container<std::vector<int, rah::arena_allocator<int>>>(&arena);
+		assert(out.data() == data);
+	}
+	{
+		/// [rah::to_array]
+		std::array<int, 4> in{ 1, 2, 3, 4 };
+		std::array<int, 4> out = rah::to_array(rah::view::transform(in, [](int i) { return i * 10; }));
+		assert((out == std::array<int, 4>{ 10, 20, 30, 40 }));
+		/// [rah::to_array]
+	}
+	{
+		/// [rah::to_array_pipeable]
+		std::array<int, 6> in{ 5, 4, 3, 2, 1, 0 };
+		auto out = in | rah::view::take<3>() | rah::to_array();
+		assert((out == std::array<int, 3>{ 5, 4, 3 }));
+		// The size of a stride is only bounded: a static_vector is returned
+		rah::static_vector<int, 6> odd = in | rah::view::stride(2) | rah::to_array();
+		assert(rah::equal(odd, il<int>{ 5, 3, 1 }));
+		/// [rah::to_array_pipeable]
+	}
+	{
+		// The range can be smaller than its static_max_size
+		std::array<int, 5> in{ 1, 2, 3, 4, 5 };
+		auto odd = in | rah::view::stride(2) | rah::to_array();
+		static_assert(std::is_same<decltype(odd), rah::static_vector<int, 5>>::value, "");
+		assert(rah::equal(odd, il<int>{ 1, 3, 5 }));
+		auto first = std::vector<int>{ 1, 2, 3 } | rah::view::take<5>() | rah::to_array();
+		static_assert(std::is_same<decltype(first), rah::static_vector<int, 5>>::value, "");
+		assert(rah::equal(first, il<int>{ 1, 2, 3 }));
+		auto twice = in | rah::view::transform([](int i) { return i * 2; }) | rah::view::reverse() | rah::to_array();
+		assert((twice == std::array<int, 5>{ 10, 8, 6, 4, 2 }));
+	}
+	{
+		// A std::array can be given to to_container, also for a range of unknown size
+		std::list<int> in{ 1, 2, 3 };
+		auto out = in | rah::to_container<std::array<int, 3>>();
+		assert((out == std::array<int, 3>{ 1, 2, 3 }));
+		// Bigger than RAH_UNROLL_MAX_EXTENT
+		auto big = rah::view::ints(0, 100) | rah::to_container<std::array<int, 100>>();
+		assert(big[99] == 99);
+		// The elements of a rvalue range are moved
+		std::array<std::string, 2> strings{ "a string long enough to be allocated", "b" };
+		auto moved = std::move(strings) | rah::to_container<std::array<std::string, 2>>();
+		assert(moved[0] == "a string long enough to be allocated");
+	}
+	{
+		// The loops on small static extents are unrolled
+		std::array<int, 8> in{ 1, 2, 3, 4, 5, 6, 7, 8 };
+		assert((in | rah::view::take<5>() | rah::reduce(0, std::plus<>())) == 15);
+		assert((in | rah::view::filter(&is_odd) | rah::reduce(0, std::plus<>())) == 2 + 4 + 6 + 8);
+		std::vector<int> vec{ 1, 2 };
+		assert((vec | rah::view::take<8>() | rah::reduce(0, std::plus<>())) == 3);
+		int sum = 0;
+		rah::for_each(in | rah::view::stride(3), [&sum](int i) { sum += i; });
+		assert(sum == 1 + 4 + 7);
+	}
+#ifdef RAH_HAS_MEMORY_RESOURCE
+	{
+		// An arena is a memory_resource
+		rah::arena arena;
+		auto vec = rah::view::iota(0, 3) | rah::to_container<std::pmr::vector<int>>(&arena);
+		assert(vec.get_allocator().resource() == &arena);
+		assert(rah::equal(vec, il<int>{ 0, 1, 2 }));
+		std::pmr::monotonic_buffer_resource resource;
+		auto sorted = vec | rah::view::sort(std::greater<>(), &resource);
+		static_assert(std::is_same<decltype(sorted), std::pmr::vector<int>>::value, "");
+		assert(sorted.get_allocator().resource() == &resource);
+		assert(rah::equal(sorted, il<int>{ 2, 1, 0 }));
+		// The buffers of the views too
+		auto top = vec | rah::top_k(2, std::greater<>(), &resource);
+		assert(top.get_allocator().resource() == &resource);
+		auto uniques = vec | rah::view::distinct(std::hash<int>(), std::equal_to<int>(), &resource);
+		assert(uniques.seen_.get_allocator().resource() == &resource);
+		assert(rah::equal(uniques, il<int>{ 0, 1, 2 }));
+	}
+#endif
+	{
+		// A rvalue of the same type is moved
+		std::vector<std::string> in{ "a", "b" };
+		std::string const* data = in.data();
+		auto out = std::move(in) | rah::to_container<std::vector<std::string>>();
+		assert(out.data() == data);
+		// A rvalue view is not moved
+		std::vector<std::string> strings{ "a", "b" };
+		auto copy = strings | rah::view::all() | rah::to_container<std::vector<std::string>>();
+		assert(copy == strings);
+	}
+	{
+		// A view owning a rvalue, and borrowing a lvalue, is not moved
+		auto make = [] { return std::vector<std::string>{ "c", "d" }; };
+		std::vector<std::string> lv{ "a", "b" };
+		auto all = rah::to_container<std::vector<std::string>>(rah::view::concat(make(), lv));
+		assert(all == std::vector<std::string>({ "c", "d", "a", "b" }));
+		assert(lv == std::vector<std::string>({ "a", "b" }));
+		auto sorted = rah::view::concat(make(), lv) | rah::view::sort();
+		assert(sorted == std::vector<std::string>({ "a", "b", "c", "d" }));
+		assert(lv == std::vector<std::string>({ "a", "b" }));
+		auto pairs = rah::view::zip(make(), lv) | rah::to_container<std::vector<std::tuple<std::string, std::string>>>();
+		assert(std::get<1>(pairs[1]) == "b");
+		assert(lv == std::vector<std::string>({ "a", "b" }));
+		std::vector<std::string> out(4);
+		rah::copy(rah::view::concat(lv, make()), out);
+		assert(lv == std::vector<std::string>({ "a", "b" }));
+		// view::own only holds its container: it is moved
+		std::vector<std::string> owned{ "e", "f" };
+		auto moved = rah::view::own(std::move(owned)) | rah::to_container<std::vector<std::string>>();
+		static_assert(rah::details::is_movable_container<decltype(rah::view::own(make()))>::value, "");
+		assert(moved == std::vector<std::string>({ "e", "f" }));
+	}
+	{
+		/// [rah::view::move]
+		std::vector<std::string> in{ "a", "b" };
+		std::vector<std::string> out;
+		for (std::string&& str : rah::view::move(in))
+			out.push_back(std::move(str));
+		assert(out == std::vector<std::string>({ "a", "b" }));
+		/// [rah::view::move]
+	}
+	{
+		/// [rah::view::move_pipeable]
+		std::vector<std::unique_ptr<int>> in;
+		in.push_back(std::make_unique<int>(42));
+		std::vector<std::unique_ptr<int>> out;
+		in | rah::view::move() | rah::copy(rah::back_inserter(out));
+		assert(*out.front() == 42);
+		assert(in.front() == nullptr);
+		/// [rah::view::move_pipeable]
+	}
 
 	{
 		/// [rah::mismatch]
@@ -1421,6 +2497,18 @@ int main()
 		/// [rah::max_element_pred_pipeable]
 	}
 	
+	{
+		/// [rah::max_element_proj]
+		std::vector<std::pair<int, char>> in{ { 1, 'c' }, { 3, 'a' }, { 2, 'b' } };
+		assert(rah::max_element(in, rah::is_lesser{}, [](auto const& p) { return p.second; })->first == 1);
+		/// [rah::max_element_proj]
+	}
+	{
+		/// [rah::max_element_proj_pipeable]
+		std::vector<std::pair<int, char>> in{ { 1, 'c' }, { 3, 'a' }, { 2, 'b' } };
+		assert((in | rah::max_element(rah::is_lesser{}, [](auto const& p) { return p.first; }))->second == 'a');
+		/// [rah::max_element_proj_pipeable]
+	}
 	{
 		/// [rah::min_element]
 		std::vector<int> in{ 1, -5, 3, 4 };
@@ -1451,6 +2539,18 @@ int main()
 	}
 
 
+	{
+		/// [rah::min_element_proj]
+		std::vector<std::pair<int, char>> in{ { 1, 'c' }, { 3, 'a' }, { 2, 'b' } };
+		assert(rah::min_element(in, rah::is_lesser{}, [](auto const& p) { return p.second; })->first == 3);
+		/// [rah::min_element_proj]
+	}
+	{
+		/// [rah::min_element_proj_pipeable]
+		std::vector<std::pair<int, char>> in{ { 1, 'c' }, { 3, 'a' }, { 2, 'b' } };
+		assert((in | rah::min_element(rah::is_lesser{}, [](auto const& p) { return p.first; }))->second == 'c');
+		/// [rah::min_element_proj_pipeable]
+	}
 	{
 		/// [rah::size]
 		std::vector<int> vec3{ 1, 2, 3 };
@@ -1501,6 +2601,25 @@ int main()
 		assert(out == (std::vector<int>{ 1, 2, 3, 4, 5 }));
 		/// [rah::copy]
 	}
+	{
+		/// [rah::copy_move]
+		std::vector<std::string> in{ "a", "b" };
+		std::list<std::string> out;
+		rah::copy(std::move(in), rah::back_inserter(out));
+		assert(out == std::list<std::string>({ "a", "b" }));
+		std::set<std::unique_ptr<int>> unique;
+		std::vector<std::unique_ptr<int>> ptrs;
+		ptrs.push_back(std::make_unique<int>(3));
+		rah::copy(rah::view::move(ptrs), rah::inserter(unique, unique.end()));
+		assert(**unique.begin() == 3);
+		/// [rah::copy_move]
+	}
+	{
+		// Inserted values keep their order
+		std::vector<int> out{ 0, 4 };
+		std::vector<int>{ 1, 2, 3 } | rah::copy(rah::inserter(out, std::next(out.begin())));
+		assert(out == std::vector<int>({ 0, 1, 2, 3, 4 }));
+	}
 	{
 		/// [rah::copy_pipeable]
 		std::vector<int> in{ 1, 2, 3 };
@@ -1573,6 +2692,39 @@ int main()
 		assert(out == (std::vector<int>{ 10, 1, 2, 3 }));
 		/// [rah::back_insert_pipeable]
 	}
+	{
+		// Sized ranges are appended with only one allocation
+		std::vector<int> in(1000000);
+		std::iota(in.begin(), in.end(), 0);
+		std::vector<int, CountingAllocator<int>> out;
+		CountingAllocator<int>::allocCount = 0;
+		rah::back_insert(in, out);
+		assert(CountingAllocator<int>::allocCount == 1);
+		assert(rah::equal(out, in));
+		CountingAllocator<int>::allocCount = 0;
+		rah::view::iota(0, 1000) | rah::view::transform([](int i) { return i * 2; }) | rah::copy(rah::back_inserter(out));
+		assert(CountingAllocator<int>::allocCount == 1);
+		assert(out.size() == 1001000 and out.back() == 1998);
+		// Not sized ranges are still supported
+		std::vector<int> evens;
+		in | rah::view::filter([](int i) { return i % 2 == 0; }) | rah::view::take(3) | rah::back_insert(evens);
+		assert(evens == std::vector<int>({ 0, 2, 4 }));
+		std::list<int> list{ 1, 2 };
+		list | rah::back_insert(evens);
+		assert(evens == std::vector<int>({ 0, 2, 4, 1, 2 }));
+	}
+	{
+		// Sized ranges are inserted in one call
+		std::vector<int, CountingAllocator<int>> out{ 0, 4 };
+		out.reserve(2);
+		CountingAllocator<int>::allocCount = 0;
+		rah::view::iota(1, 4) | rah::copy(rah::inserter(out, std::next(out.begin())));
+		assert(CountingAllocator<int>::allocCount == 1);
+		assert(rah::equal(out, il<int>{ 0, 1, 2, 3, 4 }));
+		std::string str = "ad";
+		std::string{ "bc" } | rah::copy(rah::inserter(str, std::next(str.begin())));
+		assert(str == "abcd");
+	}
 	{
 		std::vector<int> in{ 1, 2, 3 };
 		std::vector<int> out;
@@ -1594,6 +2746,61 @@ int main()
 		assert(out.str() == in);
 		/// [rah::stream_inserter]
 	}
+	{
+		// Not contiguous characters are written by blocks
+		std::list<char> chars{ 'a', 'b', 'c' };
+		std::stringstream out;
+		chars | rah::copy(rah::stream_inserter(out));
+		int i = 0;
+		rah::view::generate([&i]() { return char('a' + (i++ % 26)); })
+			| rah::view::take(10000)
+			| rah::copy(rah::stream_inserter(out));
+		std::string const str = out.str();
+		assert(str.size() == 10003);
+		assert(str.substr(0, 6) == "abcabc");
+		assert(str.substr(str.size() - 3) == "nop"); // 9999 % 26 == 15
+		// Other values use the operator <<
+		std::stringstream numbers;
+		std::vector<int>{ 1, 2, 3 } | rah::copy(rah::stream_inserter(numbers));
+		assert(numbers.str() == "123");
+	}
+	{
+		/// [rah::formatted_stream_inserter]
+		std::stringstream out;
+		std::vector<int>{ 10, -2, 3 } | rah::copy(rah::formatted_stream_inserter(out, ","));
+		std::vector<double>{ 0.5, -1.25 } | rah::copy(rah::formatted_stream_inserter(out, ";"));
+		assert(out.str() == "10,-2,3,0.5;-1.25;");
+		/// [rah::formatted_stream_inserter]
+	}
+	{
+		std::stringstream out;
+		auto inserter = rah::formatted_stream_inserter(out, " ");
+		rah::view::iota(0, 3000) | rah::copy(inserter);
+		std::vector<int64_t>{ std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() } | rah::copy(inserter);
+		std::vector<uint64_t>{ std::numeric_limits<uint64_t>::max() } | rah::copy(inserter);
+		std::vector<bool>{ true, false } | rah::copy(inserter);
+		std::string("ab") | rah::copy(inserter);
+		std::vector<std::string>{ "cd" } | rah::copy(inserter);
+		*begin(inserter) = 4.f;
+		std::string const str = out.str();
+		std::string const tail =
+			"2999 -9223372036854775808 9223372036854775807 18446744073709551615 1 0 a b cd 4 ";
+		assert(str.substr(str.size() - tail.size()) == tail);
+		std::stringstream expected;
+		for (int i = 0; i != 3000; ++i)
+			expected << i << ' ';
+		assert(str.substr(0, expected.str().size()) == expected.str());
+		// Round-trip
+		std::stringstream doubles;
+		std::vector<double> const values{ 0.1, 1. / 3., 1e300, -2.5e-300 };
+		values | rah::copy(rah::formatted_stream_inserter(doubles, " "));
+		for (double value : values)
+		{
+			double read = 0.;
+			doubles >> read;
+			assert(read == value);
+		}
+	}
 
 	{
 		/// [rah::remove_if]
@@ -1720,6 +2927,21 @@ int main()
 		/// [rah::sort_pred_pipeable]
 	}
 
+	{
+		/// [rah::sort_proj]
+		std::vector<std::pair<int, char>> in{ { 1, 'c' }, { 3, 'a' }, { 2, 'b' } };
+		rah::sort(in, rah::is_lesser{}, [](auto const& p) { return p.second; });
+		assert(rah::equal(in | rah::view::map_key(), il<int>{ 3, 2, 1 }));
+		/// [rah::sort_proj]
+	}
+	{
+		/// [rah::sort_proj_pipeable]
+		std::vector<std::pair<int, char>> in{ { 1, 'c' }, { 3, 'a' }, { 2, 'b' } };
+		in | rah::sort([](auto a, auto b) { return a > b; }, [](auto const& p) { return p.first; });
+		assert(rah::equal(in | rah::view::map_value(), il<char>{ 'a', 'b', 'c' }));
+		/// [rah::sort_proj_pipeable]
+	}
+
 	/// [rah::stable_sort]
 	struct CmpA
 	{
@@ -1762,6 +2984,124 @@ int main()
 		/// [rah::stable_sort_pred_pipeable]
 	}
 
+	{
+		/// [rah::nth_element]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		rah::nth_element(in, in.begin() + 2);
+		assert(in[2] == 3);
+		assert(rah::all_of(in | rah::view::slice(0, 2), [](int v) {return v < 3; }));
+		assert(rah::all_of(in | rah::view::slice(3, rah::End), [](int v) {return v > 3; }));
+		/// [rah::nth_element]
+	}
+	{
+		/// [rah::nth_element_pipeable]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		in | rah::nth_element(in.begin() + 1);
+		assert(in[1] == 2);
+		/// [rah::nth_element_pipeable]
+	}
+	{
+		/// [rah::nth_element_pred]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		rah::nth_element(in, in.begin(), [](auto a, auto b) {return a > b; });
+		assert(in[0] == 6);
+		/// [rah::nth_element_pred]
+	}
+	{
+		/// [rah::partial_sort]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		rah::partial_sort(in, in.begin() + 3);
+		assert(rah::equal(in | rah::view::take(3), il<int>{ 1, 2, 3 }));
+		/// [rah::partial_sort]
+	}
+	{
+		/// [rah::partial_sort_pipeable]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		in | rah::partial_sort(in.begin() + 2);
+		assert(rah::equal(in | rah::view::take(2), il<int>{ 1, 2 }));
+		/// [rah::partial_sort_pipeable]
+	}
+	{
+		/// [rah::partial_sort_pred]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		rah::partial_sort(in, in.begin() + 3, [](auto a, auto b) {return a > b; });
+		assert(rah::equal(in | rah::view::take(3), il<int>{ 6, 5, 4 }));
+		/// [rah::partial_sort_pred]
+	}
+	{
+		/// [rah::partial_sort_copy]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		std::vector<int> out{ 0, 0, 0 };
+		rah::partial_sort_copy(in, out);
+		assert(out == std::vector<int>({ 1, 2, 3 }));
+		/// [rah::partial_sort_copy]
+	}
+	{
+		/// [rah::partial_sort_copy_pipeable]
+		std::vector<int> out{ 0, 0 };
+		rah::view::iota(0, 10) | rah::partial_sort_copy(out, [](auto a, auto b) {return a > b; });
+		assert(out == std::vector<int>({ 9, 8 }));
+		/// [rah::partial_sort_copy_pipeable]
+	}
+	{
+		/// [rah::top_k]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		auto smallest = rah::top_k(in, 3);
+		assert(smallest == std::vector<int>({ 1, 2, 3 }));
+		/// [rah::top_k]
+	}
+	{
+		/// [rah::top_k_pipeable]
+		int y = 1000;
+		auto gen = rah::view::generate([&y]() { return y--; });
+		auto smallest = gen | rah::view::take(1000) | rah::top_k(2);
+		assert(smallest == std::vector<int>({ 1, 2 }));
+		/// [rah::top_k_pipeable]
+	}
+	{
+		/// [rah::top_k_pred]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		auto greatest = rah::top_k(in, 2, [](auto a, auto b) {return a > b; });
+		assert(greatest == std::vector<int>({ 6, 5 }));
+		/// [rah::top_k_pred]
+	}
+	{
+		/// [rah::top_k_pred_pipeable]
+		std::vector<std::vector<int>> in{ { 6, 2 }, {}, { 1, 5, 3 }, { 4 } };
+		auto greatest = in | rah::view::join() | rah::top_k(3, [](auto a, auto b) {return a > b; });
+		assert(greatest == std::vector<int>({ 6, 5, 4 }));
+		/// [rah::top_k_pred_pipeable]
+	}
+	{
+		/// [rah::top_k_alloc]
+		rah::arena arena;
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		auto smallest = rah::top_k(in, 2, rah::is_lesser(), &arena);
+		static_assert(std::is_same<decltype(smallest), std::vector<int, rah::arena_allocator<int>>>::value, "");
+		assert(rah::equal(smallest, il<int>{ 1, 2 }));
+		auto greatest = in | rah::top_k(2, [](auto a, auto b) {return a > b; }, &arena);
+		assert(rah::equal(greatest, il<int>{ 6, 5 }));
+		/// [rah::top_k_alloc]
+	}
+	{
+		std::vector<int> in{ 2, 1 };
+		assert(rah::top_k(in, 5) == std::vector<int>({ 1, 2 }));
+		assert(rah::top_k(in, 0).empty());
+	}
+	{
+		/// [rah::stable_sort_proj]
+		std::vector<CmpA> in{ { 4, 1 }, { 2, 1 }, { 4, 2 }, { 1, 1 }, { 4, 3 }, { 2, 2 }, { 4, 4 } };
+		rah::stable_sort(in, rah::is_lesser{}, [](CmpA x) { return x.b; });
+		assert(in == std::vector<CmpA>({ { 4, 1 }, { 2, 1 }, { 1, 1 }, { 4, 2 }, { 2, 2 }, { 4, 3 }, { 4, 4 } }));
+		/// [rah::stable_sort_proj]
+	}
+	{
+		/// [rah::stable_sort_proj_pipeable]
+		std::vector<CmpA> in{ { 4, 1 }, { 2, 1 }, { 4, 2 }, { 1, 1 }, { 4, 3 }, { 2, 2 }, { 4, 4 } };
+		in | rah::stable_sort(rah::is_lesser{}, [](CmpA x) { return x.b; });
+		assert(in == std::vector<CmpA>({ { 4, 1 }, { 2, 1 }, { 1, 1 }, { 4, 2 }, { 2, 2 }, { 4, 3 }, { 4, 4 } }));
+		/// [rah::stable_sort_proj_pipeable]
+	}
 	{
 		/// [rah::shuffle]
 		std::random_device rd;
@@ -1807,6 +3147,20 @@ int main()
 		/// [rah::unique_pred_pipeable]
 	}
 
+	{
+		/// [rah::unique_proj]
+		std::vector<int> in{ 2, 4, 1, 3, 3, 6, 5 };
+		in.erase(rah::unique(in, rah::is_equal{}, [](int i) { return i % 2; }), end(in));
+		assert(in == std::vector<int>({ 2, 1, 6, 5 }));
+		/// [rah::unique_proj]
+	}
+	{
+		/// [rah::unique_proj_pipeable]
+		std::vector<int> in{ 2, 4, 1, 3, 3, 6, 5 };
+		in.erase(in | rah::unique(rah::is_equal{}, [](int i) { return i / 3; }), end(in));
+		assert(in == std::vector<int>({ 2, 4, 1, 3, 6, 5 }));
+		/// [rah::unique_proj_pipeable]
+	}
 	{
 		/// [rah::set_difference]
 		std::vector<int> in1{ 1,    3, 4 };
@@ -1859,6 +3213,37 @@ int main()
 		/// [rah::action::unique_pred_pipeable]
 	}
 
+	{
+		/// [rah::action::distinct]
+		std::vector<int> in{ 3, 1, 3, 2, 1, 4, 2 };
+		auto&& result = rah::action::distinct(in);
+		assert(&result == &in);
+		assert(in == std::vector<int>({ 3, 1, 2, 4 }));
+		/// [rah::action::distinct]
+	}
+	{
+		/// [rah::action::distinct_pipeable]
+		std::list<std::string> in{ "b", "a", "b", "c", "a" };
+		auto&& result = in | rah::action::distinct();
+		assert(&result == &in);
+		assert(in == std::list<std::string>({ "b", "a", "c" }));
+		/// [rah::action::distinct_pipeable]
+	}
+	{
+		std::vector<std::string> in{ "Aa", "bB", "aA", "c", "BB" };
+		auto lowerHash = [](std::string const& str)
+		{
+			std::string lower = str;
+			std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) { return char(tolower(c)); });
+			return std::hash<std::string>()(lower);
+		};
+		auto lowerEqual = [](std::string const& a, std::string const& b)
+		{
+			return a.size() == b.size() and std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return tolower(x) == tolower(y); });
+		};
+		in | rah::action::distinct(lowerHash, lowerEqual);
+		assert(in == std::vector<std::string>({ "Aa", "bB", "c" }));
+	}
 	{
 		/// [rah::action::remove_if]
 		std::vector<int> in{ 1, 2, 3, 4, 5 };
@@ -1923,6 +3308,137 @@ int main()
 		assert(in == std::vector<int>({ 1, 2, 3, 4, 5 }));
 		/// [rah::action::sort_pred_pipeable]
 	}
+	{
+		/// [rah::action::radix_sort]
+		std::vector<int> in{ 2, -1, 500, 3, -40000, 4 };
+		auto&& result = rah::action::radix_sort(in);
+		assert(&result == &in);
+		assert(in == std::vector<int>({ -40000, -1, 2, 3, 4, 500 }));
+		/// [rah::action::radix_sort]
+	}
+	{
+		/// [rah::action::radix_sort_pipeable]
+		std::vector<double> in{ 2.5, -1., 0., 1e10, -3.25, -1e-10 };
+		in | rah::action::radix_sort();
+		assert(in == std::vector<double>({ -3.25, -1., -1e-10, 0., 2.5, 1e10 }));
+		/// [rah::action::radix_sort_pipeable]
+	}
+	{
+		/// [rah::action::radix_sort_scratch]
+		std::vector<uint64_t> scratch;
+		std::mt19937_64 gen(42);
+		for (size_t size : { 0, 1, 2, 100, 10000 })
+		{
+			std::vector<uint64_t> in;
+			for (size_t i = 0; i != size; ++i)
+				in.push_back(gen() >> (i % 64));
+			std::vector<uint64_t> expected = in;
+			std::sort(expected.begin(), expected.end());
+			rah::action::radix_sort(in, scratch);
+			assert(in == expected);
+		}
+		/// [rah::action::radix_sort_scratch]
+	}
+	{
+		std::mt19937 gen(42);
+		std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+		std::vector<float> in;
+		for (size_t i = 0; i != 1000; ++i)
+			in.push_back(dist(gen));
+		std::vector<float> expected = in;
+		std::sort(expected.begin(), expected.end());
+		assert(rah::action::radix_sort(in) == expected);
+		std::vector<int8_t> bytes{ 5, -128, 127, 0, -1 };
+		assert(rah::action::radix_sort(bytes) == std::vector<int8_t>({ -128, -1, 0, 5, 127 }));
+	}
+	{
+		/// [rah::action::sort_by_key]
+		std::vector<std::pair<int, char>> in{ { 4, 'a' }, { 2, 'b' }, { 4, 'c' }, { 1, 'd' }, { 2, 'e' } };
+		rah::action::sort_by_key(in, [](auto const& p) { return p.first; });
+		assert(in == (std::vector<std::pair<int, char>>{ { 1, 'd' }, { 2, 'b' }, { 2, 'e' }, { 4, 'a' }, { 4, 'c' } }));
+		/// [rah::action::sort_by_key]
+	}
+	{
+		/// [rah::action::sort_by_key_pipeable]
+		enum class Color : short { Red = -2, Green, Blue };
+		std::vector<std::pair<Color, int>> in{ { Color::Blue, 0 }, { Color::Red, 1 }, { Color::Green, 2 } };
+		in | rah::action::sort_by_key([](auto const& p) { return p.first; });
+		assert(rah::equal(in | rah::view::map_value(), il<int>{ 1, 2, 0 }));
+		/// [rah::action::sort_by_key_pipeable]
+	}
+	{
+		// Compound keys are sorted lexicographically
+		std::vector<std::pair<int, uint8_t>> pairs{ { 1, 200 }, { -3, 7 }, { 1, 3 }, { -3, 255 } };
+		rah::action::radix_sort(pairs);
+		assert(pairs == (std::vector<std::pair<int, uint8_t>>{ { -3, 7 }, { -3, 255 }, { 1, 3 }, { 1, 200 } }));
+		using Hash = std::array<uint8_t, 20>;
+		std::mt19937 gen(42);
+		std::vector<Hash> hashes(300);
+		for (Hash& hash : hashes)
+			std::generate(hash.begin(), hash.end(), [&gen] { return uint8_t(gen() % 4); });
+		std::vector<Hash> expected = hashes;
+		std::stable_sort(expected.begin(), expected.end());
+		rah::action::sort_by_key(hashes, [](Hash const& h) -> Hash const& { return h; });
+		assert(hashes == expected);
+	}
+	{
+		// The values don't need to be default constructible
+		struct Item
+		{
+			explicit Item(int k) : key(k) {}
+			int key;
+		};
+		std::vector<Item> in{ Item(3), Item(-1), Item(2) };
+		rah::action::sort_by_key(in, [](Item const& item) { return item.key; });
+		assert(rah::equal(in | rah::view::transform([](Item const& item) { return item.key; }), il<int>{ -1, 2, 3 }));
+	}
+	{
+		/// [rah::action::sort_by_cached_key]
+		std::vector<std::string> in{ "Banana", "apple", "cherry", "Apple" };
+		size_t keyCount = 0;
+		auto toLower = [&keyCount](std::string const& str)
+		{
+			++keyCount;
+			std::string lower = str;
+			std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) { return char(tolower(c)); });
+			return lower;
+		};
+		auto&& result = rah::action::sort_by_cached_key(in, toLower);
+		assert(&result == &in);
+		assert(in == std::vector<std::string>({ "apple", "Apple", "Banana", "cherry" }));
+		assert(keyCount == 4);
+		/// [rah::action::sort_by_cached_key]
+	}
+	{
+		/// [rah::action::sort_by_cached_key_pipeable]
+		std::vector<int> in{ 5, 3, 8, 1, 9, 2, 7 };
+		in | rah::action::sort_by_cached_key([](int a, int b) { return a > b; }, [](int i) { return i % 3; });
+		assert(in == std::vector<int>({ 5, 8, 2, 1, 7, 3, 9 }));
+		/// [rah::action::sort_by_cached_key_pipeable]
+	}
+	{
+		/// [rah::action::top_k]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		auto&& result = rah::action::top_k(in, 3);
+		assert(&result == &in);
+		assert(in == std::vector<int>({ 1, 2, 3 }));
+		/// [rah::action::top_k]
+	}
+	{
+		/// [rah::action::top_k_pipeable]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		auto&& result = in | rah::action::top_k(2);
+		assert(&result == &in);
+		assert(in == std::vector<int>({ 1, 2 }));
+		/// [rah::action::top_k_pipeable]
+	}
+	{
+		/// [rah::action::top_k_pred]
+		std::vector<int> in{ 6, 2, 1, 5, 3, 4 };
+		in | rah::action::top_k(10, [](auto a, auto b) {return a > b; });
+		assert(in == std::vector<int>({ 6, 5, 4, 3, 2, 1 }));
+		/// [rah::action::top_k_pred]
+	}
 	{
 		/// [rah::action::shuffle]
 		std::random_device rd;
@@ -1979,6 +3495,56 @@ int main()
 		/// [rah::view::sort_pred_pipeable]
 	}
 
+	{
+		/// [rah::view::sort_rvalue]
+		std::vector<int> in{ 2, 1, 5, 3, 4 };
+		int const* data = in.data();
+		auto result = rah::view::sort(std::move(in));
+		assert(result == std::vector<int>({ 1, 2, 3, 4, 5 }));
+		assert(result.data() == data); // Sorted in place, not copied
+		/// [rah::view::sort_rvalue]
+	}
+	{
+		/// [rah::view::sort_container_pipeable]
+		std::deque<int> result = rah::view::iota(0, 5) | rah::view::sort<std::deque<int>>(std::greater<>());
+		assert(result == std::deque<int>({ 4, 3, 2, 1, 0 }));
+		/// [rah::view::sort_container_pipeable]
+	}
+	{
+		/// [rah::view::sort_alloc]
+		rah::arena arena;
+		std::vector<int> in{ 2, 1, 3 };
+		auto sorted = rah::view::sort(in, rah::is_lesser(), &arena);
+		static_assert(std::is_same<decltype(sorted), std::vector<int, rah::arena_allocator<int>>>::value, "");
+		assert(rah::equal(sorted, il<int>{ 1, 2, 3 }));
+		/// [rah::view::sort_alloc]
+	}
+	{
+		/// [rah::view::sort_alloc_pipeable]
+		rah::arena arena;
+		auto sorted = rah::view::iota(0, 3) | rah::view::sort<std::deque<int, rah::arena_allocator<int>>>(std::greater<>(), &arena);
+		assert(rah::equal(sorted, il<int>{ 2, 1, 0 }));
+		auto byAbs = il<int>{ -2, 1, -3 } | rah::view::sort_by(rah::is_lesser(), [](int i) { return std::abs(i); }, &arena);
+		assert(byAbs.get_allocator().arena_ == &arena);
+		assert(rah::equal(byAbs, il<int>{ 1, -2, -3 }));
+		/// [rah::view::sort_alloc_pipeable]
+	}
+	{
+		// A rvalue of an other type is copied
+		std::deque<int> in{ 2, 1, 3 };
+		auto result = std::move(in) | rah::view::sort();
+		assert(result == std::vector<int>({ 1, 2, 3 }));
+		// The container can have a custom allocator
+		using Vector = std::vector<std::string, std::allocator<std::string>>;
+		Vector words{ "b", "c", "a" };
+		auto sortedWords = std::move(words) | rah::view::sort<Vector>();
+		assert(sortedWords == Vector({ "a", "b", "c" }));
+		std::vector<int> ints{ -2, 1, -3 };
+		int const* data = ints.data();
+		auto byAbs = std::move(ints) | rah::view::sort_by([](int i) { return std::abs(i); });
+		assert(byAbs == std::vector<int>({ 1, -2, -3 }));
+		assert(byAbs.data() == data);
+	}
 	{
 		auto&& sorted = rah::view::iota(0, 10, 2)
 			| rah::view::sort([](auto a, auto b) {return b < a; });
@@ -1987,6 +3553,78 @@ int main()
 			| rah::to_container<std::vector<int>>();
 		assert(result == std::vector<int>({ -2, -4, -6, -8, -10 }));
 	}
+	{
+		/// [rah::view::sort_by]
+		std::vector<int> in{ -2, 1, -5, 3, 4 };
+		auto&& result = rah::view::sort_by(in, [](int i) { return std::abs(i); });
+		assert(in == std::vector<int>({ -2, 1, -5, 3, 4 }));
+		assert(result == std::vector<int>({ 1, -2, 3, 4, -5 }));
+		// Like in the sort algorithms, the predicate comes before the projection
+		auto&& descending = rah::view::sort_by(in, std::greater<int>(), [](int i) { return std::abs(i); });
+		assert(descending == std::vector<int>({ -5, 4, 3, -2, 1 }));
+		/// [rah::view::sort_by]
+	}
+	{
+		/// [rah::view::sort_by_pipeable]
+		auto&& result = rah::view::iota(0, 6) | rah::view::sort_by([](int i) { return i % 3; });
+		assert(result == std::vector<int>({ 0, 3, 1, 4, 2, 5 }));
+		/// [rah::view::sort_by_pipeable]
+	}
+	{
+		/// [rah::view::lazy_sort]
+		std::vector<int> in{ 2, 1, 5, 3, 4 };
+		auto sorted = rah::view::lazy_sort(in);
+		assert(in == std::vector<int>({ 2, 1, 5, 3, 4 }));
+		assert(rah::equal(sorted, std::vector<int>({ 1, 2, 3, 4, 5 })));
+		/// [rah::view::lazy_sort]
+	}
+	{
+		/// [rah::view::lazy_sort_pipeable]
+		std::vector<int> in{ 2, 1, 5, 3, 4 };
+		auto sorted = in | rah::view::lazy_sort();
+		assert(rah::equal(sorted | rah::view::take(2), std::vector<int>({ 1, 2 })));
+		/// [rah::view::lazy_sort_pipeable]
+	}
+	{
+		/// [rah::view::lazy_sort_pred]
+		std::vector<int> in{ 2, 1, 5, 3, 4 };
+		auto sorted = rah::view::lazy_sort(in, [](auto a, auto b) {return a > b; });
+		assert(rah::equal(sorted, std::vector<int>({ 5, 4, 3, 2, 1 })));
+		/// [rah::view::lazy_sort_pred]
+	}
+	{
+		/// [rah::view::lazy_sort_pred_pipeable]
+		std::vector<int> in{ 2, 1, 5, 3, 4 };
+		auto sorted = in | rah::view::lazy_sort([](auto a, auto b) {return a > b; });
+		assert(rah::equal(sorted | rah::view::take(3), std::vector<int>({ 5, 4, 3 })));
+		/// [rah::view::lazy_sort_pred_pipeable]
+	}
+	{
+		/// [rah::view::lazy_sort_alloc]
+		rah::arena arena;
+		std::vector<int> in{ 2, 1, 5, 3, 4 };
+		auto sorted = rah::view::lazy_sort(in, rah::is_lesser(), &arena);
+		assert(sorted.buffer_.get_allocator().arena_ == &arena);
+		assert(rah::equal(sorted, il<int>{ 1, 2, 3, 4, 5 }));
+		auto greatest = in | rah::view::lazy_sort([](auto a, auto b) {return a > b; }, &arena) | rah::view::take(2);
+		assert(rah::equal(greatest, il<int>{ 5, 4 }));
+		/// [rah::view::lazy_sort_alloc]
+	}
+	{
+		// Only the read elements are sorted
+		size_t compareCount = 0;
+		auto countingLess = [&compareCount](int a, int b) { ++compareCount; return a < b; };
+		auto sorted = rah::view::iota(0, 10000) | rah::view::reverse() | rah::view::lazy_sort(countingLess);
+		assert(rah::equal(sorted | rah::view::take(3), std::vector<int>({ 0, 1, 2 })));
+		assert(compareCount < 10000 * 3);
+		// Iterators are independent
+		auto iter = sorted.begin();
+		auto iter2 = iter;
+		++iter2;
+		assert(*iter == 0 && *iter2 == 1);
+		assert(rah::size(sorted) == 10000);
+		assert(equal(sorted, rah::view::iota(0, 10000)));
+	}
 
 	{
 		/// [rah::actions::fill]